@@ -91,6 +91,7 @@ openhevc_files := \
     libavcodec/hevc_parser.c \
     libavcodec/hevc_ps.c \
     libavcodec/hevc_refs.c \
+    libavcodec/hevc_startcode.c \
     libavcodec/hevc_sei.c \
     libavcodec/hevc_filter.c \
     libavcodec/hevc.c \
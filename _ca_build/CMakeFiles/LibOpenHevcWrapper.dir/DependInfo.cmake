@@ -0,0 +1,171 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/gpac/modules/openhevc_dec/openHevcWrapper.c" "CMakeFiles/LibOpenHevcWrapper.dir/gpac/modules/openhevc_dec/openHevcWrapper.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/gpac/modules/openhevc_dec/openHevcWrapper.c.o.d"
+  "/root/repo/libavcodec/ac3tab.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/ac3tab.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/ac3tab.c.o.d"
+  "/root/repo/libavcodec/allcodecs.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/allcodecs.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/allcodecs.c.o.d"
+  "/root/repo/libavcodec/avfft.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avfft.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avfft.c.o.d"
+  "/root/repo/libavcodec/avpacket.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpacket.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpacket.c.o.d"
+  "/root/repo/libavcodec/avpicture.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpicture.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpicture.c.o.d"
+  "/root/repo/libavcodec/bitstream.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream.c.o.d"
+  "/root/repo/libavcodec/bitstream_filter.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream_filter.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream_filter.c.o.d"
+  "/root/repo/libavcodec/bswapdsp.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bswapdsp.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bswapdsp.c.o.d"
+  "/root/repo/libavcodec/cabac.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/cabac.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/cabac.c.o.d"
+  "/root/repo/libavcodec/codec_desc.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/codec_desc.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/codec_desc.c.o.d"
+  "/root/repo/libavcodec/dct.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct.c.o.d"
+  "/root/repo/libavcodec/dct32_float.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_float.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_float.c.o.d"
+  "/root/repo/libavcodec/dct32_template.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_template.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_template.c.o.d"
+  "/root/repo/libavcodec/dirac.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dirac.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dirac.c.o.d"
+  "/root/repo/libavcodec/faanidct.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/faanidct.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/faanidct.c.o.d"
+  "/root/repo/libavcodec/fft_template.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/fft_template.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/fft_template.c.o.d"
+  "/root/repo/libavcodec/flac.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flac.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flac.c.o.d"
+  "/root/repo/libavcodec/flacdata.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flacdata.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flacdata.c.o.d"
+  "/root/repo/libavcodec/golomb.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/golomb.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/golomb.c.o.d"
+  "/root/repo/libavcodec/hevc.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc.c.o.d"
+  "/root/repo/libavcodec/hevc_cabac.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_cabac.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_cabac.c.o.d"
+  "/root/repo/libavcodec/hevc_filter.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_filter.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_filter.c.o.d"
+  "/root/repo/libavcodec/hevc_mvs.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_mvs.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_mvs.c.o.d"
+  "/root/repo/libavcodec/hevc_parser.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_parser.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_parser.c.o.d"
+  "/root/repo/libavcodec/hevc_ps.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_ps.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_ps.c.o.d"
+  "/root/repo/libavcodec/hevc_refs.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_refs.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_refs.c.o.d"
+  "/root/repo/libavcodec/hevc_sei.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_sei.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_sei.c.o.d"
+  "/root/repo/libavcodec/hevc_startcode.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_startcode.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_startcode.c.o.d"
+  "/root/repo/libavcodec/hevcdsp.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcdsp.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcdsp.c.o.d"
+  "/root/repo/libavcodec/hevcpred.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcpred.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcpred.c.o.d"
+  "/root/repo/libavcodec/hpeldsp.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hpeldsp.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hpeldsp.c.o.d"
+  "/root/repo/libavcodec/imgconvert.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/imgconvert.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/imgconvert.c.o.d"
+  "/root/repo/libavcodec/jrevdct.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/jrevdct.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/jrevdct.c.o.d"
+  "/root/repo/libavcodec/mathtables.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mathtables.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mathtables.c.o.d"
+  "/root/repo/libavcodec/mdct_template.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mdct_template.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mdct_template.c.o.d"
+  "/root/repo/libavcodec/me_cmp.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/me_cmp.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/me_cmp.c.o.d"
+  "/root/repo/libavcodec/mpeg12data.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg12data.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg12data.c.o.d"
+  "/root/repo/libavcodec/mpeg4audio.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg4audio.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg4audio.c.o.d"
+  "/root/repo/libavcodec/mpegaudiodata.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpegaudiodata.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpegaudiodata.c.o.d"
+  "/root/repo/libavcodec/options.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/options.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/options.c.o.d"
+  "/root/repo/libavcodec/parser.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/parser.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/parser.c.o.d"
+  "/root/repo/libavcodec/pthread.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread.c.o.d"
+  "/root/repo/libavcodec/pthread_frame.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_frame.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_frame.c.o.d"
+  "/root/repo/libavcodec/pthread_slice.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_slice.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_slice.c.o.d"
+  "/root/repo/libavcodec/qpeldsp.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/qpeldsp.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/qpeldsp.c.o.d"
+  "/root/repo/libavcodec/raw.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/raw.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/raw.c.o.d"
+  "/root/repo/libavcodec/rawdec.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rawdec.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rawdec.c.o.d"
+  "/root/repo/libavcodec/rdft.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rdft.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rdft.c.o.d"
+  "/root/repo/libavcodec/simple_idct.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/simple_idct.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/simple_idct.c.o.d"
+  "/root/repo/libavcodec/utils.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/utils.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/utils.c.o.d"
+  "/root/repo/libavcodec/videodsp.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/videodsp.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/videodsp.c.o.d"
+  "/root/repo/libavcodec/vorbis_parser.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/vorbis_parser.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/vorbis_parser.c.o.d"
+  "/root/repo/libavcodec/x86/constants.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/constants.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/constants.c.o.d"
+  "/root/repo/libavcodec/x86/dct_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/dct_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/dct_init.c.o.d"
+  "/root/repo/libavcodec/x86/fdct.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fdct.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fdct.c.o.d"
+  "/root/repo/libavcodec/x86/fft_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fft_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fft_init.c.o.d"
+  "/root/repo/libavcodec/x86/h264_qpel.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/h264_qpel.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/h264_qpel.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_deblock_avx512.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_deblock_avx512.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_deblock_avx512.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_idct_avx512.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_avx512.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_avx512.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_idct_sse.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_sse.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_sse.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_il_pred_avx2.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_avx2.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_avx2.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_il_pred_sse.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_sse.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_sse.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_intra_pred_sse.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_intra_pred_sse.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_intra_pred_sse.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_mc_avx2.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx2.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx2.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_mc_avx512.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx512.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx512.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_mc_sse.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_sse.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_sse.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_sao_avx2.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_avx2.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_avx2.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_sao_sse.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_sse.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_sse.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_startcode_avx2.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_avx2.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_avx2.c.o.d"
+  "/root/repo/libavcodec/x86/hevc_startcode_sse.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_sse.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_sse.c.o.d"
+  "/root/repo/libavcodec/x86/hevcdsp_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcdsp_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcdsp_init.c.o.d"
+  "/root/repo/libavcodec/x86/hevcpred_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcpred_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcpred_init.c.o.d"
+  "/root/repo/libavcodec/x86/hpeldsp_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hpeldsp_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hpeldsp_init.c.o.d"
+  "/root/repo/libavcodec/x86/idct_mmx_xvid.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_mmx_xvid.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_mmx_xvid.c.o.d"
+  "/root/repo/libavcodec/x86/idct_sse2_xvid.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_sse2_xvid.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_sse2_xvid.c.o.d"
+  "/root/repo/libavcodec/x86/qpeldsp_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/qpeldsp_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/qpeldsp_init.c.o.d"
+  "/root/repo/libavcodec/x86/simple_idct.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/simple_idct.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/simple_idct.c.o.d"
+  "/root/repo/libavcodec/x86/videodsp_init.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/videodsp_init.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/videodsp_init.c.o.d"
+  "/root/repo/libavcodec/xiph.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/xiph.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/xiph.c.o.d"
+  "/root/repo/libavformat/allformats.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/allformats.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/allformats.c.o.d"
+  "/root/repo/libavformat/avio.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/avio.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/avio.c.o.d"
+  "/root/repo/libavformat/aviobuf.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/aviobuf.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/aviobuf.c.o.d"
+  "/root/repo/libavformat/cutils.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/cutils.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/cutils.c.o.d"
+  "/root/repo/libavformat/file.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/file.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/file.c.o.d"
+  "/root/repo/libavformat/flac_picture.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/flac_picture.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/flac_picture.c.o.d"
+  "/root/repo/libavformat/format.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/format.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/format.c.o.d"
+  "/root/repo/libavformat/hevcdec.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/hevcdec.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/hevcdec.c.o.d"
+  "/root/repo/libavformat/id3v1.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v1.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v1.c.o.d"
+  "/root/repo/libavformat/id3v2.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v2.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v2.c.o.d"
+  "/root/repo/libavformat/isom.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/isom.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/isom.c.o.d"
+  "/root/repo/libavformat/matroska.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroska.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroska.c.o.d"
+  "/root/repo/libavformat/matroskadec.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroskadec.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroskadec.c.o.d"
+  "/root/repo/libavformat/metadata.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/metadata.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/metadata.c.o.d"
+  "/root/repo/libavformat/mov.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov.c.o.d"
+  "/root/repo/libavformat/mov_chan.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov_chan.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov_chan.c.o.d"
+  "/root/repo/libavformat/mpegts.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mpegts.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mpegts.c.o.d"
+  "/root/repo/libavformat/mux.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mux.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mux.c.o.d"
+  "/root/repo/libavformat/oggdec.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggdec.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggdec.c.o.d"
+  "/root/repo/libavformat/oggparsecelt.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsecelt.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsecelt.c.o.d"
+  "/root/repo/libavformat/oggparsedirac.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsedirac.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsedirac.c.o.d"
+  "/root/repo/libavformat/oggparseflac.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseflac.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseflac.c.o.d"
+  "/root/repo/libavformat/oggparseogm.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseogm.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseogm.c.o.d"
+  "/root/repo/libavformat/oggparseopus.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseopus.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseopus.c.o.d"
+  "/root/repo/libavformat/oggparseskeleton.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseskeleton.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseskeleton.c.o.d"
+  "/root/repo/libavformat/oggparsespeex.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsespeex.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsespeex.c.o.d"
+  "/root/repo/libavformat/oggparsetheora.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsetheora.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsetheora.c.o.d"
+  "/root/repo/libavformat/oggparsevorbis.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevorbis.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevorbis.c.o.d"
+  "/root/repo/libavformat/oggparsevp8.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevp8.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevp8.c.o.d"
+  "/root/repo/libavformat/options.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/options.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/options.c.o.d"
+  "/root/repo/libavformat/os_support.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/os_support.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/os_support.c.o.d"
+  "/root/repo/libavformat/rawdec.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rawdec.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rawdec.c.o.d"
+  "/root/repo/libavformat/replaygain.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/replaygain.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/replaygain.c.o.d"
+  "/root/repo/libavformat/riff.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riff.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riff.c.o.d"
+  "/root/repo/libavformat/riffdec.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riffdec.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riffdec.c.o.d"
+  "/root/repo/libavformat/rmsipr.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rmsipr.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rmsipr.c.o.d"
+  "/root/repo/libavformat/utils.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/utils.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/utils.c.o.d"
+  "/root/repo/libavformat/vorbiscomment.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/vorbiscomment.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/vorbiscomment.c.o.d"
+  "/root/repo/libavutil/atomic.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/atomic.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/atomic.c.o.d"
+  "/root/repo/libavutil/avstring.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/avstring.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/avstring.c.o.d"
+  "/root/repo/libavutil/base64.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/base64.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/base64.c.o.d"
+  "/root/repo/libavutil/bprint.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/bprint.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/bprint.c.o.d"
+  "/root/repo/libavutil/buffer.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/buffer.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/buffer.c.o.d"
+  "/root/repo/libavutil/channel_layout.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/channel_layout.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/channel_layout.c.o.d"
+  "/root/repo/libavutil/cpu.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/cpu.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/cpu.c.o.d"
+  "/root/repo/libavutil/crc.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/crc.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/crc.c.o.d"
+  "/root/repo/libavutil/des.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/des.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/des.c.o.d"
+  "/root/repo/libavutil/dict.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/dict.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/dict.c.o.d"
+  "/root/repo/libavutil/display.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/display.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/display.c.o.d"
+  "/root/repo/libavutil/error.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/error.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/error.c.o.d"
+  "/root/repo/libavutil/eval.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/eval.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/eval.c.o.d"
+  "/root/repo/libavutil/file_open.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/file_open.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/file_open.c.o.d"
+  "/root/repo/libavutil/frame.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/frame.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/frame.c.o.d"
+  "/root/repo/libavutil/imgutils.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/imgutils.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/imgutils.c.o.d"
+  "/root/repo/libavutil/intmath.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/intmath.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/intmath.c.o.d"
+  "/root/repo/libavutil/log.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log.c.o.d"
+  "/root/repo/libavutil/log2_tab.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log2_tab.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log2_tab.c.o.d"
+  "/root/repo/libavutil/mathematics.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mathematics.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mathematics.c.o.d"
+  "/root/repo/libavutil/md5.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/md5.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/md5.c.o.d"
+  "/root/repo/libavutil/mem.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mem.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mem.c.o.d"
+  "/root/repo/libavutil/opt.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/opt.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/opt.c.o.d"
+  "/root/repo/libavutil/parseutils.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/parseutils.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/parseutils.c.o.d"
+  "/root/repo/libavutil/pixdesc.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/pixdesc.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/pixdesc.c.o.d"
+  "/root/repo/libavutil/random_seed.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/random_seed.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/random_seed.c.o.d"
+  "/root/repo/libavutil/rational.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rational.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rational.c.o.d"
+  "/root/repo/libavutil/rc4.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rc4.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rc4.c.o.d"
+  "/root/repo/libavutil/samplefmt.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/samplefmt.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/samplefmt.c.o.d"
+  "/root/repo/libavutil/sha.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/sha.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/sha.c.o.d"
+  "/root/repo/libavutil/stereo3d.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/stereo3d.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/stereo3d.c.o.d"
+  "/root/repo/libavutil/time.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/time.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/time.c.o.d"
+  "/root/repo/libavutil/timecode.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/timecode.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/timecode.c.o.d"
+  "/root/repo/libavutil/utils.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/utils.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/utils.c.o.d"
+  "/root/repo/libavutil/x86/cpu.c" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/x86/cpu.c.o" "gcc" "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/x86/cpu.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
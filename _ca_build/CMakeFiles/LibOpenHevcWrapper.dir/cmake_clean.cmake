@@ -0,0 +1,315 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LibOpenHevcWrapper.dir/gpac/modules/openhevc_dec/openHevcWrapper.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/gpac/modules/openhevc_dec/openHevcWrapper.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/ac3tab.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/ac3tab.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/allcodecs.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/allcodecs.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avfft.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avfft.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpacket.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpacket.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpicture.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/avpicture.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream_filter.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bitstream_filter.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bswapdsp.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/bswapdsp.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/cabac.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/cabac.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/codec_desc.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/codec_desc.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_float.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_float.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_template.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dct32_template.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dirac.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/dirac.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/faanidct.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/faanidct.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/fft_template.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/fft_template.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flac.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flac.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flacdata.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/flacdata.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/golomb.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/golomb.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_cabac.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_cabac.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_filter.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_filter.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_mvs.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_mvs.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_parser.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_parser.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_ps.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_ps.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_refs.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_refs.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_sei.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_sei.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_startcode.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevc_startcode.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcdsp.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcdsp.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcpred.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hevcpred.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hpeldsp.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/hpeldsp.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/imgconvert.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/imgconvert.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/jrevdct.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/jrevdct.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mathtables.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mathtables.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mdct_template.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mdct_template.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/me_cmp.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/me_cmp.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg12data.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg12data.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg4audio.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpeg4audio.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpegaudiodata.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/mpegaudiodata.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/options.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/options.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/parser.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/parser.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_frame.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_frame.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_slice.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/pthread_slice.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/qpeldsp.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/qpeldsp.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/raw.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/raw.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rawdec.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rawdec.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rdft.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/rdft.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/simple_idct.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/simple_idct.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/utils.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/utils.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/videodsp.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/videodsp.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/vorbis_parser.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/vorbis_parser.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/constants.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/constants.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/dct_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/dct_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fdct.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fdct.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fft_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/fft_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/h264_qpel.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/h264_qpel.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_deblock_avx512.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_deblock_avx512.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_avx512.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_avx512.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_sse.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_idct_sse.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_avx2.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_avx2.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_sse.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_il_pred_sse.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_intra_pred_sse.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_intra_pred_sse.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx2.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx2.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx512.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_avx512.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_sse.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_mc_sse.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_avx2.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_avx2.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_sse.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_sao_sse.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_avx2.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_avx2.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_sse.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevc_startcode_sse.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcdsp_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcdsp_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcpred_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hevcpred_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hpeldsp_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/hpeldsp_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_mmx_xvid.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_mmx_xvid.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_sse2_xvid.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/idct_sse2_xvid.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/qpeldsp_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/qpeldsp_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/simple_idct.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/simple_idct.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/videodsp_init.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/x86/videodsp_init.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/xiph.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavcodec/xiph.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/allformats.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/allformats.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/avio.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/avio.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/aviobuf.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/aviobuf.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/cutils.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/cutils.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/file.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/file.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/flac_picture.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/flac_picture.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/format.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/format.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/hevcdec.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/hevcdec.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v1.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v1.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v2.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/id3v2.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/isom.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/isom.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroska.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroska.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroskadec.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/matroskadec.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/metadata.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/metadata.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov_chan.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mov_chan.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mpegts.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mpegts.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mux.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/mux.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggdec.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggdec.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsecelt.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsecelt.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsedirac.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsedirac.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseflac.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseflac.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseogm.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseogm.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseopus.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseopus.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseskeleton.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparseskeleton.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsespeex.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsespeex.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsetheora.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsetheora.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevorbis.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevorbis.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevp8.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/oggparsevp8.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/options.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/options.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/os_support.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/os_support.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rawdec.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rawdec.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/replaygain.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/replaygain.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riff.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riff.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riffdec.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/riffdec.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rmsipr.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/rmsipr.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/utils.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/utils.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/vorbiscomment.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavformat/vorbiscomment.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/atomic.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/atomic.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/avstring.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/avstring.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/base64.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/base64.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/bprint.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/bprint.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/buffer.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/buffer.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/channel_layout.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/channel_layout.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/cpu.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/cpu.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/crc.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/crc.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/des.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/des.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/dict.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/dict.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/display.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/display.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/error.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/error.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/eval.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/eval.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/file_open.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/file_open.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/frame.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/frame.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/imgutils.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/imgutils.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/intmath.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/intmath.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log2_tab.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/log2_tab.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mathematics.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mathematics.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/md5.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/md5.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mem.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/mem.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/opt.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/opt.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/parseutils.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/parseutils.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/pixdesc.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/pixdesc.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/random_seed.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/random_seed.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rational.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rational.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rc4.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/rc4.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/samplefmt.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/samplefmt.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/sha.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/sha.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/stereo3d.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/stereo3d.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/time.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/time.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/timecode.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/timecode.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/utils.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/utils.c.o.d"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/x86/cpu.c.o"
+  "CMakeFiles/LibOpenHevcWrapper.dir/libavutil/x86/cpu.c.o.d"
+  "libLibOpenHevcWrapper.a"
+  "libLibOpenHevcWrapper.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/LibOpenHevcWrapper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libavcodec/cabac.c" "tests/CMakeFiles/cabac_test.dir/__/libavcodec/cabac.c.o" "gcc" "tests/CMakeFiles/cabac_test.dir/__/libavcodec/cabac.c.o.d"
+  "/root/repo/libavutil/lfg.c" "tests/CMakeFiles/cabac_test.dir/__/libavutil/lfg.c.o" "gcc" "tests/CMakeFiles/cabac_test.dir/__/libavutil/lfg.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_ca_build/CMakeFiles/LibOpenHevcWrapper.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cabac_test.dir/__/libavcodec/cabac.c.o"
+  "CMakeFiles/cabac_test.dir/__/libavcodec/cabac.c.o.d"
+  "CMakeFiles/cabac_test.dir/__/libavutil/lfg.c.o"
+  "CMakeFiles/cabac_test.dir/__/libavutil/lfg.c.o.d"
+  "cabac_test"
+  "cabac_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/cabac_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libavutil/lfg.c" "tests/CMakeFiles/checkasm.dir/__/libavutil/lfg.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/__/libavutil/lfg.c.o.d"
+  "/root/repo/tests/checkasm/checkasm.c" "tests/CMakeFiles/checkasm.dir/checkasm/checkasm.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/checkasm.c.o.d"
+  "/root/repo/tests/checkasm/hevc_deblock.c" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_deblock.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_deblock.c.o.d"
+  "/root/repo/tests/checkasm/hevc_idct.c" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_idct.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_idct.c.o.d"
+  "/root/repo/tests/checkasm/hevc_mc.c" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_mc.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_mc.c.o.d"
+  "/root/repo/tests/checkasm/hevc_pred.c" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_pred.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_pred.c.o.d"
+  "/root/repo/tests/checkasm/hevc_sao.c" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_sao.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_sao.c.o.d"
+  "/root/repo/tests/checkasm/hevc_startcode.c" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_startcode.c.o" "gcc" "tests/CMakeFiles/checkasm.dir/checkasm/hevc_startcode.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_ca_build/CMakeFiles/LibOpenHevcWrapper.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
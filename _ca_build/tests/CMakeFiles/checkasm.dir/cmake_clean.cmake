@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/checkasm.dir/__/libavutil/lfg.c.o"
+  "CMakeFiles/checkasm.dir/__/libavutil/lfg.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/checkasm.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/checkasm.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_deblock.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_deblock.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_idct.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_idct.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_mc.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_mc.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_pred.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_pred.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_sao.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_sao.c.o.d"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_startcode.c.o"
+  "CMakeFiles/checkasm.dir/checkasm/hevc_startcode.c.o.d"
+  "checkasm"
+  "checkasm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/checkasm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
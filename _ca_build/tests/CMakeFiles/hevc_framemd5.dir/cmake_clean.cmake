@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hevc_framemd5.dir/hevc_framemd5.c.o"
+  "CMakeFiles/hevc_framemd5.dir/hevc_framemd5.c.o.d"
+  "hevc_framemd5"
+  "hevc_framemd5.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/hevc_framemd5.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -19,14 +19,69 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 #include <stdio.h>
+#include <stdlib.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #include "openHevcWrapper.h"
 #include "libavcodec/avcodec.h"
 #include "libavformat/avformat.h"
+#include "libavutil/cpu.h"
+#include "libavutil/imgutils.h"
 #include "libavutil/mem.h"
 #include "libavutil/opt.h"
+#include "libavutil/pixdesc.h"
+#include "libavutil/thread.h"
 
-#define MAX_DECODERS 2
+#define MAX_DECODERS AV_HEVC_MAX_LAYERS
 #define ACTIVE_NAL
+
+#define POOL_ALIGN  64
+#define POOL_IL_REFS 2  ///< HEVCContext.Add_ref, the pictures a layer keeps for the layer above
+
+/* Picture memory of the bounded DPB and shared pool modes.  The layers of
+ * a handle share one pool per picture geometry, taken from the process-wide
+ * pools in the shared mode.  In the bounded mode each layer holds at most as
+ * many pictures as its DPB, its frame threads and the caller need. */
+typedef struct SharedFramePool {
+    AVBufferPool *pool;
+    enum AVPixelFormat format;
+    int width, height;
+    int linesize[4];
+    int offset[4];
+    int size;
+    int users;          ///< layers allocating from the pool
+} SharedFramePool;
+
+typedef struct LayerBudget {
+    struct FrameBudget *state;
+    SharedFramePool *pool;
+    int il_frames;      ///< pictures referenced by the layer above
+    int frames;
+    int64_t bytes;
+    int64_t peak_bytes;
+} LayerBudget;
+
+typedef struct FrameBudget {
+    AVMutex mutex;
+    AVBufferRef *self;  ///< the handle's reference, outstanding pictures take their own
+    SharedFramePool pools[MAX_DECODERS];
+    LayerBudget layers[MAX_DECODERS];
+    int extra_frames;   ///< pictures the caller holds through libOpenHevcGetOutputRef()
+    int bounded;
+    int shared;         ///< pools from av_hevc_shared_pool_init()
+    AVBufferRef* (*alloc)(int size);
+} FrameBudget;
+
+typedef struct FrameToken {
+    AVBufferRef *pooled;
+    AVBufferRef *state;
+    LayerBudget *layer;
+    int size;
+} FrameToken;
+
 typedef struct OpenHevcWrapperContext {
     AVCodec *codec;
     AVCodecContext *c;
@@ -37,21 +92,260 @@ typedef struct OpenHevcWrapperContext {
 
 typedef struct OpenHevcWrapperContexts {
     OpenHevcWrapperContext **wraper;
-    int nb_decoders;
+    int nb_decoders;    ///< allocated decoders, one per possible layer
+    int nb_layers;      ///< opened decoders, 0 until the layers are known
     int active_layer;
     int display_layer;
     int set_display;
     int set_vps;
+    int nb_pthreads;    ///< thread budget shared by all the layers
+    int started;
+    AVBufferRef *frame_budget;  ///< FrameBudget of the bounded DPB and shared pool modes
 } OpenHevcWrapperContexts;
 
+#if defined(__linux__)
+#define HUGE_PAGE_SIZE (2 << 20)
+#define MPOL_PREFERRED 1
+
+static void free_huge_buffer(void *opaque, uint8_t *data)
+{
+    munmap(data, (uintptr_t) opaque);
+}
+
+/* Maps size bytes on 2MB pages, from hugetlbfs if explicit and pages are
+ * reserved, else aligned for transparent huge pages.  The mapping prefers
+ * the NUMA node of the worker thread that asks for the picture: it faults
+ * the pages in when it decodes into them.  mmap() memory is zeroed, as
+ * with av_buffer_allocz(). */
+static AVBufferRef *alloc_huge_buffer(int size, int explicit)
+{
+    size_t   len  = FFALIGN((size_t) size, HUGE_PAGE_SIZE);
+    uint8_t *data = MAP_FAILED;
+    unsigned cpu, node;
+    AVBufferRef *buf;
+
+#ifdef MAP_HUGETLB
+    if (explicit)
+        data = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (data == MAP_FAILED) {
+        uint8_t *map = mmap(NULL, len + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED)
+            return NULL;
+        data = (uint8_t *) FFALIGN((uintptr_t) map, HUGE_PAGE_SIZE);
+        if (data > map)
+            munmap(map, data - map);
+        munmap(data + len, map + HUGE_PAGE_SIZE - data);
+#ifdef MADV_HUGEPAGE
+        madvise(data, len, MADV_HUGEPAGE);
+#endif
+    }
+    if (!syscall(SYS_getcpu, &cpu, &node, NULL) && node < 8 * sizeof(unsigned long)) {
+        unsigned long nodemask = 1UL << node;
+        syscall(SYS_mbind, data, len, MPOL_PREFERRED, &nodemask, 8 * sizeof(nodemask), 0);
+    }
+
+    buf = av_buffer_create(data, size, free_huge_buffer, (void *) (uintptr_t) len, 0);
+    if (!buf)
+        munmap(data, len);
+    return buf;
+}
+
+static AVBufferRef *alloc_thp_buffer(int size)
+{
+    return alloc_huge_buffer(size, 0);
+}
+
+static AVBufferRef *alloc_hugetlb_buffer(int size)
+{
+    return alloc_huge_buffer(size, 1);
+}
+#endif
+
+static void pool_uninit(FrameBudget *state, SharedFramePool *pool)
+{
+    if (state->shared)
+        av_hevc_shared_pool_uninit(&pool->pool);
+    else
+        av_buffer_pool_uninit(&pool->pool);
+}
+
+static void free_frame_budget(void *opaque, uint8_t *data)
+{
+    FrameBudget *state = (FrameBudget *) data;
+    int i;
+
+    for (i = 0; i < MAX_DECODERS; i++)
+        pool_uninit(state, &state->pools[i]);
+    ff_mutex_destroy(&state->mutex);
+    av_free(state);
+}
+
+static void release_pooled_buffer(void *opaque, uint8_t *data)
+{
+    FrameToken  *token = opaque;
+    LayerBudget *layer = token->layer;
+
+    ff_mutex_lock(&layer->state->mutex);
+    layer->frames--;
+    layer->bytes -= token->size;
+    ff_mutex_unlock(&layer->state->mutex);
+
+    av_buffer_unref(&token->pooled);
+    /* the last outstanding picture of a closed handle frees the state */
+    av_buffer_unref(&token->state);
+    av_free(token);
+}
+
+/* Points the layer at the pool of the picture geometry, the layout is the
+ * one of avcodec_default_get_buffer2() with all the planes in one buffer.
+ * Called with the mutex held. */
+static int select_pool(FrameBudget *state, LayerBudget *layer, AVCodecContext *avctx, const AVFrame *frame)
+{
+    SharedFramePool *pool = layer->pool;
+    uint8_t *data[4];
+    int stride_align[AV_NUM_DATA_POINTERS];
+    int i, w, h, size, unaligned;
+
+    if (pool && pool->format == frame->format &&
+        pool->width == frame->width && pool->height == frame->height)
+        return 0;
+
+    if (pool && !--pool->users)
+        pool_uninit(state, pool);
+    layer->pool = NULL;
+
+    for (i = 0; i < MAX_DECODERS; i++) {
+        pool = &state->pools[i];
+        if (pool->pool && pool->format == frame->format &&
+            pool->width == frame->width && pool->height == frame->height) {
+            pool->users++;
+            layer->pool = pool;
+            return 0;
+        }
+    }
+    for (i = 0; i < MAX_DECODERS && state->pools[i].pool; i++)
+        ;
+    if (i == MAX_DECODERS)
+        return AVERROR(ENOMEM);
+    pool = &state->pools[i];
+
+    w = frame->width;
+    h = frame->height;
+    avcodec_align_dimensions2(avctx, &w, &h, stride_align);
+    do {
+        av_image_fill_linesizes(pool->linesize, frame->format, w);
+        w += w & ~(w - 1);
+
+        unaligned = 0;
+        for (i = 0; i < 4; i++)
+            unaligned |= pool->linesize[i] % POOL_ALIGN;
+    } while (unaligned);
+
+    size = av_image_fill_pointers(data, frame->format, h, NULL, pool->linesize);
+    if (size < 0)
+        return size;
+    for (i = 0; i < 4; i++)
+        pool->offset[i] = data[i] - data[0];
+
+    /* room to align data[0] in get_pooled_buffer(), plus the padding */
+    pool->size = size + 16 + POOL_ALIGN - 1;
+    if (state->shared)
+        pool->pool = av_hevc_shared_pool_init(MKTAG('P','I','C','T'), frame->format,
+                                              frame->width, frame->height, pool->size, state->alloc);
+    else
+        pool->pool = av_buffer_pool_init(pool->size, state->alloc);
+    if (!pool->pool)
+        return AVERROR(ENOMEM);
+    pool->format = frame->format;
+    pool->width  = frame->width;
+    pool->height = frame->height;
+    pool->users  = 1;
+    layer->pool  = pool;
+    return 0;
+}
+
+/* get_buffer2() of the bounded DPB and shared pool modes, called from the
+ * frame threads. */
+static int get_pooled_buffer(AVCodecContext *avctx, AVFrame *frame, int flags)
+{
+    LayerBudget *layer = avctx->opaque;
+    FrameBudget *state = layer->state;
+    FrameToken  *token;
+    SharedFramePool *pool;
+    uint8_t *base;
+    int i, cap = INT_MAX, ret;
+
+    /* each extra frame thread decodes one picture of its own and keeps one
+     * decoded picture until it is returned; refs is the DPB size of the
+     * active SPS, set on the context of the frame thread */
+    if (state->bounded) {
+        cap = avctx->refs + 2 * (avctx->thread_count_frame - 1) + 1 +
+              layer->il_frames + state->extra_frames;
+    }
+
+    token = av_mallocz(sizeof(*token));
+    if (!token)
+        return AVERROR(ENOMEM);
+
+    ff_mutex_lock(&state->mutex);
+    if (layer->frames >= cap) {
+        av_log(avctx, AV_LOG_ERROR, "Picture limit of the bounded DPB reached: %d.\n", cap);
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+    if ((ret = select_pool(state, layer, avctx, frame)) < 0)
+        goto fail;
+    pool = layer->pool;
+
+    token->layer  = layer;
+    token->size   = pool->size;
+    token->pooled = av_buffer_pool_get(pool->pool);
+    token->state  = av_buffer_ref(state->self);
+    if (!token->pooled || !token->state) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+    frame->buf[0] = av_buffer_create(token->pooled->data, pool->size,
+                                     release_pooled_buffer, token, 0);
+    if (!frame->buf[0]) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+    base = (uint8_t *) FFALIGN((uintptr_t) frame->buf[0]->data, POOL_ALIGN);
+    for (i = 0; i < 4 && pool->linesize[i]; i++) {
+        frame->data[i]     = base + pool->offset[i];
+        frame->linesize[i] = pool->linesize[i];
+    }
+    frame->extended_data = frame->data;
+
+    layer->frames++;
+    layer->bytes     += pool->size;
+    layer->peak_bytes = FFMAX(layer->peak_bytes, layer->bytes);
+    ff_mutex_unlock(&state->mutex);
+    return 0;
+fail:
+    ff_mutex_unlock(&state->mutex);
+    av_buffer_unref(&token->pooled);
+    av_buffer_unref(&token->state);
+    av_free(token);
+    return ret;
+}
+
 OpenHevc_Handle libOpenHevcInit(int nb_pthreads, int thread_type)
 {
     /* register all the codecs */
     int i;
     OpenHevcWrapperContexts *openHevcContexts = av_mallocz(sizeof(OpenHevcWrapperContexts));
     OpenHevcWrapperContext  *openHevcContext;
+    const char *cpu_flags = getenv("OPENHEVC_CPUFLAGS");
+    if (cpu_flags && libOpenHevcSetCpuFlags(openHevcContexts, cpu_flags) < 0)
+        fprintf(stderr, "invalid OPENHEVC_CPUFLAGS \"%s\"\n", cpu_flags);
     avcodec_register_all();
     openHevcContexts->nb_decoders   = MAX_DECODERS;
+    openHevcContexts->nb_pthreads   = nb_pthreads;
     openHevcContexts->active_layer  = MAX_DECODERS-1;
     openHevcContexts->display_layer = MAX_DECODERS-1;
     openHevcContexts->wraper = av_malloc(sizeof(OpenHevcWrapperContext*)*openHevcContexts->nb_decoders);
@@ -80,11 +374,9 @@ OpenHevc_Handle libOpenHevcInit(int nb_pthreads, int thread_type)
         if(thread_type == 1)
             av_opt_set(openHevcContext->c, "thread_type", "frame", 0);
         else if (thread_type == 2)
-            av_opt_set(openHevcContext->c, "thread_type", "slice", 0);
+            av_opt_set(openHevcContext->c, "thread_type", "slice+slice_parallel", 0);
         else
-            av_opt_set(openHevcContext->c, "thread_type", "frameslice", 0);
-
-        av_opt_set_int(openHevcContext->c, "threads", nb_pthreads, 0);
+            av_opt_set(openHevcContext->c, "thread_type", "frameslice+slice_parallel", 0);
 
         /*  Set the decoder id    */
         av_opt_set_int(openHevcContext->c->priv_data, "decoder-id", i, 0);
@@ -92,20 +384,148 @@ OpenHevc_Handle libOpenHevcInit(int nb_pthreads, int thread_type)
     return (OpenHevc_Handle) openHevcContexts;
 }
 
-int libOpenHevcStartDecoder(OpenHevc_Handle openHevcHandle)
+/* Runs a throwaway decoder over the parameter sets of buff (and of the
+ * extradata) to read the layer structure from the VPS. */
+static int probe_layers(OpenHevcWrapperContexts *openHevcContexts, const uint8_t *buff, int size,
+                        AVHEVCLayers *layers)
 {
-    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
-    OpenHevcWrapperContext  *openHevcContext;
-    int i;
-    for(i=0; i < openHevcContexts->nb_decoders; i++) {
+    OpenHevcWrapperContext *openHevcContext = openHevcContexts->wraper[0];
+    AVCodecContext *c = avcodec_alloc_context3(openHevcContext->codec);
+    AVFrame  *picture = av_frame_alloc();
+    uint8_t  *ps      = av_malloc(size + FF_INPUT_BUFFER_PADDING_SIZE);
+    AVPacket  avpkt;
+    int i, got_picture, ps_size = 0, ret = AVERROR(ENOMEM);
+
+    if (!c || !picture || !ps)
+        goto end;
+    if (openHevcContext->c->extradata_size) {
+        c->extradata = av_mallocz(openHevcContext->c->extradata_size + FF_INPUT_BUFFER_PADDING_SIZE);
+        if (!c->extradata)
+            goto end;
+        memcpy(c->extradata, openHevcContext->c->extradata, openHevcContext->c->extradata_size);
+        c->extradata_size = openHevcContext->c->extradata_size;
+    }
+    av_opt_set_int(c, "threads", 1, 0);
+    if ((ret = avcodec_open2(c, openHevcContext->codec, NULL)) < 0)
+        goto end;
+
+    /* keep the VPS and SPS NAL units only, no picture gets decoded */
+    for (i = 0; i + 4 < size; i++) {
+        int type, end;
+        if (buff[i] || buff[i + 1] || buff[i + 2] != 1)
+            continue;
+        type = (buff[i + 3] >> 1) & 0x3f;
+        for (end = i + 3; end + 2 < size; end++)
+            if (!buff[end] && !buff[end + 1] && buff[end + 2] == 1)
+                break;
+        if (end + 2 >= size)
+            end = size;
+        if (type == 32 || type == 33) {
+            memcpy(ps + ps_size, buff + i, end - i);
+            ps_size += end - i;
+        }
+        i = end - 1;
+    }
+    if (ps_size) {
+        av_init_packet(&avpkt);
+        avpkt.data = ps;
+        avpkt.size = ps_size;
+        memset(ps + ps_size, 0, FF_INPUT_BUFFER_PADDING_SIZE);
+        avcodec_decode_video2(c, picture, &got_picture, &avpkt);
+    }
+    ret = av_hevc_get_layers(c, layers);
+end:
+    if (c) {
+        avcodec_close(c);
+        av_freep(&c->extradata);
+    }
+    av_freep(&c);
+    av_frame_free(&picture);
+    av_free(ps);
+    return ret;
+}
+
+/* Splits the thread budget between the layers in proportion to their
+ * pixel rate; all the layers of an access unit share the frame rate. */
+static void split_threads(int nb_pthreads, const AVHEVCLayers *layers, int nb_layers, int *threads)
+{
+    int64_t weight[MAX_DECODERS], sum = 0;
+    int i, left;
+
+    if (nb_pthreads <= 0)
+        nb_pthreads = av_cpu_count();
+    for (i = 0; i < nb_layers; i++) {
+        weight[i] = (int64_t) layers->width[i] * layers->height[i];
+        if (!weight[i])
+            weight[i] = i ? weight[i - 1] : 1;
+        sum += weight[i];
+    }
+    left = nb_pthreads;
+    for (i = 0; i < nb_layers; i++) {
+        threads[i] = FFMAX(1, nb_pthreads * weight[i] / sum);
+        left      -= threads[i];
+    }
+    /* the rounding leftovers go to the largest layers */
+    for (i = nb_layers - 1; left > 0; i = i ? i - 1 : nb_layers - 1, left--)
+        threads[i]++;
+}
+
+static int open_decoders(OpenHevcWrapperContexts *openHevcContexts, const uint8_t *buff, int size)
+{
+    OpenHevcWrapperContext *openHevcContext;
+    AVHEVCLayers layers = { 0 };
+    int threads[MAX_DECODERS];
+    int i, nb_layers;
+
+    if (probe_layers(openHevcContexts, buff, size, &layers) < 0) {
+        /* no VPS: keep the historical base + one enhancement layer setup */
+        layers.nb_layers    = 2;
+        layers.ref_layer[0] = -1;
+        layers.ref_layer[1] = 0;
+    }
+
+    /* each layer decoder takes its inter-layer reference from the decoder
+     * just below it, so only a chain of layers can be decoded */
+    nb_layers = FFMIN(layers.nb_layers, openHevcContexts->active_layer + 1);
+    for (i = 1; i < nb_layers; i++)
+        if (layers.ref_layer[i] != i - 1)
+            break;
+    if (i < nb_layers)
+        fprintf(stderr, "layer %d does not predict from layer %d, decoding %d layers\n", i, i - 1, i);
+    nb_layers = i;
+
+    split_threads(openHevcContexts->nb_pthreads, &layers, nb_layers, threads);
+    for (i = 0; i < nb_layers; i++) {
         openHevcContext = openHevcContexts->wraper[i];
+        av_opt_set_int(openHevcContext->c, "threads", threads[i], 0);
         if (avcodec_open2(openHevcContext->c, openHevcContext->codec, NULL) < 0) {
             fprintf(stderr, "could not open codec\n");
             return -1;
         }
-        if(i+1 < openHevcContexts->nb_decoders)
-            openHevcContexts->wraper[i+1]->c->BL_avcontext = openHevcContexts->wraper[i]->c;
+        if (i)
+            openHevcContext->c->BL_avcontext = openHevcContexts->wraper[i - 1]->c;
     }
+    if (openHevcContexts->frame_budget) {
+        FrameBudget *state = (FrameBudget *) openHevcContexts->frame_budget->data;
+        /* the layer above keeps an inter-layer reference per frame thread */
+        for (i = 0; i + 1 < nb_layers; i++)
+            state->layers[i].il_frames = POOL_IL_REFS + openHevcContexts->wraper[i + 1]->c->thread_count_frame;
+    }
+    openHevcContexts->nb_layers     = nb_layers;
+    openHevcContexts->active_layer  = FFMIN(openHevcContexts->active_layer,  nb_layers - 1);
+    openHevcContexts->display_layer = FFMIN(openHevcContexts->display_layer, nb_layers - 1);
+    return 1;
+}
+
+/* The decoders are opened once the layers of the stream are known: here if
+ * the extradata carries the parameter sets, else on the first access unit. */
+int libOpenHevcStartDecoder(OpenHevc_Handle openHevcHandle)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+
+    openHevcContexts->started = 1;
+    if (openHevcContexts->wraper[0]->c->extradata_size)
+        return open_decoders(openHevcContexts, NULL, 0);
     return 1;
 }
 
@@ -114,7 +534,13 @@ int libOpenHevcDecode(OpenHevc_Handle openHevcHandle, const unsigned char *buff,
     int got_picture[MAX_DECODERS], len=0, i, max_layer;
     OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
     OpenHevcWrapperContext  *openHevcContext;
-    for(i =0; i < MAX_DECODERS; i++)  {
+    if (!openHevcContexts->nb_layers) {
+        if (!openHevcContexts->started || !buff)
+            return 0;
+        if (open_decoders(openHevcContexts, buff, au_len) < 0)
+            return -1;
+    }
+    for(i =0; i < openHevcContexts->nb_layers; i++)  {
         got_picture[i]                 = 0;
         openHevcContext                = openHevcContexts->wraper[i];
         openHevcContext->c->quality_id = openHevcContexts->active_layer;
@@ -129,7 +555,7 @@ int libOpenHevcDecode(OpenHevc_Handle openHevcHandle, const unsigned char *buff,
         openHevcContext->avpkt.pts  = pts;
         len                         = avcodec_decode_video2( openHevcContext->c, openHevcContext->picture,
                                                              &got_picture[i], &openHevcContext->avpkt);
-        if(i+1 < openHevcContexts->nb_decoders)
+        if(i+1 < openHevcContexts->nb_layers)
             openHevcContexts->wraper[i+1]->c->BL_frame = openHevcContexts->wraper[i]->c->BL_frame;
     }
     if (len < 0) {
@@ -141,10 +567,10 @@ int libOpenHevcDecode(OpenHevc_Handle openHevcHandle, const unsigned char *buff,
     else
         max_layer = openHevcContexts->active_layer;
 
-    for(i=max_layer; i>=0; i--) {
+    for(i=FFMIN(max_layer, openHevcContexts->nb_layers - 1); i>=0; i--) {
         if(got_picture[i]){
             if(i != openHevcContexts->display_layer) {
-                if (i >= 0 && i < openHevcContexts->nb_decoders)
+                if (i >= 0 && i < openHevcContexts->nb_layers)
                     openHevcContexts->display_layer = i;
             }
          //   fprintf(stderr, "Display layer %d  \n", i);
@@ -168,12 +594,8 @@ void libOpenHevcCopyExtraData(OpenHevc_Handle openHevcHandle, unsigned char *ext
 }
 
 
-void libOpenHevcGetPictureInfo(OpenHevc_Handle openHevcHandle, OpenHevc_FrameInfo *openHevcFrameInfo)
+static void get_frame_info(const AVCodecContext *c, const AVFrame *picture, OpenHevc_FrameInfo *openHevcFrameInfo)
 {
-    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
-    OpenHevcWrapperContext  *openHevcContext  = openHevcContexts->wraper[openHevcContexts->display_layer];
-    AVFrame                 *picture          = openHevcContext->picture;
-
     openHevcFrameInfo->nYPitch    = picture->linesize[0];
 
     switch (picture->format) {
@@ -235,13 +657,21 @@ void libOpenHevcGetPictureInfo(OpenHevc_Handle openHevcHandle, OpenHevc_FrameInf
     openHevcFrameInfo->nHeight                 = picture->height;
     openHevcFrameInfo->sample_aspect_ratio.num = picture->sample_aspect_ratio.num;
     openHevcFrameInfo->sample_aspect_ratio.den = picture->sample_aspect_ratio.den;
-    openHevcFrameInfo->frameRate.num           = openHevcContext->c->time_base.den;
-    openHevcFrameInfo->frameRate.den           = openHevcContext->c->time_base.num;
+    openHevcFrameInfo->frameRate.num           = c->time_base.den;
+    openHevcFrameInfo->frameRate.den           = c->time_base.num;
     openHevcFrameInfo->display_picture_number  = picture->display_picture_number;
     openHevcFrameInfo->flag                    = (picture->top_field_first << 2) | picture->interlaced_frame; //progressive, interlaced, interlaced bottom field first, interlaced top field first.
     openHevcFrameInfo->nTimeStamp              = picture->pkt_pts;
 }
 
+void libOpenHevcGetPictureInfo(OpenHevc_Handle openHevcHandle, OpenHevc_FrameInfo *openHevcFrameInfo)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    OpenHevcWrapperContext  *openHevcContext  = openHevcContexts->wraper[openHevcContexts->display_layer];
+
+    get_frame_info(openHevcContext->c, openHevcContext->picture, openHevcFrameInfo);
+}
+
 void libOpenHevcGetPictureInfoCpy(OpenHevc_Handle openHevcHandle, OpenHevc_FrameInfo *openHevcFrameInfo)
 {
 
@@ -397,19 +827,97 @@ int libOpenHevcGetOutputCpy(OpenHevc_Handle openHevcHandle, int got_picture, Ope
     return 1;
 }
 
+int libOpenHevcGetOutputRef(OpenHevc_Handle openHevcHandle, int got_picture, OpenHevc_FrameRef *openHevcFrame)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    OpenHevcWrapperContext  *openHevcContext  = openHevcContexts->wraper[openHevcContexts->display_layer];
+    const AVPixFmtDescriptor *desc;
+    AVFrame *picture;
+    ptrdiff_t offset;
+    int pixel_shift;
+
+    openHevcFrame->priv = NULL;
+    if (!got_picture)
+        return 0;
+
+    /* a new reference on the output buffers: the decoder allocates fresh
+     * ones for the next pictures while the caller still holds these */
+    picture = av_frame_clone(openHevcContext->picture);
+    if (!picture)
+        return AVERROR(ENOMEM);
+
+    openHevcFrame->priv = picture;
+    openHevcFrame->pvY  = (void *) picture->data[0];
+    openHevcFrame->pvU  = (void *) picture->data[1];
+    openHevcFrame->pvV  = (void *) picture->data[2];
+    get_frame_info(openHevcContext->c, picture, &openHevcFrame->frameInfo);
+
+    /* the decoder crops by moving the plane pointers into the buffer */
+    desc        = av_pix_fmt_desc_get(picture->format);
+    pixel_shift = desc->comp[0].depth_minus1 > 7;
+    offset      = picture->buf[0] ? picture->data[0] - picture->buf[0]->data : 0;
+    openHevcFrame->nCropTop    = offset / picture->linesize[0];
+    openHevcFrame->nCropLeft   = (offset % picture->linesize[0]) >> pixel_shift;
+    openHevcFrame->nCropRight  = FFMAX(picture->coded_width  - picture->width  - openHevcFrame->nCropLeft, 0);
+    openHevcFrame->nCropBottom = FFMAX(picture->coded_height - picture->height - openHevcFrame->nCropTop,  0);
+    return 1;
+}
+
+void libOpenHevcReleaseFrame(OpenHevc_FrameRef *openHevcFrame)
+{
+    AVFrame *picture = openHevcFrame->priv;
+
+    av_frame_free(&picture);
+    openHevcFrame->priv = NULL;
+    openHevcFrame->pvY  = openHevcFrame->pvU = openHevcFrame->pvV = NULL;
+}
+
 void libOpenHevcSetDebugMode(OpenHevc_Handle openHevcHandle, int val)
 {
     if (val == 1)
         av_log_set_level(AV_LOG_DEBUG);
 }
+
+/* The flags are process wide: "-avx512" or "-avx2-avx512" drop extensions
+ * from the detected set, "0" disables all of them.  Decoders pick their DSP
+ * functions when they activate an SPS, so call this before decoding. */
+int libOpenHevcSetCpuFlags(OpenHevc_Handle openHevcHandle, const char *flags)
+{
+    unsigned cpu_flags;
+    int ret;
+
+    av_force_cpu_flags(-1);
+    cpu_flags = av_get_cpu_flags();
+    if ((ret = av_parse_cpu_caps(&cpu_flags, flags)) < 0)
+        return ret;
+    av_force_cpu_flags(cpu_flags);
+    return 0;
+}
+
+void libOpenHevcSetThreadStats(OpenHevc_Handle openHevcHandle, int val)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    OpenHevcWrapperContext  *openHevcContext;
+    int i;
+
+    for (i = 0; i < openHevcContexts->nb_decoders; i++) {
+        openHevcContext = openHevcContexts->wraper[i];
+        if (val)
+            openHevcContext->c->debug |= FF_DEBUG_THREADS;
+        else
+            openHevcContext->c->debug &= ~FF_DEBUG_THREADS;
+    }
+}
+
 void libOpenHevcSetActiveDecoders(OpenHevc_Handle openHevcHandle, int val)
 {
     OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
-    if (val >= 0 && val < openHevcContexts->nb_decoders)
+    int nb_decoders = openHevcContexts->nb_layers ? openHevcContexts->nb_layers : openHevcContexts->nb_decoders;
+    if (val >= 0 && val < nb_decoders)
         openHevcContexts->active_layer = val;
     else {
-        fprintf(stderr, "The requested layer %d can not be decoded (it exceeds the number of allocated decoders %d ) \n", val, openHevcContexts->nb_decoders);
-        openHevcContexts->active_layer = openHevcContexts->nb_decoders-1;
+        fprintf(stderr, "The requested layer %d can not be decoded (it exceeds the number of allocated decoders %d ) \n", val, nb_decoders);
+        openHevcContexts->active_layer = nb_decoders-1;
     }
 }
 
@@ -417,11 +925,12 @@ void libOpenHevcSetViewLayers(OpenHevc_Handle openHevcHandle, int val)
 {
     OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
     //openHevcContexts->set_display = 1;
-    if (val >= 0 && val < openHevcContexts->nb_decoders)
+    int nb_decoders = openHevcContexts->nb_layers ? openHevcContexts->nb_layers : openHevcContexts->nb_decoders;
+    if (val >= 0 && val < nb_decoders)
         openHevcContexts->display_layer = val;
     else {
-        fprintf(stderr, "The requested layer %d can not be viewed (it exceeds the number of allocated decoders %d ) \n", val, openHevcContexts->nb_decoders);
-        openHevcContexts->display_layer = openHevcContexts->nb_decoders-1;
+        fprintf(stderr, "The requested layer %d can not be viewed (it exceeds the number of allocated decoders %d ) \n", val, nb_decoders);
+        openHevcContexts->display_layer = nb_decoders-1;
     }
 }
 
@@ -464,6 +973,117 @@ void libOpenHevcSetNoCropping(OpenHevc_Handle openHevcHandle, int val)
     }
 }
 
+/* Creates the picture allocator state of the handle on first use, the
+ * decoders must not be open yet. */
+static FrameBudget *frame_budget(OpenHevcWrapperContexts *openHevcContexts)
+{
+    OpenHevcWrapperContext *openHevcContext;
+    FrameBudget *state;
+    int i;
+
+    if (openHevcContexts->frame_budget)
+        return (FrameBudget *) openHevcContexts->frame_budget->data;
+    if (openHevcContexts->nb_layers)
+        return NULL;
+
+    state = av_mallocz(sizeof(*state));
+    if (!state)
+        return NULL;
+    state->self = av_buffer_create((uint8_t *) state, sizeof(*state), free_frame_budget, NULL, 0);
+    if (!state->self) {
+        av_free(state);
+        return NULL;
+    }
+    ff_mutex_init(&state->mutex, NULL);
+    state->alloc = av_buffer_allocz;
+    openHevcContexts->frame_budget = state->self;
+
+    for (i = 0; i < openHevcContexts->nb_decoders; i++) {
+        openHevcContext = openHevcContexts->wraper[i];
+        state->layers[i].state = state;
+        openHevcContext->c->opaque                = &state->layers[i];
+        openHevcContext->c->get_buffer2           = get_pooled_buffer;
+        openHevcContext->c->thread_safe_callbacks = 1;
+    }
+    return state;
+}
+
+/* Sizes the DPB of each layer from its SPS and takes the pictures from
+ * pools shared by the layers, at most the DPB plus the frame threads plus
+ * extra_frames pictures per layer.  Call before libOpenHevcStartDecoder(). */
+int libOpenHevcSetBoundedDPB(OpenHevc_Handle openHevcHandle, int extra_frames)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    FrameBudget *state = frame_budget(openHevcContexts);
+    int i;
+
+    if (!state || state->bounded || openHevcContexts->nb_layers)
+        return AVERROR(EINVAL);
+    state->bounded      = 1;
+    state->extra_frames = FFMAX(extra_frames, 0);
+    for (i = 0; i < openHevcContexts->nb_decoders; i++)
+        av_opt_set_int(openHevcContexts->wraper[i]->c->priv_data, "bounded-dpb", 1, 0);
+    return 0;
+}
+
+/* Takes the pictures and the motion tables from pools shared with all the
+ * handles of the process that use this mode, keyed by the pixel format,
+ * which implies the bit depth, and the size.  Call before
+ * libOpenHevcStartDecoder(). */
+int libOpenHevcSetSharedPools(OpenHevc_Handle openHevcHandle)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    FrameBudget *state = frame_budget(openHevcContexts);
+    int i;
+
+    if (!state || state->shared || openHevcContexts->nb_layers)
+        return AVERROR(EINVAL);
+    state->shared = 1;
+    for (i = 0; i < openHevcContexts->nb_decoders; i++)
+        av_opt_set_int(openHevcContexts->wraper[i]->c->priv_data, "shared-pools", 1, 0);
+    return 0;
+}
+
+/* Backs the pictures with 2MB pages, 1 transparent, 2 from hugetlbfs with
+ * transparent ones as fallback, on the NUMA node of the decoding thread.
+ * Call before libOpenHevcStartDecoder(). */
+int libOpenHevcSetHugePages(OpenHevc_Handle openHevcHandle, int mode)
+{
+#if defined(__linux__)
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    FrameBudget *state;
+
+    if (mode < 0 || mode > 2)
+        return AVERROR(EINVAL);
+    if (!mode)
+        return 0;
+    state = frame_budget(openHevcContexts);
+    if (!state || openHevcContexts->nb_layers)
+        return AVERROR(EINVAL);
+    state->alloc = mode == 2 ? alloc_hugetlb_buffer : alloc_thp_buffer;
+    return 0;
+#else
+    return mode ? AVERROR(ENOSYS) : 0;
+#endif
+}
+
+/* Highest number of picture bytes the layer held at once, 0 unless the
+ * bounded DPB or the shared pool mode is on. */
+int64_t libOpenHevcGetPeakBytes(OpenHevc_Handle openHevcHandle, int layer)
+{
+    OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
+    FrameBudget *state;
+    int64_t peak_bytes;
+
+    if (!openHevcContexts->frame_budget || layer < 0 || layer >= MAX_DECODERS)
+        return 0;
+    state = (FrameBudget *) openHevcContexts->frame_budget->data;
+    ff_mutex_lock(&state->mutex);
+    peak_bytes = state->layers[layer].peak_bytes;
+    ff_mutex_unlock(&state->mutex);
+    return peak_bytes;
+}
+
 void libOpenHevcClose(OpenHevc_Handle openHevcHandle)
 {
     OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
@@ -479,6 +1099,7 @@ void libOpenHevcClose(OpenHevc_Handle openHevcHandle)
         av_freep(&openHevcContext);
     }
     av_freep(&openHevcContexts->wraper);
+    av_buffer_unref(&openHevcContexts->frame_budget);
     av_freep(&openHevcContexts);
 }
 
@@ -487,7 +1108,8 @@ void libOpenHevcFlush(OpenHevc_Handle openHevcHandle)
     OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
     OpenHevcWrapperContext  *openHevcContext  = openHevcContexts->wraper[openHevcContexts->active_layer];
 
-    openHevcContext->codec->flush(openHevcContext->c);
+    if (openHevcContexts->active_layer < openHevcContexts->nb_layers)
+        openHevcContext->codec->flush(openHevcContext->c);
 }
 
 void libOpenHevcFlushSVC(OpenHevc_Handle openHevcHandle, int decoderId)
@@ -495,7 +1117,8 @@ void libOpenHevcFlushSVC(OpenHevc_Handle openHevcHandle, int decoderId)
     OpenHevcWrapperContexts *openHevcContexts = (OpenHevcWrapperContexts *) openHevcHandle;
     OpenHevcWrapperContext  *openHevcContext  = openHevcContexts->wraper[decoderId];
 
-    openHevcContext->codec->flush(openHevcContext->c);
+    if (decoderId < openHevcContexts->nb_layers)
+        openHevcContext->codec->flush(openHevcContext->c);
 }
 
 const char *libOpenHevcVersion(OpenHevc_Handle openHevcHandle)
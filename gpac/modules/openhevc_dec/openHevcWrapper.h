@@ -76,6 +76,21 @@ typedef struct OpenHevc_Frame_cpy
    OpenHevc_FrameInfo frameInfo;
 } OpenHevc_Frame_cpy;
 
+/* Reference to a decoded picture: the planes stay valid, and are not reused
+ * by the decoder, until libOpenHevcReleaseFrame() is called on the handle. */
+typedef struct OpenHevc_FrameRef
+{
+   void*        pvY;          ///< first displayed sample of each plane
+   void*        pvU;
+   void*        pvV;
+   OpenHevc_FrameInfo frameInfo; ///< pitches are the decoder line sizes in bytes
+   int          nCropLeft;    ///< luma samples cropped from the coded picture
+   int          nCropRight;
+   int          nCropTop;
+   int          nCropBottom;
+   void*        priv;         ///< decoder-owned reference, NULL once released
+} OpenHevc_FrameRef;
+
 OpenHevc_Handle libOpenHevcInit(int nb_pthreads, int thread_type);
 int libOpenHevcStartDecoder(OpenHevc_Handle openHevcHandle);
 int  libOpenHevcDecode(OpenHevc_Handle openHevcHandle, const unsigned char *buff, int nal_len, int64_t pts);
@@ -85,12 +100,20 @@ void libOpenHevcCopyExtraData(OpenHevc_Handle openHevcHandle, unsigned char *ext
 void libOpenHevcGetPictureInfoCpy(OpenHevc_Handle openHevcHandle, OpenHevc_FrameInfo *openHevcFrameInfo);
 int  libOpenHevcGetOutput(OpenHevc_Handle openHevcHandle, int got_picture, OpenHevc_Frame *openHevcFrame);
 int  libOpenHevcGetOutputCpy(OpenHevc_Handle openHevcHandle, int got_picture, OpenHevc_Frame_cpy *openHevcFrame);
+int  libOpenHevcGetOutputRef(OpenHevc_Handle openHevcHandle, int got_picture, OpenHevc_FrameRef *openHevcFrame);
+void libOpenHevcReleaseFrame(OpenHevc_FrameRef *openHevcFrame);
 void libOpenHevcSetCheckMD5(OpenHevc_Handle openHevcHandle, int val);
 void libOpenHevcSetDebugMode(OpenHevc_Handle openHevcHandle, int val);
+void libOpenHevcSetThreadStats(OpenHevc_Handle openHevcHandle, int val);
+int  libOpenHevcSetCpuFlags(OpenHevc_Handle openHevcHandle, const char *flags);
 void libOpenHevcSetTemporalLayer_id(OpenHevc_Handle openHevcHandle, int val);
 void libOpenHevcSetNoCropping(OpenHevc_Handle openHevcHandle, int val);
 void libOpenHevcSetActiveDecoders(OpenHevc_Handle openHevcHandle, int val);
 void libOpenHevcSetViewLayers(OpenHevc_Handle openHevcHandle, int val);
+int  libOpenHevcSetBoundedDPB(OpenHevc_Handle openHevcHandle, int extra_frames);
+int  libOpenHevcSetSharedPools(OpenHevc_Handle openHevcHandle);
+int  libOpenHevcSetHugePages(OpenHevc_Handle openHevcHandle, int mode);
+int64_t libOpenHevcGetPeakBytes(OpenHevc_Handle openHevcHandle, int layer);
 void libOpenHevcClose(OpenHevc_Handle openHevcHandle);
 void libOpenHevcFlush(OpenHevc_Handle openHevcHandle);
 void libOpenHevcFlushSVC(OpenHevc_Handle openHevcHandle, int decoderId);
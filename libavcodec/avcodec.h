@@ -2752,6 +2752,7 @@ typedef struct AVCodecContext {
 #define FF_THREAD_FRAME         1 ///< Decode more than one frame at once
 #define FF_THREAD_SLICE         2 ///< Decode more than one part of a single frame at once
 #define FF_THREAD_FRAME_SLICE   4 ///< Decode more than one part of a single frame at once at more than one frame at once
+#define FF_THREAD_SLICE_PARALLEL 8 ///< With FF_THREAD_SLICE, also decode the independent slices of a frame at once
 
     /**
      * Which multithreading methods are in use by the codec.
@@ -3139,6 +3140,60 @@ typedef struct AVCodecContext {
     int quality_id;
 } AVCodecContext;
 
+#define AV_HEVC_MAX_LAYERS 8
+
+/**
+ * Layers of a scalable HEVC stream, as described by the VPS.
+ */
+typedef struct AVHEVCLayers {
+    int nb_layers;                       ///< vps_max_layers
+    int ref_layer[AV_HEVC_MAX_LAYERS];   ///< first direct reference layer, -1 if none
+    int width[AV_HEVC_MAX_LAYERS];       ///< luma size of each layer, 0 if unknown
+    int height[AV_HEVC_MAX_LAYERS];
+} AVHEVCLayers;
+
+/**
+ * Fill layers from the first VPS parsed by an HEVC decoder context.
+ *
+ * @return 0 on success, a negative error code if no VPS was seen yet
+ */
+int av_hevc_get_layers(AVCodecContext *avctx, AVHEVCLayers *layers);
+
+/**
+ * Get a reference to the process-wide pool of size-byte buffers described
+ * by tag, format, width, height and alloc, creating it on first use.  Decoders of
+ * the same geometry then recycle each other's buffers: the lookup takes a
+ * spin lock, getting and returning buffers is lock free.
+ *
+ * @param tag    what the buffers hold, e.g. MKTAG('P','I','C','T')
+ * @param format pixel format, which implies the bit depth, or -1
+ * @param alloc  buffer allocator of the pool, see av_buffer_pool_init()
+ * @return the pool, NULL on allocation failure
+ */
+AVBufferPool *av_hevc_shared_pool_init(int tag, int format, int width, int height, int size,
+                                       AVBufferRef* (*alloc)(int size));
+
+/**
+ * Drop a reference taken by av_hevc_shared_pool_init(), the pool is freed
+ * once no decoder uses it and all its buffers are returned.
+ */
+void av_hevc_shared_pool_uninit(AVBufferPool **pool);
+
+/**
+ * @return the number of references to the shared pools of buffers that
+ * hold tag, see av_hevc_shared_pool_init()
+ */
+int av_hevc_shared_pool_users(int tag);
+
+/**
+ * Find the first 00 00 xx sequence with xx <= 3 in an HEVC byte stream: a
+ * start code, the zero_byte before one or an emulation prevention byte.
+ * Uses SSE2 or AVX2 when available.
+ *
+ * @return the offset of the sequence, size if buf holds none
+ */
+int av_hevc_find_nal_marker(const uint8_t *buf, int size);
+
 AVRational av_codec_get_pkt_timebase         (const AVCodecContext *avctx);
 void       av_codec_set_pkt_timebase         (AVCodecContext *avctx, AVRational val);
 
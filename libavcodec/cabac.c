@@ -170,11 +170,54 @@ static int put_cabac_terminate(CABACContext *c, int bit){
     return (put_bits_count(&c->pb)+7)>>3;
 }
 
+static int bypass_calls;    ///< compared by check_bypass_batched()
+
+/**
+ * Decode buf with get_cabac_bypass() and with the batched readers side by
+ * side, in calls of up to max_bins bins.
+ * A stream starting with 9 bits >= 510 is corrupt: low then exceeds range
+ * and doubles its excess every bin, so only the first few bins before low
+ * overflows can be compared.
+ * @return 1 on mismatch
+ */
+static int check_bypass_batched(const uint8_t *buf, int size, AVLFG *prng,
+                                int calls, int max_bins)
+{
+    CABACContext a, b;
+    int i, j;
+
+    ff_init_cabac_decoder(&a, buf, size);
+    b = a;
+    for (i = 0; i < calls && a.bytestream < a.bytestream_end; i++) {
+        unsigned ref = 0, val;
+        int n;
+
+        if (av_lfg_get(prng) & 1) {
+            n = av_lfg_get(prng) % (max_bins + 1);
+            for (j = 0; j < n; j++)
+                ref = (ref << 1) | get_cabac_bypass(&a);
+            val = get_cabac_bypass_bits(&b, n);
+        } else {
+            n = 1 + av_lfg_get(prng) % max_bins;
+            while (ref < n && get_cabac_bypass(&a))
+                ref++;
+            val = get_cabac_bypass_unary(&b, n);
+        }
+        if (ref != val || a.low != b.low || a.bytestream != b.bytestream) {
+            av_log(NULL, AV_LOG_ERROR, "CABAC batched bypass failure at call %d: %u/%u\n",
+                   i, val, ref);
+            return 1;
+        }
+    }
+    bypass_calls += i;
+    return 0;
+}
+
 int main(void){
     CABACContext c;
     uint8_t b[9*SIZE];
     uint8_t r[9*SIZE];
-    int i;
+    int i, j, ret = 0;
     uint8_t state[10]= {0};
     AVLFG prng;
 
@@ -221,7 +264,20 @@ STOP_TIMER("get_cabac")
     if(!get_cabac_terminate(&c))
         av_log(NULL, AV_LOG_ERROR, "where's the Terminator?\n");
 
-    return 0;
+    for(j=0; j<20; j++){
+        for(i=0; i<sizeof(r); i++)
+            r[i] = av_lfg_get(&prng);
+        r[0] &= 0x7F;
+        ret |= check_bypass_batched(r, sizeof(r) - 2, &prng, INT_MAX, 32);
+    }
+
+    /* low starts 2^18 above range, so it overflows after 12 bins */
+    memset(r, 0xFF, sizeof(r));
+    for(i=0; i<1000; i++)
+        ret |= check_bypass_batched(r, sizeof(r) - 2, &prng, 1, 12);
+    av_log(NULL, AV_LOG_INFO, "%d batched bypass calls checked\n", bypass_calls);
+
+    return ret;
 }
 
 #endif /* TEST */
@@ -37,6 +37,8 @@
 #define CABAC_TABLE_CONST
 #endif
 extern CABAC_TABLE_CONST uint8_t ff_h264_cabac_tables[512 + 4*2*64 + 4*64 + 63];
+/* 2^39 / range rounded up, for range 256..511; see get_cabac_bypass_bits() */
+extern CABAC_TABLE_CONST uint32_t ff_cabac_bypass_inv[256];
 #define H264_NORM_SHIFT_OFFSET 0
 #define H264_LPS_RANGE_OFFSET 512
 #define H264_MLPS_STATE_OFFSET 1024
@@ -29,6 +29,7 @@
 
 #include <stdint.h>
 
+#include "libavutil/intmath.h"
 #include "cabac.h"
 #include "config.h"
 
@@ -161,6 +162,65 @@ static av_always_inline int get_cabac_bypass_sign(CABACContext *c, int val){
 }
 #endif
 
+/**
+ * Decode n (at most 32) bypass bins at once, the first one ending up in the
+ * most significant bit. Bypass bins leave range untouched, so the bins that
+ * can be taken from low before the next refill are the leading binary digits
+ * of low / (range << (CABAC_BITS + 1)): one multiplication by the reciprocal
+ * of range per refill instead of one compare and subtract per bin.
+ * A corrupt stream can leave low >= range << (CABAC_BITS + 1), for which the
+ * bins are all 1: the quotient is clamped to m bits to match get_cabac_bypass()
+ * and keep the result below 2^n.
+ */
+static av_always_inline unsigned get_cabac_bypass_bits(CABACContext *c, int n)
+{
+    unsigned value = 0;
+
+    while (n > 0) {
+        int m      = FFMIN(n, CABAC_BITS - ff_ctz(c->low));
+        unsigned q = ((uint64_t)((unsigned)c->low >> (CABAC_BITS + 1 - m)) *
+                      ff_cabac_bypass_inv[c->range - 256]) >> 39;
+
+        q      = FFMIN(q, (1U << m) - 1);
+        c->low = ((unsigned)c->low << m) - q * ((unsigned)c->range << (CABAC_BITS + 1));
+        value  = (value << m) | q;
+        n     -= m;
+        if (!(c->low & CABAC_MASK))
+            refill(c);
+    }
+    return value;
+}
+
+/**
+ * Decode bypass bins up to and including the first 0, reading at most max
+ * 1 bins, the same way as get_cabac_bypass_bits().
+ * @return the number of 1 bins
+ */
+static av_always_inline int get_cabac_bypass_unary(CABACContext *c, int max)
+{
+    int ones = 0;
+
+    while (ones < max) {
+        int m      = FFMIN(max - ones, CABAC_BITS - ff_ctz(c->low));
+        unsigned q = ((uint64_t)((unsigned)c->low >> (CABAC_BITS + 1 - m)) *
+                      ff_cabac_bypass_inv[c->range - 256]) >> 39;
+        unsigned z;
+        int n;
+
+        q = FFMIN(q, (1U << m) - 1);
+        z = ~q & ((1U << m) - 1);
+        n = z ? m - av_log2(z) : m;
+
+        c->low = ((unsigned)c->low << n) - (q >> (m - n)) * ((unsigned)c->range << (CABAC_BITS + 1));
+        if (!(c->low & CABAC_MASK))
+            refill(c);
+        if (z)
+            return ones + n - 1;
+        ones += m;
+    }
+    return ones;
+}
+
 /**
  *
  * @return the number of bytes read or 0 if no end
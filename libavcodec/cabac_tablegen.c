@@ -36,6 +36,7 @@ int main(void)
     write_fileheader();
 
     WRITE_ARRAY("const", uint8_t, ff_h264_cabac_tables);
+    WRITE_ARRAY("const", uint32_t, ff_cabac_bypass_inv);
 
     return 0;
 }
@@ -28,6 +28,7 @@
 #include "libavcodec/cabac_tables.h"
 #else
 uint8_t ff_h264_cabac_tables[512 + 4*2*64 + 4*64 + 63];
+uint32_t ff_cabac_bypass_inv[256];
 
 static const uint8_t lps_range[64][4]= {
 {128,176,208,240}, {128,167,197,227}, {128,158,187,216}, {123,150,178,205},
@@ -102,6 +103,8 @@ static av_cold void cabac_tableinit(void)
     for(i=0; i< 63; i++){
       ff_h264_last_coeff_flag_offset_8x8[i] = last_coeff_flag_offset_8x8[i];
     }
+    for (i = 0; i < 256; i++)
+        ff_cabac_bypass_inv[i] = (1ULL << 39) / (256 + i) + 1;
 }
 #endif /* CONFIG_HARDCODED_TABLES */
 
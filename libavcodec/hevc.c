@@ -62,149 +62,146 @@ static void printf_ref_pic_list(HEVCContext *s);
 /* free everything allocated  by pic_arrays_init() */
 static void pic_arrays_free(HEVCContext *s)
 {
-    av_freep(&s->sao);
-    av_freep(&s->deblock);
+    av_freep(&s->pic_arena);
+    s->sao                = NULL;
+    s->deblock            = NULL;
 
-    av_freep(&s->skip_flag);
-    av_freep(&s->tab_ct_depth);
+    s->skip_flag          = NULL;
+    s->tab_ct_depth       = NULL;
 
-    av_freep(&s->tab_ipm);
-    av_freep(&s->cbf_luma);
-    av_freep(&s->is_pcm);
+    s->tab_ipm            = NULL;
+    s->cbf_luma           = NULL;
+    s->is_pcm             = NULL;
 
-    av_freep(&s->qp_y_tab);
-    av_freep(&s->tab_slice_address);
-    av_freep(&s->filter_slice_edges);
+    s->qp_y_tab           = NULL;
+    s->tab_slice_address  = NULL;
+    s->filter_slice_edges = NULL;
 
-    av_freep(&s->horizontal_bs);
-    av_freep(&s->vertical_bs);
+    s->horizontal_bs      = NULL;
+    s->vertical_bs        = NULL;
 
     av_freep(&s->sh.entry_point_offset);
     av_freep(&s->sh.size);
-    av_freep(&s->sh.offset);
+    av_freep(&s->sh.data);
 
-    av_buffer_pool_uninit(&s->tab_mvf_pool);
-    av_buffer_pool_uninit(&s->rpl_tab_pool);
+    if (s->shared_pools) {
+        av_hevc_shared_pool_uninit(&s->tab_mvf_pool);
+        av_hevc_shared_pool_uninit(&s->rpl_tab_pool);
+    } else {
+        av_buffer_pool_uninit(&s->tab_mvf_pool);
+        av_buffer_pool_uninit(&s->rpl_tab_pool);
+    }
 
 #ifdef SVC_EXTENSION
-#if ACTIVE_BOTH_FRAME_AND_PU
-    av_freep(&s->buffer_frame[0]);
-    av_freep(&s->buffer_frame[1]);
-    av_freep(&s->buffer_frame[2]);
-    av_freep(&s->is_upsampled);
-#else
-#if !ACTIVE_PU_UPSAMPLING
-    av_freep(&s->buffer_frame[0]);
-    av_freep(&s->buffer_frame[1]);
-    av_freep(&s->buffer_frame[2]);
-#else
-    av_freep(&s->is_upsampled);
-#endif
-#endif    
-#endif
-
-#if PARALLEL_SLICE
-    av_freep(&s->decoded_rows);
+    s->buffer_frame[0] = NULL;
+    s->buffer_frame[1] = NULL;
+    s->buffer_frame[2] = NULL;
+    s->is_upsampled    = NULL;
 #endif
 }
 
-/* allocate arrays that depend on frame dimensions */
-static int pic_arrays_init(HEVCContext *s, const HEVCSPS *sps)
+#define ARENA_ALIGN 64
+
+/*
+ * Lay the tables that depend on frame dimensions out in one arena, each
+ * table starting on a cache line. Tables written together while parsing a
+ * CU come first, then the ones reset for each CTB before it is decoded, see
+ * clear_ctb_tables(), then the CTB level slice addresses and filter
+ * parameters. Returns the arena size; the table pointers are only set when
+ * base is not NULL.
+ */
+static size_t pic_arrays_layout(HEVCContext *s, const HEVCSPS *sps, uint8_t *base)
 {
     int log2_min_cb_size = sps->log2_min_cb_size;
-    int width            = sps->width;
-    int height           = sps->height;
-    int pic_size         = width * height;
-    int pic_size_in_ctb  = ((width  >> log2_min_cb_size) + 1) *
-                           ((height >> log2_min_cb_size) + 1);
+    int pic_size_in_ctb  = ((sps->width  >> log2_min_cb_size) + 1) *
+                           ((sps->height >> log2_min_cb_size) + 1);
     int ctb_count        = sps->ctb_width * sps->ctb_height;
     int min_pu_size      = sps->min_pu_width * sps->min_pu_height;
+    int bs_width         = sps->width  >> 2;
+    int bs_height        = sps->height >> 2;
+    size_t size = 0;
+
+#define ARENA_TABLE(table, count)                                 \
+    do {                                                          \
+        if (base)                                                 \
+            s->table = (void *) (base + size);                    \
+        size += FFALIGN((count) * sizeof(*s->table), ARENA_ALIGN); \
+    } while (0)
+
+    // CU and PU parsing
+    ARENA_TABLE(skip_flag,         sps->min_cb_height * sps->min_cb_width);
+    ARENA_TABLE(tab_ct_depth,      sps->min_cb_height * sps->min_cb_width);
+    ARENA_TABLE(tab_ipm,           min_pu_size);
+    ARENA_TABLE(is_pcm,            min_pu_size);
+    ARENA_TABLE(qp_y_tab,          pic_size_in_ctb);
+
+    // reset for each CTB
+    ARENA_TABLE(horizontal_bs,     (bs_width + 4 * (1 << sps->hshift[1])) * bs_height);
+    ARENA_TABLE(vertical_bs,       bs_width * (bs_height + 4 * (1 << sps->vshift[1])));
+    ARENA_TABLE(cbf_luma,          sps->min_tb_width * sps->min_tb_height);
+
+    // set for each CTB, reset for each picture
+    ARENA_TABLE(tab_slice_address, pic_size_in_ctb);
+
+    // CTB level loop filter parameters
+    ARENA_TABLE(sao,               ctb_count);
+    ARENA_TABLE(deblock,           ctb_count);
+    ARENA_TABLE(filter_slice_edges, ctb_count);
 
-    s->bs_width  = (width  >> 2);
-    s->bs_height = (height >> 2);
-
-    s->sao           = av_mallocz_array(ctb_count, sizeof(*s->sao));
-    s->deblock       = av_mallocz_array(ctb_count, sizeof(*s->deblock));
-    s->dynamic_alloc += sizeof(*s->sao);
-    s->dynamic_alloc += sizeof(*s->deblock);
-//    s->dynamic_alloc += pic_size;
-
-    if (!s->sao || !s->deblock)
-        goto fail;
-
-    s->skip_flag    = av_malloc(sps->min_cb_height * sps->min_cb_width);
-    s->tab_ct_depth = av_malloc(sps->min_cb_height * sps->min_cb_width);
-    s->dynamic_alloc += (sps->min_cb_height * sps->min_cb_width);
-    s->dynamic_alloc += (sps->min_cb_height * sps->min_cb_width);
-#if PARALLEL_SLICE
-    s->decoded_rows = av_malloc(sps->ctb_height);
+#ifdef SVC_EXTENSION
+    if (s->decoder_id) {
+#if ACTIVE_BOTH_FRAME_AND_PU || ACTIVE_PU_UPSAMPLING
+        ARENA_TABLE(is_upsampled,  ctb_count);
 #endif
-    if (!s->skip_flag || !s->tab_ct_depth)
-        goto fail;
-
-    s->cbf_luma = av_malloc(sps->min_tb_width * sps->min_tb_height);
-    s->tab_ipm  = av_mallocz(min_pu_size);
-    s->is_pcm   = av_mallocz(min_pu_size);
-
-    s->dynamic_alloc += (sps->min_tb_width * sps->min_tb_height);
-    s->dynamic_alloc += min_pu_size;
-    s->dynamic_alloc += min_pu_size;
-    if (!s->tab_ipm || !s->cbf_luma || !s->is_pcm)
-        goto fail;
+#if ACTIVE_BOTH_FRAME_AND_PU || !ACTIVE_PU_UPSAMPLING
+        ARENA_TABLE(buffer_frame[0], sps->width * sps->height);
+        ARENA_TABLE(buffer_frame[1], (sps->width * sps->height) >> 2);
+        ARENA_TABLE(buffer_frame[2], (sps->width * sps->height) >> 2);
+#endif
+    }
+#endif
+#undef ARENA_TABLE
 
-    s->filter_slice_edges = av_malloc(ctb_count);
-    s->tab_slice_address  = av_malloc(pic_size_in_ctb *
-                                      sizeof(*s->tab_slice_address));
-    s->qp_y_tab           = av_malloc(pic_size_in_ctb *
-                                      sizeof(*s->qp_y_tab));
-
-    s->dynamic_alloc += ctb_count;
-    s->dynamic_alloc += (pic_size_in_ctb *
-                         sizeof(*s->tab_slice_address));
-    s->dynamic_alloc += (pic_size_in_ctb *
-                         sizeof(*s->qp_y_tab));
-    if (!s->qp_y_tab || !s->filter_slice_edges || !s->tab_slice_address)
-        goto fail;
+    return size;
+}
 
-    
-    s->horizontal_bs = av_mallocz((s->bs_width+(4*(1 << sps->hshift[1]))) * s->bs_height);
-    s->vertical_bs   = av_mallocz(s->bs_width * (s->bs_height+4*(1 << sps->vshift[1])));
-    
-    s->dynamic_alloc += (s->bs_width * s->bs_height);
-    s->dynamic_alloc += (s->bs_width * s->bs_height);
-    if (!s->horizontal_bs || !s->vertical_bs)
+/* allocate arrays that depend on frame dimensions */
+static int pic_arrays_init(HEVCContext *s, const HEVCSPS *sps)
+{
+    int pic_size_in_ctb = ((sps->width  >> sps->log2_min_cb_size) + 1) *
+                          ((sps->height >> sps->log2_min_cb_size) + 1);
+    int ctb_count   = sps->ctb_width * sps->ctb_height;
+    int min_pu_size = sps->min_pu_width * sps->min_pu_height;
+    size_t arena_size;
+
+    s->bs_width  = (sps->width  >> 2);
+    s->bs_height = (sps->height >> 2);
+
+    arena_size   = pic_arrays_layout(s, sps, NULL);
+    s->pic_arena = av_mallocz(arena_size + ARENA_ALIGN - 1);
+    if (!s->pic_arena)
         goto fail;
+    pic_arrays_layout(s, sps, (uint8_t *) FFALIGN((uintptr_t) s->pic_arena, ARENA_ALIGN));
+    s->dynamic_alloc += arena_size;
+    /* only the entries of actual CTBs are reset per picture */
+    memset(s->tab_slice_address, -1, pic_size_in_ctb * sizeof(*s->tab_slice_address));
 
-    s->tab_mvf_pool = av_buffer_pool_init(min_pu_size * sizeof(MvField),
-                                          av_buffer_allocz);
-    s->rpl_tab_pool = av_buffer_pool_init(ctb_count * sizeof(RefPicListTab),
-                                          av_buffer_allocz);
+    if (s->shared_pools) {
+        s->tab_mvf_pool = av_hevc_shared_pool_init(MKTAG('M','V','F',' '), -1, sps->width, sps->height,
+                                                   min_pu_size * sizeof(MvField), av_buffer_allocz);
+        s->rpl_tab_pool = av_hevc_shared_pool_init(MKTAG('R','P','L','T'), -1, sps->width, sps->height,
+                                                   ctb_count * sizeof(RefPicListTab), av_buffer_allocz);
+    } else {
+        s->tab_mvf_pool = av_buffer_pool_init(min_pu_size * sizeof(MvField),
+                                              av_buffer_allocz);
+        s->rpl_tab_pool = av_buffer_pool_init(ctb_count * sizeof(RefPicListTab),
+                                              av_buffer_allocz);
+    }
     s->dynamic_alloc += (min_pu_size * sizeof(MvField));
     s->dynamic_alloc += (ctb_count * sizeof(RefPicListTab));
 
     if (!s->tab_mvf_pool || !s->rpl_tab_pool)
         goto fail;
-#ifdef SVC_EXTENSION
-    if(s->decoder_id)    {
-
-#if ACTIVE_BOTH_FRAME_AND_PU
-        s->buffer_frame[0] = av_malloc(pic_size*sizeof(short));
-        s->buffer_frame[1] = av_malloc((pic_size>>2)*sizeof(short));
-        s->buffer_frame[2] = av_malloc((pic_size>>2)*sizeof(short));
-        s->is_upsampled = av_malloc(sps->ctb_width * sps->ctb_height);
-        s->dynamic_alloc += (sps->ctb_width * sps->ctb_height);
-#else
-#if !ACTIVE_PU_UPSAMPLING
-        s->buffer_frame[0] = av_malloc(pic_size*sizeof(short));
-        s->buffer_frame[1] = av_malloc((pic_size>>2)*sizeof(short));
-        s->buffer_frame[2] = av_malloc((pic_size>>2)*sizeof(short));
-#else
-        s->is_upsampled = av_malloc(sps->ctb_width * sps->ctb_height);
-        s->dynamic_alloc += (sps->ctb_width * sps->ctb_height);
-#endif
-#endif
-    }
-#endif
 
 #if 0
     printf("dynamic #*# %ld #*#  %d #*# \n", s->dynamic_alloc, s->decoder_id );
@@ -402,6 +399,16 @@ static int set_sps(HEVCContext *s, const HEVCSPS *sps)
     s->avctx->sample_aspect_ratio = sps->vui.sar;
     s->avctx->has_b_frames        = sps->temporal_layer[sps->max_sub_layers - 1].num_reorder_pics;
 
+    /* The pictures the SPS lets the HRD hold, the one being decoded and the
+     * inter-layer reference of an enhancement layer.  The prior sequence is
+     * output lazily after an IRAP, so up to num_reorder_pics of its pictures
+     * can still wait in the DPB next to the new ones. */
+    s->dpb_frames = sps->temporal_layer[sps->max_sub_layers - 1].max_dec_pic_buffering +
+                    sps->temporal_layer[sps->max_sub_layers - 1].num_reorder_pics + 1 +
+                    !!s->decoder_id;
+    /* for get_buffer2(), which runs on the context of the frame thread */
+    s->avctx->refs = s->dpb_frames;
+
     if (sps->vui.video_signal_type_present_flag)
         s->avctx->color_range = sps->vui.video_full_range_flag ? AVCOL_RANGE_JPEG
                                                                : AVCOL_RANGE_MPEG;
@@ -530,25 +537,6 @@ static int hls_slice_header(HEVCContext *s)
 #endif
     int first_slice_in_pic_flag = get_bits1(gb);
 
-#if PARALLEL_SLICE
-    if (IS_IRAP(s)) {
-        if(!first_slice_in_pic_flag) {
-            int self_id, temporal_id, nuh_layer_id, nal_unit_type, job;
-            nal_unit_type = s->nal_unit_type;
-            self_id       = s->self_id;
-            temporal_id   = s->temporal_id;
-            nuh_layer_id  = s->nuh_layer_id;
-            job           = s->job;
-            ff_thread_await_progress_slice(s->avctx);
-            memcpy(s, s1, sizeof(HEVCContext));
-            s->HEVClc                 = s1->HEVClcList[self_id];
-            s->nal_unit_type          = nal_unit_type;
-            s->temporal_id            = temporal_id;
-            s->nuh_layer_id           = nuh_layer_id;
-            s->job                    = job;
-        }
-    }
-#endif
     sh->first_slice_in_pic_flag   = first_slice_in_pic_flag;
 
 	if (s1->force_first_slice_in_pic) {
@@ -623,10 +611,6 @@ static int hls_slice_header(HEVCContext *s)
         slice_address_length = av_ceil_log2(s->sps->ctb_width *
                                             s->sps->ctb_height);
         sh->slice_segment_addr = get_bits(gb, slice_address_length);
-#if PARALLEL_SLICE
-        s1->slice_segment_addr[s->job] = sh->slice_segment_addr;
-        ff_thread_report_progress_slice2(s->avctx, s->job);
-#endif
 
         print_cabac("slice_segment_address", sh->slice_segment_addr );
         if (sh->slice_segment_addr >= s->sps->ctb_width * s->sps->ctb_height) {
@@ -638,15 +622,7 @@ static int hls_slice_header(HEVCContext *s)
 
         if (!sh->dependent_slice_segment_flag) {
             sh->slice_addr = sh->slice_segment_addr;
-#if PARALLEL_SLICE
-if (0)
-    s->slice_idx = s->job;
-else
-    s->slice_idx++;
-
-#else
             s->slice_idx++;
-#endif
         }
     } else {
         sh->slice_segment_addr = sh->slice_addr = 0;
@@ -1028,12 +1004,12 @@ else
             int segments = offset_len >> 4;
             int rest = (offset_len & 15);
             av_freep(&sh->entry_point_offset);
-            av_freep(&sh->offset);
+            av_freep(&sh->data);
             av_freep(&sh->size);
             sh->entry_point_offset = av_malloc(sh->num_entry_point_offsets * sizeof(int));
-            sh->offset = av_malloc(sh->num_entry_point_offsets * sizeof(int));
+            sh->data = av_malloc(sh->num_entry_point_offsets * sizeof(*sh->data));
             sh->size = av_malloc(sh->num_entry_point_offsets * sizeof(int));
-            if (!sh->entry_point_offset || !sh->offset || !sh->size) {
+            if (!sh->entry_point_offset || !sh->data || !sh->size) {
                 sh->num_entry_point_offsets = 0;
                 av_log(s->avctx, AV_LOG_ERROR, "Failed to allocate memory\n");
                 return AVERROR(ENOMEM);
@@ -1956,14 +1932,6 @@ static void hevc_await_progress(HEVCContext *s, HEVCFrame *ref,
     if (s->threads_type & FF_THREAD_FRAME )
         ff_thread_await_progress(&ref->tf, y, 0);
 }
-static void hevc_await_progress_bl(HEVCContext *s, HEVCFrame *ref,
-                                const Mv *mv, int y0)
-{
-    int y = (mv->y >> 2) + y0 + (1<<s->sps->log2_ctb_size)*2 + 9;
-    int bl_y = (( (y  - s->sps->pic_conf_win.top_offset) * s->up_filter_inf.scaleYLum + s->up_filter_inf.addYLum) >> 12) >> 4;
-    if (s->threads_type & FF_THREAD_FRAME )
-        ff_thread_await_progress(&s->BL_frame->tf, bl_y, 0);
-}
 
 static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
                                 int nPbW, int nPbH,
@@ -2023,9 +1991,6 @@ static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
             if (inter_pred_idc != PRED_L1) {
                 if (s->sh.nb_refs[L0]) {
                     current_mv.ref_idx[0] = ff_hevc_ref_idx_lx_decode(s, s->sh.nb_refs[L0]);
-#ifdef TEST_MV_POC
-                    current_mv.poc[0] = refPicList[0].list[current_mv.ref_idx[0]];
-#endif
                 }
                 current_mv.pred_flag = PF_L0;
                 ff_hevc_hls_mvd_coding(s, x0, y0, 0);
@@ -2040,9 +2005,6 @@ static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
             if (inter_pred_idc != PRED_L0) {
                 if (s->sh.nb_refs[L1]) {
                     current_mv.ref_idx[1] = ff_hevc_ref_idx_lx_decode(s, s->sh.nb_refs[L1]);
-#ifdef TEST_MV_POC
-                    current_mv.poc[1] = refPicList[1].list[current_mv.ref_idx[1]];
-#endif
                 }
 
                 if (s->sh.mvd_l1_zero_flag == 1 && inter_pred_idc == PRED_BI) {
@@ -2077,7 +2039,6 @@ static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
         if(ref0 == s->inter_layer_ref) {
             int y = (current_mv.mv[0].y >> 2) + y0;
             int x = (current_mv.mv[0].x >> 2) + x0;
-            hevc_await_progress_bl(s, ref0, &current_mv.mv[0], y0);
 
             ff_upsample_block(s, ref0, x, y, nPbW, nPbH);
         }
@@ -2092,7 +2053,6 @@ static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
         if(ref1 == s->inter_layer_ref ) {
             int y = (current_mv.mv[1].y >> 2) + y0;
             int x = (current_mv.mv[1].x >> 2) + x0;
-            hevc_await_progress_bl(s, ref1, &current_mv.mv[1], y0);
 
             ff_upsample_block(s, ref1, x, y, nPbW, nPbH);
         }
@@ -2589,6 +2549,31 @@ static int hls_coding_quadtree(HEVCContext *s, int x0, int y0,
     return 0;
 }
 
+/*
+ * Reset the boundary strengths and cbf_luma flags of a CTB before it is
+ * decoded. This is done by the thread decoding the CTB, instead of clearing
+ * the whole maps in hevc_frame_start(): all the entries of a CTB are
+ * written while decoding it or afterwards by the seam passes of
+ * tiles_filters() and slices_filters().
+ */
+static void clear_ctb_tables(HEVCContext *s, int x_ctb, int y_ctb)
+{
+    int ctb_size     = 1 << s->sps->log2_ctb_size;
+    int log2_tb_size = s->sps->log2_min_tb_size;
+    int x_end        = FFMIN(x_ctb + ctb_size, s->sps->width);
+    int y_end        = FFMIN(y_ctb + ctb_size, s->sps->height);
+    int bs_w         = (x_end >> 2) - (x_ctb >> 2);
+    int tb_w         = (x_end >> log2_tb_size) - (x_ctb >> log2_tb_size);
+    int y;
+
+    for (y = y_ctb >> 2; y < y_end >> 2; y++) {
+        memset(&s->horizontal_bs[y * s->bs_width + (x_ctb >> 2)], 0, bs_w);
+        memset(&s->vertical_bs  [y * s->bs_width + (x_ctb >> 2)], 0, bs_w);
+    }
+    for (y = y_ctb >> log2_tb_size; y < y_end >> log2_tb_size; y++)
+        memset(&s->cbf_luma[y * s->sps->min_tb_width + (x_ctb >> log2_tb_size)], 0, tb_w);
+}
+
 static void hls_decode_neighbour(HEVCContext *s, int x_ctb, int y_ctb,
                                  int ctb_addr_ts)
 {
@@ -2601,6 +2586,7 @@ static void hls_decode_neighbour(HEVCContext *s, int x_ctb, int y_ctb,
     int slice_left_boundary, slice_up_boundary;
 
     s->tab_slice_address[ctb_addr_rs] = s->sh.slice_addr;
+    clear_ctb_tables(s, x_ctb, y_ctb);
 
     if (s->pps->entropy_coding_sync_enabled_flag) {
         if (x_ctb == 0 && (y_ctb & (ctb_size - 1)) == 0)
@@ -2641,9 +2627,8 @@ static void hls_decode_neighbour(HEVCContext *s, int x_ctb, int y_ctb,
     lc->ctb_up_left_flag  = ((x_ctb > 0) && (y_ctb > 0)  && (ctb_addr_in_slice-1 >= s->sps->ctb_width) && (s->pps->tile_id[ctb_addr_ts] == s->pps->tile_id[s->pps->ctb_addr_rs_to_ts[ctb_addr_rs-1 - s->sps->ctb_width]]));
 }
 
-static int hls_decode_entry(AVCodecContext *avctxt, void *isFilterThread)
+static int hls_decode_slice(HEVCContext *s)
 {
-    HEVCContext *s  = avctxt->priv_data;
     int ctb_size    = 1 << s->sps->log2_ctb_size;
     int more_data   = 1;
     int x_ctb       = 0;
@@ -2676,6 +2661,7 @@ static int hls_decode_entry(AVCodecContext *avctxt, void *isFilterThread)
 
         s->deblock[ctb_addr_rs].beta_offset = s->sh.beta_offset;
         s->deblock[ctb_addr_rs].tc_offset   = s->sh.tc_offset;
+        s->deblock[ctb_addr_rs].disable     = s->sh.disable_deblocking_filter_flag;
         s->filter_slice_edges[ctb_addr_rs]  = s->sh.slice_loop_filter_across_slices_enabled_flag;
 
         more_data = hls_coding_quadtree(s, x_ctb, y_ctb, s->sps->log2_ctb_size, 0);
@@ -2687,67 +2673,34 @@ static int hls_decode_entry(AVCodecContext *avctxt, void *isFilterThread)
         ctb_addr_ts++;
         s->HEVClc->ctb_tile_rs++;
         ff_hevc_save_states(s, ctb_addr_ts);
-        ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
+        // concurrent slices filter their own CTB rows once decoded
+        if (!s->slice_parallel)
+            ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
     }
 
-    if (x_ctb + ctb_size >= s->sps->width &&
-        y_ctb + ctb_size >= s->sps->height)
+    // without tiles, the CTBs of the slice are in raster order
+    if (s->slice_parallel)
+        ff_hevc_hls_filter_slice_rows(s, s->sh.slice_ctb_addr_rs, ctb_addr_ts);
+    else if (x_ctb + ctb_size >= s->sps->width &&
+             y_ctb + ctb_size >= s->sps->height)
         ff_hevc_hls_filter(s, x_ctb, y_ctb, ctb_size);
 
     return ctb_addr_ts;
 }
 
-#if PARALLEL_SLICE
-static int hls_decode_entry_slice(HEVCContext *s)
+static int hls_decode_entry(AVCodecContext *avctxt, void *isFilterThread)
 {
-    int ctb_size    = 1 << s->sps->log2_ctb_size;
-    int more_data   = 1;
-    int x_ctb       = 0;
-    int y_ctb       = 0;
-    int ctb_addr_ts = s->pps->ctb_addr_rs_to_ts[s->sh.slice_ctb_addr_rs];
-
-    if (!ctb_addr_ts && s->sh.dependent_slice_segment_flag) {
-        av_log(s->avctx, AV_LOG_ERROR, "Impossible initial tile.\n");
-        return AVERROR_INVALIDDATA;
-    }
-
-    if (s->sh.dependent_slice_segment_flag) {
-        int prev_rs = s->pps->ctb_addr_ts_to_rs[ctb_addr_ts - 1];
-        if (s->tab_slice_address[prev_rs] != s->sh.slice_addr) {
-            av_log(s->avctx, AV_LOG_ERROR, "Previous slice segment missing\n");
-            return AVERROR_INVALIDDATA;
-        }
-    }
-
-    while (more_data) {
-        int ctb_addr_rs = s->pps->ctb_addr_ts_to_rs[ctb_addr_ts];
-
-        x_ctb = FFUMOD(ctb_addr_rs, s->sps->ctb_width) << s->sps->log2_ctb_size;
-        y_ctb = FFUDIV(ctb_addr_rs, s->sps->ctb_width) << s->sps->log2_ctb_size;
-        hls_decode_neighbour(s, x_ctb, y_ctb, ctb_addr_ts);
-
-        ff_hevc_cabac_init(s, ctb_addr_ts);
-
-        hls_sao_param(s, x_ctb >> s->sps->log2_ctb_size, y_ctb >> s->sps->log2_ctb_size);
+    return hls_decode_slice(avctxt->priv_data);
+}
 
-        s->deblock[ctb_addr_rs].beta_offset = s->sh.beta_offset;
-        s->deblock[ctb_addr_rs].tc_offset   = s->sh.tc_offset;
-        s->filter_slice_edges[ctb_addr_rs]  = s->sh.slice_loop_filter_across_slices_enabled_flag;
-        more_data = hls_coding_quadtree(s, x_ctb, y_ctb, s->sps->log2_ctb_size, 0);
+static int hls_decode_entry_slice(AVCodecContext *avctxt, void *input_slot, int job, int self_id)
+{
+    HEVCContext *s1 = avctxt->priv_data;
+    int *slot       = input_slot;
 
-        if (more_data < 0) {
-            s->tab_slice_address[ctb_addr_rs] = -1;
-            return more_data;
-        }
-        ctb_addr_ts++;
-        ff_hevc_save_states(s, ctb_addr_ts);
-#if PARALLEL_FILTERS
-        ff_hevc_hls_filters_slice(s, x_ctb, y_ctb, ctb_size);
-#endif
-    }
-    return ctb_addr_ts;
+    return hls_decode_slice(s1->sList[slot[job]]);
 }
-#endif
+
 static int hls_decode_entry_wpp(AVCodecContext *avctxt, void *input_ctb_row, int job, int self_id)
 {
     HEVCContext *s1  = avctxt->priv_data, *s;
@@ -2766,11 +2719,11 @@ static int hls_decode_entry_wpp(AVCodecContext *avctxt, void *input_ctb_row, int
     lc = s->HEVClc;
 
     if(ctb_row) {
-        ret = init_get_bits8(&lc->gb, s->data + s->sh.offset[ctb_row - 1], s->sh.size[ctb_row - 1]);
+        ret = init_get_bits8(&lc->gb, s->sh.data[ctb_row - 1], s->sh.size[ctb_row - 1]);
 
         if (ret < 0)
             return ret;
-        ff_init_cabac_decoder(&lc->cc, s->data + s->sh.offset[(ctb_row)-1], s->sh.size[ctb_row - 1]);
+        ff_init_cabac_decoder(&lc->cc, s->sh.data[ctb_row - 1], s->sh.size[ctb_row - 1]);
     }
 
     while(more_data && ctb_addr_ts < s->sps->ctb_size) {
@@ -2791,6 +2744,7 @@ static int hls_decode_entry_wpp(AVCodecContext *avctxt, void *input_ctb_row, int
 
         s->deblock[ctb_addr_rs].beta_offset = s->sh.beta_offset;
         s->deblock[ctb_addr_rs].tc_offset   = s->sh.tc_offset;
+        s->deblock[ctb_addr_rs].disable     = s->sh.disable_deblocking_filter_flag;
         s->filter_slice_edges[ctb_addr_rs]  = s->sh.slice_loop_filter_across_slices_enabled_flag;
 
         more_data = hls_coding_quadtree(s, x_ctb, y_ctb, s->sps->log2_ctb_size, 0);
@@ -2849,11 +2803,11 @@ static int hls_decode_entry_wpp_in_tiles(AVCodecContext *avctxt, int *input_ctb_
     lc = s->HEVClc;
 
     if(ctb_row) {
-        ret = init_get_bits8(&lc->gb, s->data + s->sh.offset[ctb_row - 1], s->sh.size[ctb_row - 1]);
+        ret = init_get_bits8(&lc->gb, s->sh.data[ctb_row - 1], s->sh.size[ctb_row - 1]);
 
         if (ret < 0)
             return ret;
-        ff_init_cabac_decoder(&lc->cc, s->data + s->sh.offset[(ctb_row)-1], s->sh.size[ctb_row - 1]);
+        ff_init_cabac_decoder(&lc->cc, s->sh.data[ctb_row - 1], s->sh.size[ctb_row - 1]);
     }
 
     while(more_data && ctb_addr_ts < s->sps->ctb_size) {
@@ -2874,6 +2828,7 @@ static int hls_decode_entry_wpp_in_tiles(AVCodecContext *avctxt, int *input_ctb_
 
         s->deblock[ctb_addr_rs].beta_offset = s->sh.beta_offset;
         s->deblock[ctb_addr_rs].tc_offset   = s->sh.tc_offset;
+        s->deblock[ctb_addr_rs].disable     = s->sh.disable_deblocking_filter_flag;
         s->filter_slice_edges[ctb_addr_rs]  = s->sh.slice_loop_filter_across_slices_enabled_flag;
 
         more_data = hls_coding_quadtree(s, x_ctb, y_ctb, s->sps->log2_ctb_size, 0);
@@ -2932,7 +2887,7 @@ static int hls_decode_entry_tiles(AVCodecContext *avctxt, int *input_ctb_row, in
     lc = s->HEVClc;
 
     if(ctb_row) {
-        ret = init_get_bits8(&lc->gb, s->data + s->sh.offset[ctb_row - 1], s->sh.size[ctb_row - 1]);
+        ret = init_get_bits8(&lc->gb, s->sh.data[ctb_row - 1], s->sh.size[ctb_row - 1]);
         if (ret < 0)
             return ret;
     }
@@ -2948,6 +2903,7 @@ static int hls_decode_entry_tiles(AVCodecContext *avctxt, int *input_ctb_row, in
 
         s->deblock[ctb_addr_rs].beta_offset = s->sh.beta_offset;
         s->deblock[ctb_addr_rs].tc_offset   = s->sh.tc_offset;
+        s->deblock[ctb_addr_rs].disable     = s->sh.disable_deblocking_filter_flag;
         s->filter_slice_edges[ctb_addr_rs]  = s->sh.slice_loop_filter_across_slices_enabled_flag;
 
         more_data = hls_coding_quadtree(s, x_ctb, y_ctb, s->sps->log2_ctb_size, 0);
@@ -2961,6 +2917,10 @@ static int hls_decode_entry_tiles(AVCodecContext *avctxt, int *input_ctb_row, in
             if (s->pps->tile_id[ctb_addr_ts] != s->pps->tile_id[ctb_addr_ts-1])
                 break;
     }
+    // the in-loop filters of a tile run on the thread that completes it
+    if (ctb_addr_ts >= s->sps->ctb_size ||
+        s->pps->tile_id[ctb_addr_ts] != s->pps->tile_id[ctb_addr_ts - 1])
+        ff_hevc_hls_filter_tile(s, s->pps->tile_id[ctb_addr_ts - 1]);
     return ctb_addr_ts;
 }
 
@@ -2997,81 +2957,218 @@ static void tiles_filters(HEVCContext *s)
         }
     }
 
+    if (!s->pps->entropy_coding_sync_enabled_flag) {
+        ff_hevc_hls_filter_tile_seams(s);
+        return;
+    }
+
     for (y0 = 0; y0 < s->sps->height; y0 += ctb_size)
         for (x0 = 0; x0 < s->sps->width; x0 += ctb_size)
             ff_hevc_hls_filter(s, x0, y0, ctb_size);
 }
-#if !PARALLEL_FILTERS
 static void slices_filters(HEVCContext *s)
 {
     uint16_t ctb_size        = 1 << s->sps->log2_ctb_size;
-    int x0, y0;
+    int ctb_addr_rs;
+    int x0, y0, x, y;
+
+    // Boundary strengths of the slice seams, skipped while the slices were decoded concurrently
+    if (s->slice_parallel) {
+        for (y0 = 0; y0 < s->sps->height; y0 += ctb_size) {
+            for (x0 = 0; x0 < s->sps->width; x0 += ctb_size) {
+                ctb_addr_rs = (x0 >> s->sps->log2_ctb_size) + (y0 >> s->sps->log2_ctb_size) * s->sps->ctb_width;
+                if (!s->filter_slice_edges[ctb_addr_rs] || s->deblock[ctb_addr_rs].disable)
+                    continue;
+                if (x0 && s->tab_slice_address[ctb_addr_rs] != s->tab_slice_address[ctb_addr_rs - 1])
+                    for (y = y0; y < FFMIN(y0 + ctb_size, s->sps->height); y += 4)
+                        ff_hevc_deblocking_boundary_strengths_v(s, x0, y, 0);
+                if (y0 && s->tab_slice_address[ctb_addr_rs] != s->tab_slice_address[ctb_addr_rs - s->sps->ctb_width])
+                    for (x = x0; x < FFMIN(x0 + ctb_size, s->sps->width); x += 4)
+                        ff_hevc_deblocking_boundary_strengths_h(s, x, y0, 0);
+            }
+        }
+    }
+
     // Deblocking and SAO filters
+    if (s->slice_parallel) {
+        ff_hevc_hls_filter_slice_seams(s);
+        return;
+    }
     for (y0 = 0; y0 < s->sps->height; y0 += ctb_size)
         for (x0 = 0; x0 < s->sps->width; x0 += ctb_size)
             ff_hevc_hls_filter(s, x0, y0, ctb_size);
 }
-#endif
 
 
-static int hls_slice_data(HEVCContext *s, const uint8_t *nal, int length)
+/* Number of emulation prevention bytes removed from the size escaped bytes
+ * starting at offset in the RBSP. skipped_bytes_pos is sorted and strictly
+ * increasing, and the k-th candidate lies inside the shrinking segment iff
+ * pos + k < offset + size, which is monotonic in k. */
+static int count_skipped_bytes(const HEVCContext *s, int offset, int size)
+{
+    const int *pos = s->skipped_bytes_pos;
+    int lo = 0, hi = s->skipped_bytes, first, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (pos[mid] < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    first = lo;
+    hi    = s->skipped_bytes;
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (pos[mid] + (mid - first) < offset + size)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - first;
+}
+
+/* Copy src[start, end) to dst without the emulation prevention bytes found
+ * at pos[*j...], advancing *j past them. Returns the number of bytes written. */
+static int unescape_range(uint8_t *dst, const uint8_t *src, int start, int end,
+                          const int *pos, int nb_pos, int *j)
+{
+    int si = start, di = 0;
+
+    for (; *j < nb_pos && pos[*j] < end; (*j)++) {
+        memcpy(dst + di, src + si, pos[*j] - si);
+        di += pos[*j] - si;
+        si  = pos[*j] + 1;
+    }
+    memcpy(dst + di, src + si, end - si);
+    return di + end - si;
+}
+
+/* Split the slice data of a NAL left escaped by ff_hevc_extract_rbsp()
+ * into its substreams. Those without emulation prevention bytes are decoded
+ * in place and only the others are unescaped into the RBSP buffer, followed
+ * by the few bytes the CABAC reader peeks at past their end. The first one
+ * starts with the slice header just parsed, so that lc->gb can be moved onto
+ * its copy at the same bit position. As the substreams no longer follow each
+ * other, single threaded decoding jumps between them in cabac_reinit(). */
+static int unescape_slice_data(HEVCContext *s, HEVCNAL *nal)
+{
+    GetBitContext *gb = &s->HEVClc->gb;
+    const int *pos    = s->skipped_bytes_pos;
+    int header_bits   = get_bits_count(gb);
+    int start = 0, end = header_bits >> 3;
+    int i, j = 0, k, di = 0;
+    uint8_t *dst;
+
+    if (pos[0] <= end) {
+        av_log(s->avctx, AV_LOG_ERROR,
+               "Emulation prevention byte inside the slice header.\n");
+        return AVERROR_INVALIDDATA;
+    }
+
+    av_fast_malloc(&nal->rbsp_buffer, &nal->rbsp_buffer_size,
+                   nal->size + 8 * FFMIN(s->skipped_bytes, s->sh.num_entry_point_offsets + 1) +
+                   FF_INPUT_BUFFER_PADDING_SIZE);
+    if (!nal->rbsp_buffer)
+        return AVERROR(ENOMEM);
+    dst = nal->rbsp_buffer;
+
+    for (i = 0; i <= s->sh.num_entry_point_offsets; i++) {
+        const uint8_t *data = nal->data + start;
+        int size;
+
+        end = i < s->sh.num_entry_point_offsets ?
+              end + s->sh.entry_point_offset[i] : nal->size;
+        if (end > nal->size) {
+            av_log(s->avctx, AV_LOG_ERROR,
+                   "hls_slice_data:  packet length < image size : %d < %d\n",
+                   nal->size, end);
+            return AVERROR_INVALIDDATA;
+        }
+
+        if (j < s->skipped_bytes && pos[j] < end) {
+            data = dst + di;
+            size = unescape_range(dst + di, nal->data, start, end,
+                                  pos, s->skipped_bytes, &j);
+            k    = j;
+            di  += size;
+            di  += unescape_range(dst + di, nal->data, end, FFMIN(end + 8, nal->size),
+                                  pos, s->skipped_bytes, &k);
+        } else
+            size = end - start;
+
+        if (!i) {
+            if (data != nal->data) {
+                int ret = init_get_bits8(gb, data, size);
+                if (ret < 0)
+                    return ret;
+                skip_bits_long(gb, header_bits);
+            }
+        } else {
+            s->sh.data[i - 1] = data;
+            s->sh.size[i - 1] = size;
+        }
+        start = end;
+    }
+    memset(dst + di, 0, FF_INPUT_BUFFER_PADDING_SIZE);
+
+    return 0;
+}
+
+static int hls_slice_data(HEVCContext *s, const HEVCNAL *nal)
 {
     HEVCLocalContext *lc = s->HEVClc;
     int *ret = av_malloc((s->sh.num_entry_point_offsets + 1) * sizeof(int));
     int *arg = av_malloc((s->sh.num_entry_point_offsets + 1) * sizeof(int));
     int offset;
-    int startheader, cmpt = 0;
-    int i, j, res = 0;
+    int cmpt = 0;
+    int i, res = 0;
+    size_t copy_size;
 
     ff_alloc_entries(s->avctx, s->sh.num_entry_point_offsets + 1);
 
-    if (s->sh.num_entry_point_offsets > 0) {
+    if (s->sh.num_entry_point_offsets > 0 && !nal->escaped) {
         offset = (lc->gb.index >> 3);
-        for (j = 0, cmpt = 0, startheader = offset + s->sh.entry_point_offset[0]; j < s->skipped_bytes; j++) {
-            if (s->skipped_bytes_pos[j] >= offset && s->skipped_bytes_pos[j] < startheader) {
-                startheader--;
-                cmpt++;
-            }
-        }
+        cmpt   = count_skipped_bytes(s, offset, s->sh.entry_point_offset[0]);
 
         for (i = 1; i < s->sh.num_entry_point_offsets; i++) {
             offset += (s->sh.entry_point_offset[i - 1] - cmpt);
-            for (j = 0, cmpt = 0, startheader = offset
-                    + s->sh.entry_point_offset[i]; j < s->skipped_bytes; j++) {
-                if (s->skipped_bytes_pos[j] >= offset && s->skipped_bytes_pos[j] < startheader) {
-                    startheader--;
-                    cmpt++;
-                }
-            }
+            cmpt    = count_skipped_bytes(s, offset, s->sh.entry_point_offset[i]);
             s->sh.size[i - 1] = s->sh.entry_point_offset[i] - cmpt;
-            s->sh.offset[i - 1] = offset;
+            s->sh.data[i - 1] = nal->data + offset;
         }
         offset += s->sh.entry_point_offset[s->sh.num_entry_point_offsets - 1] - cmpt;
-        s->sh.size[s->sh.num_entry_point_offsets - 1] = length - offset;
-        s->sh.offset[s->sh.num_entry_point_offsets - 1] = offset;
+        s->sh.size[s->sh.num_entry_point_offsets - 1] = nal->size - offset;
+        s->sh.data[s->sh.num_entry_point_offsets - 1] = nal->data + offset;
 
-        if(s->sh.offset[i - 1]+s->sh.size[i - 1] > length) {
+        if(offset + s->sh.size[i - 1] > nal->size) {
             av_log(s->avctx, AV_LOG_ERROR,
                    "hls_slice_data:  packet length < image size : %d < %d\n",
-                   length, s->sh.offset[i - 1]+s->sh.size[i - 1]);
+                   nal->size, offset + s->sh.size[i - 1]);
             return AVERROR_INVALIDDATA;
         }
-
+    }
+    if (s->sh.num_entry_point_offsets > 0) {
         avpriv_atomic_int_set(&s->wpp_err, 0);
         ff_reset_entries(s->avctx);
     }
-    s->data = nal;
     if (s->sh.first_slice_in_pic_flag){
         s->HEVClc->ctb_tile_rs = 0;
+        s->ctx_copy_bytes = 0;
     }
+    /* Only the per-slice part of the context is refreshed; the DSP
+     * contexts follow once per picture and the DPB is never copied. */
+    copy_size = s->sh.first_slice_in_pic_flag ? offsetof(HEVCContext, vps_list) :
+                                                offsetof(HEVCContext, hpc);
     for (i = 1; i < s->threads_number; i++) {
         if (s->sh.first_slice_in_pic_flag){
             s->sList[i]->HEVClc->ctb_tile_rs = 0;
         }
         s->sList[i]->HEVClc->first_qp_group = 1;
         s->sList[i]->HEVClc->qp_y = s->sList[0]->HEVClc->qp_y;
-        memcpy(s->sList[i], s, sizeof(HEVCContext));
+        memcpy(s->sList[i], s, copy_size);
         s->sList[i]->HEVClc = s->HEVClcList[i];
+        s->ctx_copy_bytes += copy_size;
     }
 
     for (i = 0; i <= s->sh.num_entry_point_offsets; i++) {
@@ -3095,6 +3192,76 @@ static int hls_slice_data(HEVCContext *s, const uint8_t *nal, int length)
     return res;
 }
 
+/**
+ * Decode the slices waiting in sList[1..] concurrently, together with the
+ * slice just parsed into s when with_current is set. Each slice filters the
+ * CTB rows it covers entirely; the seams between slices are filtered once
+ * the last CTB of the picture has been decoded.
+ * @return the first error of the batch, 0 otherwise
+ */
+static int decode_queued_slices(HEVCContext *s, int with_current)
+{
+    int arg[MAX_NB_THREADS], ret[MAX_NB_THREADS];
+    int i, nb_jobs = 0, res = 0, ctb_addr_ts = 0;
+
+    if (with_current)
+        arg[nb_jobs++] = 0;
+    for (i = 1; i <= s->nb_queued_slices; i++)
+        arg[nb_jobs++] = i;
+    s->nb_queued_slices = 0;
+    if (!nb_jobs)
+        return 0;
+
+    s->avctx->execute2(s->avctx, (void *) hls_decode_entry_slice, arg, ret, nb_jobs);
+
+    for (i = 0; i < nb_jobs; i++) {
+        if (ret[i] < 0 && !res)
+            res = ret[i];
+        ctb_addr_ts = FFMAX(ctb_addr_ts, ret[i]);
+    }
+    if (ctb_addr_ts >= s->sps->ctb_width * s->sps->ctb_height) {
+        s->is_decoded = 1;
+        slices_filters(s);
+    }
+    return res;
+}
+
+/**
+ * Park the slice just parsed into s in the next free sList[] entry, or run
+ * the batch when all the slice threads have one.
+ */
+static int queue_slice(HEVCContext *s)
+{
+    HEVCLocalContext *lc;
+    HEVCContext *s1;
+    int i;
+
+    if (s->sh.first_slice_in_pic_flag) {
+        s->ctx_copy_bytes = 0;
+        for (i = 1; i < s->threads_number; i++) {
+            memcpy(&s->sList[i]->hpc, &s->hpc,
+                   offsetof(HEVCContext, vps_list) - offsetof(HEVCContext, hpc));
+            s->ctx_copy_bytes += offsetof(HEVCContext, vps_list) - offsetof(HEVCContext, hpc);
+        }
+    }
+
+    if (s->nb_queued_slices == s->threads_number - 1)
+        return decode_queued_slices(s, 1);
+
+    s1 = s->sList[++s->nb_queued_slices];
+    memcpy(s1, s, offsetof(HEVCContext, hpc));
+    s1->HEVClc = s->HEVClcList[s->nb_queued_slices];
+    s->ctx_copy_bytes += offsetof(HEVCContext, hpc);
+
+    lc                     = s1->HEVClc;
+    lc->gb                 = s->HEVClc->gb;
+    lc->first_qp_group     = s->HEVClc->first_qp_group;
+    lc->qp_y               = s->HEVClc->qp_y;
+    lc->tu.cu_qp_offset_cb = 0;
+    lc->tu.cu_qp_offset_cr = 0;
+    return 0;
+}
+
 
 
 
@@ -3197,20 +3364,13 @@ fail:
 static int hevc_frame_start(HEVCContext *s)
 {
     HEVCLocalContext *lc = s->HEVClc;
-    int pic_size_in_ctb  = ((s->sps->width  >> s->sps->log2_min_cb_size) + 1) *
-                           ((s->sps->height >> s->sps->log2_min_cb_size) + 1);
+    int ctb_count        = s->sps->ctb_width * s->sps->ctb_height;
     int ret = 0;
     AVFrame *cur_frame;
     av_log(s->avctx, AV_LOG_DEBUG, "frame start %d\n", s->decoder_id);
 
 
-    memset(s->horizontal_bs, 0, s->bs_width * s->bs_height);
-    memset(s->vertical_bs,   0, s->bs_width * s->bs_height);
-    memset(s->cbf_luma,      0, s->sps->min_tb_width * s->sps->min_tb_height);
-    memset(s->tab_slice_address, -1, pic_size_in_ctb * sizeof(*s->tab_slice_address));
-#if PARALLEL_SLICE
-    memset(s->decoded_rows, 0,s->sps->ctb_height);
-#endif
+    memset(s->tab_slice_address, -1, ctb_count * sizeof(*s->tab_slice_address));
     s->is_decoded        = 0;
     s->first_nal_type    = s->nal_unit_type;
 
@@ -3238,7 +3398,8 @@ static int hevc_frame_start(HEVCContext *s)
         if (ret < 0)
             goto fail;
 #if !ACTIVE_PU_UPSAMPLING || ACTIVE_BOTH_FRAME_AND_PU
-        s->hevcdsp.upsample_base_layer_frame(s->EL_frame, s->BL_frame->frame, s->buffer_frame, &s->sps->scaled_ref_layer_window[s->vps->m_refLayerId[s->nuh_layer_id][0]], &s->up_filter_inf, 1);
+        if (s->EL_frame->buf[0] != s->BL_frame->frame->buf[0])
+            s->hevcdsp.upsample_base_layer_frame(s->EL_frame, s->BL_frame->frame, s->buffer_frame, &s->sps->scaled_ref_layer_window[s->vps->m_refLayerId[s->nuh_layer_id][0]], &s->up_filter_inf, 1);
 #endif
     }
 #endif
@@ -3285,13 +3446,13 @@ fail:
     return ret;
 }
 
-static int decode_nal_unit(HEVCContext *s, const uint8_t *nal, int length)
+static int decode_nal_unit(HEVCContext *s, HEVCNAL *nal)
 {
     HEVCLocalContext *lc = s->HEVClc;
     GetBitContext *gb    = &lc->gb;
     int ctb_addr_ts, ret;
 
-    ret = init_get_bits8(gb, nal, length);
+    ret = init_get_bits8(gb, nal->data, nal->size);
     if (ret < 0)
         return ret;
 
@@ -3303,12 +3464,21 @@ static int decode_nal_unit(HEVCContext *s, const uint8_t *nal, int length)
     } else if (ret != (s->decoder_id) && (s->nal_unit_type != NAL_VPS && (s->nal_unit_type != NAL_SPS) /*&& s->nal_unit_type != NAL_PPS*/))
         return 0;
 
-    if ((s->temporal_id > s->temporal_layer_id) || (ret > s->quality_layer_id))
+    if ((s->temporal_id > s->temporal_layer_id) || (ret > s->quality_layer_id) ||
+        ret >= MAX_LAYERS)
         return 0;
     s->nuh_layer_id = ret;
     
     s->nuh_layer_id = ret;
 
+    // the queued slices must be decoded before the parameter sets or the picture change
+    if (s->nb_queued_slices &&
+        (s->nal_unit_type > NAL_CRA_NUT || show_bits1(gb))) {
+        ret = decode_queued_slices(s, 0);
+        if (ret < 0 && (s->avctx->err_recognition & AV_EF_EXPLODE))
+            return ret;
+    }
+
     switch (s->nal_unit_type) {
     case NAL_VPS:
         ret = ff_hevc_decode_nal_vps(s);
@@ -3401,6 +3571,12 @@ static int decode_nal_unit(HEVCContext *s, const uint8_t *nal, int length)
             ret = hevc_frame_start(s);
             if (ret < 0)
                 return ret;
+            s->slice_parallel = (s->threads_type & FF_THREAD_SLICE_PARALLEL) &&
+                                s->threads_number > 1 && s->nb_slice_nals > 1 &&
+                                !s->nuh_layer_id &&
+                                !s->pps->tiles_enabled_flag &&
+                                !s->pps->entropy_coding_sync_enabled_flag &&
+                                !s->pps->dependent_slice_segments_enabled_flag;
         } else if (!s->ref) {
             av_log(s->avctx, AV_LOG_ERROR, "First slice in a frame missing.\n");
             goto fail;
@@ -3441,7 +3617,19 @@ static int decode_nal_unit(HEVCContext *s, const uint8_t *nal, int length)
                     av_log(s->avctx, AV_LOG_ERROR, "Error allocating frame, Addditional DPB full, decoder_%d.\n", s->decoder_id);
             }
 #endif
-        ctb_addr_ts = hls_slice_data(s, nal, length);
+        s->sh.data_split = nal->escaped;
+        if (nal->escaped) {
+            ret = unescape_slice_data(s, nal);
+            if (ret < 0)
+                goto fail;
+        }
+        if (s->slice_parallel) {
+            ret = queue_slice(s);
+            if (ret < 0)
+                goto fail;
+            break;
+        }
+        ctb_addr_ts = hls_slice_data(s, nal);
 
         if (ctb_addr_ts >= (s->sps->ctb_width * s->sps->ctb_height)) {
             s->is_decoded = 1;
@@ -3499,279 +3687,53 @@ fail:
     return 0;
 }
 
-#if PARALLEL_SLICE
-static int decode_nal_unit_slice(AVCodecContext *avctxt, void *input_ctb_row, int job, int self_id) {
-    HEVCContext *s1      = avctxt->priv_data;
-    HEVCContext *s       = s1->sList[self_id];
-    HEVCLocalContext *lc = s->HEVClc;
-    GetBitContext *gb    = &lc->gb;
-    s->avctx = avctxt;
-    int i; 
-    int *nal_id          = input_ctb_row;
-
-    const uint8_t *nal   = s1->nals[nal_id[job]].data;
-    int length           = s1->nals[nal_id[job]].size;
-    int ctb_addr_ts, ret;
-    
-
-    ret = init_get_bits8(gb, nal, length);
-    if (ret < 0)
-        return ret;
-
-    ret = hls_nal_unit(s);
-
-    av_log(s->avctx, AV_LOG_DEBUG,
-           "decode IRAP in parallel #%d.\n", s->nal_unit_type);
-    if (ret < 0) {
-        av_log(s->avctx, AV_LOG_ERROR, "Invalid NAL unit %d, skipping.\n",
-               s->nal_unit_type);
-        goto fail;
-    } else if (ret != (s->decoder_id) && (s->nal_unit_type != NAL_VPS && (s->nal_unit_type != NAL_SPS) /*&& s->nal_unit_type != NAL_PPS*/))
-        return 0;
-
-    if ((s->temporal_id > s->temporal_layer_id) || (ret > s->quality_layer_id))
-        return 0;
-    s->nuh_layer_id          = ret;
-    s->avctx->layers_size   += length;
-    s->self_id               = self_id;
-    s->job                   = job;
-
-
-    switch (s->nal_unit_type) {
-        case NAL_VPS:
-            ret = ff_hevc_decode_nal_vps(s);
-            if (ret < 0)
-                goto fail;
-            break;
-        case NAL_SPS:
-            ret = ff_hevc_decode_nal_sps(s);
-            if (ret < 0)
-                goto fail;
-            break;
-        case NAL_PPS:
-            ret = ff_hevc_decode_nal_pps(s);
-            if (ret < 0)
-                goto fail;
-            break;
-        case NAL_SEI_PREFIX:
-        case NAL_SEI_SUFFIX:
-            ret = ff_hevc_decode_nal_sei(s);
-            if (ret < 0)
-                goto fail;
-            break;
-        case NAL_TRAIL_R:
-        case NAL_TRAIL_N:
-        case NAL_TSA_N:
-        case NAL_TSA_R:
-        case NAL_STSA_N:
-        case NAL_STSA_R:
-        case NAL_BLA_W_LP:
-        case NAL_BLA_W_RADL:
-        case NAL_BLA_N_LP:
-        case NAL_IDR_W_RADL:
-        case NAL_IDR_N_LP:
-        case NAL_CRA_NUT:
-        case NAL_RADL_N:
-        case NAL_RADL_R:
-        case NAL_RASL_N:
-        case NAL_RASL_R:
-            ret = hls_slice_header(s);
-            
-            if (ret < 0)
-                return ret;
-
-            if (s->max_ra == INT_MAX) {
-                if (s->nal_unit_type == NAL_CRA_NUT || IS_BLA(s)) {
-                    s->max_ra = s->poc;
-                    av_log(s->avctx, AV_LOG_WARNING,
-                           "max_ra equal to s->max_ra %d \n", s->max_ra);
-                } else {
-                    if (IS_IDR(s))
-                        s->max_ra = INT_MIN;
-                    else if( s->decoder_id ) {
-                        av_log(s->avctx, AV_LOG_WARNING,
-                               "Nal type %d s->max_ra %d \n", s->nal_unit_type,  s->max_ra);
-                        break;
-                    }
-                }
-            }
-
-            if ((s->nal_unit_type == NAL_RASL_R || s->nal_unit_type == NAL_RASL_N) &&
-                s->poc <= s->max_ra) {
-                s->is_decoded = 0;
-                return 0;
-            } else {
-                if (s->nal_unit_type == NAL_RASL_R && s->poc > s->max_ra)
-                    s->max_ra = INT_MIN;
-            }
-            
-            if (s->sh.first_slice_in_pic_flag) {
-                ret = hevc_frame_start(s);
-                ff_thread_report_progress_slice(s->avctx);
-                if (ret < 0)
-                    return ret;
-
-            } else if (!s->ref) {
-                av_log(s->avctx, AV_LOG_ERROR, "First slice in a frame missing.\n");
-                goto fail;
-            }
-
-            if (s->nal_unit_type != s->first_nal_type) {
-                av_log(s->avctx, AV_LOG_ERROR,
-                       "Non-matching NAL types of the VCL NALUs: %d %d\n",
-                       s->first_nal_type, s->nal_unit_type);
-                goto fail;
-            }
-            
-            if (!s->sh.dependent_slice_segment_flag &&
-                s->sh.slice_type != I_SLICE) {
-                
-                ret = ff_hevc_slice_rpl(s);
-                if (ret < 0) {
-                    av_log(s->avctx, AV_LOG_WARNING,
-                           "Error constructing the reference lists for the current slice.\n");
-                    goto fail;
-                }
-            } 
-              
-#if ACTIVE_PU_UPSAMPLING
-            if (s->bl_decoder_el_exist) {
-                int i;
-                s->bl_decoder_el_exist = 0;
-                for (i = 0; i < FF_ARRAY_ELEMS(s->Add_ref); i++) {
-                    HEVCFrame *frame = &s->Add_ref[i];
-                    if (frame->frame->buf[0])
-                        continue;
-                    ret = hevc_ref_frame(s, &s->Add_ref[i], s->ref);
-                    if (ret < 0)
-                        return ret;
-                    ff_thread_report_il_progress(s->avctx, s->poc_id, &s->Add_ref[i], s->ref);
-                    break;
-                }
-                if(i==FF_ARRAY_ELEMS(s->Add_ref))
-                    av_log(s->avctx, AV_LOG_ERROR, "Error allocating frame, Addditional DPB full, decoder_%d.\n", s->decoder_id);
-            }
-#endif
-            if(s->job != s1->max_slices) {
-                ff_thread_await_progress_slice2(s->avctx, s->job);
-                for(i=s1->slice_segment_addr[s->job]; i < s1->slice_segment_addr[s->job+1]; i++)
-                    s->tab_slice_address[i] = s1->slice_segment_addr[s->job];
-            } else {
-                for(i = s1->slice_segment_addr[s->job]; i < s->sps->ctb_height*s->sps->ctb_width; i++)
-                    s->tab_slice_address[i] = s1->slice_segment_addr[s->job];
-            }
-            ctb_addr_ts = hls_decode_entry_slice(s);
-
+static int add_skipped_byte(HEVCContext *s, int pos)
+{
+    if (s->skipped_bytes_pos_size <= s->skipped_bytes) {
+        s->skipped_bytes_pos_size *= 2;
+        if (av_reallocp_array(&s->skipped_bytes_pos,
+                              s->skipped_bytes_pos_size,
+                              sizeof(*s->skipped_bytes_pos)) < 0)
+            return AVERROR(ENOMEM);
+    }
+    if (s->skipped_bytes_pos)
+        s->skipped_bytes_pos[s->skipped_bytes] = pos;
+    s->skipped_bytes++;
+    return 0;
+}
 
-            if (ctb_addr_ts >= (s->sps->ctb_width * s->sps->ctb_height)) {
-                for(int i= 0; i < s->threads_number ; i++)
-                    s->sList[i]->is_decoded = 1;
-                if (s->pps->tiles_enabled_flag && s->threads_number!=1)
-                    tiles_filters(s);
-#ifdef SVC_EXTENSION
-#if !ACTIVE_PU_UPSAMPLING
-                if (s->active_el_frame) {
-                    int i;
-                    s->active_el_frame = 0;
-                    for (i = 0; i < FF_ARRAY_ELEMS(s->Add_ref); i++) {
-                        HEVCFrame *frame = &s->Add_ref[i];
-                        if (frame->frame->buf[0])
-                            continue;
-                        ret = hevc_ref_frame(s, &s->Add_ref[i], s->ref);
-                        if (ret < 0)
-                            return ret;
-                        ff_thread_report_il_progress(s->avctx, s->poc_id, &s->Add_ref[i], s->ref);
-                        break;
-                    }
-                    if(i==FF_ARRAY_ELEMS(s->Add_ref))
-                        av_log(s->avctx, AV_LOG_ERROR, "Error allocating frame, Addditional DPB full, decoder_%d.\n", s->decoder_id);
-                }
-#endif
-#endif
+/* Upper bound on the size of a conforming slice segment header under any
+ * of the known SPSs: a few hundred syntax elements of at most 64 bits, the
+ * extension bytes and one 32-bit entry point offset per CTB. */
+static int slice_header_bound(const HEVCContext *s)
+{
+    int i, ctbs = -1;
 
-#ifdef SVC_EXTENSION
-                if(s->decoder_id > 0)
-                    ff_hevc_unref_frame(s, s->inter_layer_ref, ~0);
-#endif
-            }
-            
-            if (ctb_addr_ts < 0) {
-                ret = ctb_addr_ts;
-                goto fail;
-            }
-            break;
-        case NAL_EOS_NUT:
-        case NAL_EOB_NUT:
-            s->seq_decode = (s->seq_decode + 1) & 0xff;
-            s->max_ra     = INT_MAX;
-            break;
-        case NAL_AUD:
-        case NAL_FD_NUT:
-            break;
-        default:
-            av_log(s->avctx, AV_LOG_INFO,
-                   "Skipping NAL unit %d\n", s->nal_unit_type);
+    for (i = 0; i < MAX_SPS_COUNT; i++) {
+        const HEVCSPS *sps;
+        if (!s->sps_list[i])
+            continue;
+        sps  = (const HEVCSPS *)s->sps_list[i]->data;
+        ctbs = FFMAX(ctbs, sps->ctb_width * sps->ctb_height);
     }
-    return 0;
-fail:
-    if (s->avctx->err_recognition & AV_EF_EXPLODE)
-        return ret;
-    return 0;
+    return ctbs < 0 ? INT_MAX : 8192 + 4 * ctbs;
 }
-#endif
+
 /* FIXME: This is adapted from ff_h264_decode_nal, avoiding duplication
  * between these functions would be nice. */
 int ff_hevc_extract_rbsp(HEVCContext *s, const uint8_t *src, int length,
                          HEVCNAL *nal)
 {
-    int i, si, di;
+    int i, si, di, ret;
     uint8_t *dst;
 
     s->skipped_bytes = 0;
-#define STARTCODE_TEST                                                  \
-        if (i + 2 < length && src[i + 1] == 0 && src[i + 2] <= 3) {     \
-            if (src[i + 2] != 3) {                                      \
-                /* startcode, so we must be past the end */             \
-                length = i;                                             \
-            }                                                           \
-            break;                                                      \
-        }
-#if HAVE_FAST_UNALIGNED
-#define FIND_FIRST_ZERO                                                 \
-        if (i > 0 && !src[i])                                           \
-            i--;                                                        \
-        while (src[i])                                                  \
-            i++
-#if HAVE_FAST_64BIT
-    for (i = 0; i + 1 < length; i += 9) {
-        if (!((~AV_RN64A(src + i) &
-               (AV_RN64A(src + i) - 0x0100010001000101ULL)) &
-              0x8000800080008080ULL))
-            continue;
-        FIND_FIRST_ZERO;
-        STARTCODE_TEST;
-        i -= 7;
-    }
-#else
-    for (i = 0; i + 1 < length; i += 5) {
-        if (!((~AV_RN32A(src + i) &
-               (AV_RN32A(src + i) - 0x01000101U)) &
-              0x80008080U))
-            continue;
-        FIND_FIRST_ZERO;
-        STARTCODE_TEST;
-        i -= 3;
+    nal->escaped     = 0;
+    i = av_hevc_find_nal_marker(src, length);
+    if (i + 2 < length && src[i + 2] != 3) {
+        /* startcode, so we must be past the end */
+        length = i;
     }
-#endif /* HAVE_FAST_64BIT */
-#else
-    for (i = 0; i + 1 < length; i += 2) {
-        if (src[i])
-            continue;
-        if (i > 0 && src[i - 1] == 0)
-            i--;
-        STARTCODE_TEST;
-    }
-#endif /* HAVE_FAST_UNALIGNED */
 
     if (i >= length - 1) { // no escaped 0
         nal->data = src;
@@ -3779,6 +3741,26 @@ int ff_hevc_extract_rbsp(HEVCContext *s, const uint8_t *src, int length,
         return length;
     }
 
+    /* Slice data is not copied when the header cannot reach the first
+     * escape: unescape_slice_data() then only unescapes the substreams
+     * that need it, using the escaped positions of the 0x03 bytes. */
+    if (((src[0] >> 1) & 0x3f) <= NAL_CRA_NUT && s->skipped_bytes_pos &&
+        i >= slice_header_bound(s)) {
+        while (i + 2 < length && src[i + 2] == 3) {
+            if ((ret = add_skipped_byte(s, i + 2)) < 0)
+                return ret;
+            i += 3;
+            i += av_hevc_find_nal_marker(src + i, length - i);
+        }
+        if (i + 2 < length) // next start code
+            length = i;
+
+        nal->data    = src;
+        nal->size    = length;
+        nal->escaped = 1;
+        return length;
+    }
+
     av_fast_malloc(&nal->rbsp_buffer, &nal->rbsp_buffer_size,
                    length + FF_INPUT_BUFFER_PADDING_SIZE);
     if (!nal->rbsp_buffer)
@@ -3788,39 +3770,25 @@ int ff_hevc_extract_rbsp(HEVCContext *s, const uint8_t *src, int length,
 
     memcpy(dst, src, i);
     si = di = i;
+    /* i is on a 00 00 0x marker; copy the runs between markers in bulk and
+     * append the RBSP position of every removed 0x03 to skipped_bytes_pos,
+     * which therefore stays sorted. */
     while (si + 2 < length) {
-        // remove escapes (very rare 1:2^22)
-        if (src[si + 2] > 3) {
-            dst[di++] = src[si++];
-            dst[di++] = src[si++];
-        } else if (src[si] == 0 && src[si + 1] == 0) {
-            if (src[si + 2] == 3) { // escape
-                dst[di++] = 0;
-                dst[di++] = 0;
-                si       += 3;
-
-                s->skipped_bytes++;
-                if (s->skipped_bytes_pos_size < s->skipped_bytes) {
-                    s->skipped_bytes_pos_size *= 2;
-                    av_reallocp_array(&s->skipped_bytes_pos,
-                            s->skipped_bytes_pos_size,
-                            sizeof(*s->skipped_bytes_pos));
-                    if (!s->skipped_bytes_pos)
-                        return AVERROR(ENOMEM);
-                }
-                if (s->skipped_bytes_pos)
-                    s->skipped_bytes_pos[s->skipped_bytes-1] = di - 1;
-                continue;
-            } else // next start code
-                goto nsc;
-        }
+        if (src[si + 2] != 3) // next start code
+            break;
+        dst[di++] = 0;
+        dst[di++] = 0;
+        si       += 3;
+
+        if ((ret = add_skipped_byte(s, di - 1)) < 0)
+            return ret;
 
-        dst[di++] = src[si++];
+        i = si + av_hevc_find_nal_marker(src + si, length - si);
+        memcpy(dst + di, src + si, i - si);
+        di += i - si;
+        si  = i;
     }
-    while (si < length)
-        dst[di++] = src[si++];
 
-nsc:
     memset(dst + di, 0, FF_INPUT_BUFFER_PADDING_SIZE);
 
     nal->data = dst;
@@ -3831,12 +3799,7 @@ nsc:
 static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
 {
     int i,  consumed, ret = 0;
-    
-#if PARALLEL_SLICE
-    int cum_nal_pos = 0, k, nal_type, prv_nal_type=-1;
-    int arg[128];
-    int is_irap = 1;
-#endif
+
     s->ref = NULL;
     s->au_poc = -1;
     s->last_eos = s->eos;
@@ -3844,14 +3807,10 @@ static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
     s->bl_decoder_el_exist  = 0;
     s->el_decoder_el_exist  = 0;
     s->el_decoder_bl_exist  = 0;
-#if PARALLEL_SLICE
-    s->NbListElement        = 0;
-    for(i = 0; i < 16; i++)
-        s->NALListOrder[i]  = 0;
-#endif
     /* split the input packet into NAL units, so we know the upper bound on the
      * number of slices in the frame */
     s->nb_nals = 0;
+    s->nb_slice_nals = 0;
     while (length >= 4) {
         HEVCNAL *nal;
         int extract_length = 0;
@@ -3924,23 +3883,8 @@ static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
         if (ret < 0)
             goto fail;
         ret = hls_nal_unit(s);
-
-#if PARALLEL_SLICE
-        /*   Find out the set of slices to run in parallel   */
-        nal_type = s->nal_unit_type > NAL_CRA_NUT;
-        if (!nal_type)
-            is_irap &= IS_IRAP(s);
-
-        if(prv_nal_type==-1)
-            s->NALListOrder[0]++;
-        else {
-            if(nal_type || (!nal_type && nal_type != prv_nal_type))
-                s->NbListElement++;
-            s->NALListOrder[s->NbListElement]++;
-        }
-
-        prv_nal_type = nal_type;
-#endif
+        if (ret == s->decoder_id && s->nal_unit_type <= NAL_CRA_NUT)
+            s->nb_slice_nals++;
 
         if(!s->bl_decoder_el_exist && ret == s->decoder_id+1 && s->avctx->quality_id >= ret && s->nal_unit_type <= NAL_CRA_NUT && (s->threads_type&FF_THREAD_FRAME)) {
             s->bl_decoder_el_exist = 1;
@@ -3967,62 +3911,24 @@ static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
     if(!s->el_decoder_bl_exist) {
         s->el_decoder_el_exist = 0;
     }
-#if PARALLEL_SLICE
-    if (is_irap) {
-        for(i = 0; i <= s->NbListElement; i++) {
-            //      s->skipped_bytes = s->skipped_bytes_nal[i];
-            //      s->skipped_bytes_pos = s->skipped_bytes_pos_nal[i];
-            s->max_slices = s->NALListOrder[i]-1;
-            for(k=0; k < s->NALListOrder[i]; k++)
-                arg[k] = cum_nal_pos+k;
-            s->avctx->execute2(s->avctx, (void *) decode_nal_unit_slice, arg, ret, s->NALListOrder[i]);
-            cum_nal_pos += s->NALListOrder[i];
-
-            if (ret < 0) {
-                av_log(s->avctx, AV_LOG_WARNING,
-                       "Error parsing NAL unit #%d.\n", i);
-                goto fail;
-            }
-        }
-    } else {
-        for (i = 0; i < s->nb_nals; i++) {
-            int ret;
-            s->skipped_bytes = s->skipped_bytes_nal[i];
-            s->skipped_bytes_pos = s->skipped_bytes_pos_nal[i];
-
-            ret = decode_nal_unit(s, s->nals[i].data, s->nals[i].size);
-            if (ret < 0) {
-                av_log(s->avctx, AV_LOG_WARNING,
-                       "Error parsing NAL unit #%d.\n", i);
-                goto fail;
-            }
-        }
-
-    }
-#if !PARALLEL_FILTERS
-    if(s->is_decoded)
-        slices_filters(s);
-#endif
-
-#else
     for (i = 0; i < s->nb_nals; i++) {
         int ret;
         s->skipped_bytes = s->skipped_bytes_nal[i];
         s->skipped_bytes_pos = s->skipped_bytes_pos_nal[i];
 
-        ret = decode_nal_unit(s, s->nals[i].data, s->nals[i].size);
+        ret = decode_nal_unit(s, &s->nals[i]);
         if (ret < 0) {
             av_log(s->avctx, AV_LOG_WARNING,
                    "Error parsing NAL unit #%d.\n", i);
             goto fail;
         }
     }
-#endif
 fail:
-#if PARALLEL_SLICE
-    ff_thread_report_progress_slice(s->avctx);
-    ff_thread_report_progress_slice2(s->avctx, s->job);
-#endif
+    if (s->nb_queued_slices) {
+        int err = decode_queued_slices(s, 0);
+        if (err < 0 && ret >= 0 && (s->avctx->err_recognition & AV_EF_EXPLODE))
+            ret = err;
+    }
     if (s->ref && (s->threads_type & FF_THREAD_FRAME))
         ff_thread_report_progress(&s->ref->tf, INT_MAX, 0);
     if (s->decoder_id) {
@@ -4126,10 +4032,6 @@ static int hevc_decode_frame(AVCodecContext *avctx, void *data, int *got_output,
         return 0;
     }
     s->ref = NULL;
-#if PARALLEL_SLICE
-    ff_thread_set_slice_flag(avctx, 0);
-    ff_init_flags(avctx);
-#endif
 
 	if (avpkt->pts != AV_NOPTS_VALUE) {
 		if (! s->last_frame_pts || (s->last_frame_pts!=avpkt->pts)) {
@@ -4225,7 +4127,7 @@ static av_cold int hevc_decode_free(AVCodecContext *avctx)
         av_buffer_unref(&s->pps_list[i]);
 
     av_freep(&s->sh.entry_point_offset); // TODO Free for each slice
-    av_freep(&s->sh.offset);
+    av_freep(&s->sh.data);
     av_freep(&s->sh.size);
 
     for (i = 1; i < s->threads_number; i++) {
@@ -4397,6 +4299,9 @@ static int hevc_update_thread_context(AVCodecContext *dst,
     s->quality_layer_id     = s0->quality_layer_id;
     s->decode_checksum_sei  = s0->decode_checksum_sei;
     s->poc_id               = s0->poc_id;
+    s->bounded_dpb          = s0->bounded_dpb;
+    s->dpb_frames           = s0->dpb_frames;
+    s->shared_pools         = s0->shared_pools;
 
     if (s->sps != s0->sps)
         ret = set_sps(s, s0->sps);
@@ -4478,6 +4383,7 @@ static av_cold int hevc_decode_init(AVCodecContext *avctx)
     int ret;
 
     ff_init_cabac_states();
+    ff_hevc_init_sig_ctx();
 
     avctx->internal->allocate_progress = 1;
 
@@ -4502,9 +4408,12 @@ static av_cold int hevc_decode_init(AVCodecContext *avctx)
 static av_cold int hevc_init_thread_copy(AVCodecContext *avctx)
 {
     HEVCContext *s = avctx->priv_data;
+    const AVClass *class = s->c;
     int ret;
 
+    /* the options of a thread copy are still read with av_opt_get() */
     memset(s, 0, sizeof(*s));
+    s->c = class;
 
     ret = hevc_init_context(avctx);
     if (ret < 0)
@@ -4513,6 +4422,39 @@ static av_cold int hevc_init_thread_copy(AVCodecContext *avctx)
     return 0;
 }
 
+int av_hevc_get_layers(AVCodecContext *avctx, AVHEVCLayers *layers)
+{
+    HEVCContext *s = avctx->priv_data;
+    const HEVCVPS *vps = NULL;
+    const HEVCSPS *sps = NULL;
+    int i;
+
+    for (i = 0; i < MAX_VPS_COUNT && !vps; i++)
+        if (s->vps_list[i])
+            vps = (const HEVCVPS *)s->vps_list[i]->data;
+    if (!vps)
+        return AVERROR_INVALIDDATA;
+    for (i = 0; i < MAX_SPS_COUNT && !sps; i++)
+        if (s->sps_list[i])
+            sps = (const HEVCSPS *)s->sps_list[i]->data;
+
+    layers->nb_layers = FFMIN(vps->vps_max_layers, AV_HEVC_MAX_LAYERS);
+    for (i = 0; i < layers->nb_layers; i++) {
+        int idx = vps->m_vpsRepFormatIdx[i];
+        const RepFormat *rep = &vps->m_vpsRepFormat[FFMIN(idx, FF_ARRAY_ELEMS(vps->m_vpsRepFormat) - 1)];
+
+        layers->ref_layer[i] = i && vps->m_numDirectRefLayers[i] ? vps->m_refLayerId[i][0] : -1;
+        layers->width[i]     = rep->m_picWidthVpsInLumaSamples;
+        layers->height[i]    = rep->m_picHeightVpsInLumaSamples;
+    }
+    /* the base layer is described by its own SPS */
+    if (sps && (!layers->width[0] || !layers->height[0])) {
+        layers->width[0]  = sps->width;
+        layers->height[0] = sps->height;
+    }
+    return 0;
+}
+
 static void hevc_decode_flush(AVCodecContext *avctx)
 {
     HEVCContext *s = avctx->priv_data;
@@ -4542,6 +4484,14 @@ static const AVOption options[] = {
         AV_OPT_TYPE_INT, {.i64 = 0}, 0, 10, PAR },
     { "quality_layer_id", "set the max quality id", OFFSET(quality_layer_id),
         AV_OPT_TYPE_INT, {.i64 = 0}, 0, 10, PAR },
+    { "ctx_copy_bytes", "bytes of decoder context copied to the slice threads for the last frame of this thread context", OFFSET(ctx_copy_bytes),
+        AV_OPT_TYPE_INT, {.i64 = 0}, 0, INT_MAX, PAR | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY },
+    { "bounded-dpb", "size the DPB from the SPS instead of using all its entries", OFFSET(bounded_dpb),
+        AV_OPT_TYPE_INT, {.i64 = 0}, 0, 1, PAR },
+    { "dpb-frames", "DPB entries needed by the active SPS", OFFSET(dpb_frames),
+        AV_OPT_TYPE_INT, {.i64 = 0}, 0, INT_MAX, PAR | AV_OPT_FLAG_EXPORT | AV_OPT_FLAG_READONLY },
+    { "shared-pools", "recycle the motion tables with the other decoders of the process", OFFSET(shared_pools),
+        AV_OPT_TYPE_INT, {.i64 = 0}, 0, 1, PAR },
     { NULL },
 };
 
@@ -62,15 +62,11 @@
 #define EncryptMVDiffSign 1
 
 
-#define PARALLEL_SLICE   0
 #define PARALLEL_FILTERS 0
 
-#define MAX_SLICES_FRAME 64
 
 
 
-
-#define TEST_MV_POC
 #define MAX_DPB_SIZE 16 // A.4.1
 #define MAX_REFS 16
 
@@ -962,9 +958,10 @@ typedef struct SliceHeader {
     unsigned int max_num_merge_cand; ///< 5 - 5_minus_max_num_merge_cand
 
     int *entry_point_offset;
-    int * offset;
+    const uint8_t ** data;
     int * size;
     int num_entry_point_offsets;
+    int data_split;     ///< data[] is not contiguous, see unescape_slice_data()
 
     int8_t slice_qp;
 
@@ -1031,12 +1028,7 @@ typedef struct Mv {
 
 typedef struct MvField {
     Mv mv[2];
-#ifdef TEST_MV_POC
-    int32_t poc[2];
-    uint32_t pred_flag;
-#else
     uint8_t pred_flag;
-#endif
     uint8_t ref_idx[2];
 } MvField;
 
@@ -1083,6 +1075,7 @@ typedef struct TransformUnit {
 typedef struct DBParams {
     int8_t beta_offset;
     int8_t tc_offset;
+    uint8_t disable;
 } DBParams;
 
 #define HEVC_FRAME_FLAG_OUTPUT    (1 << 0)
@@ -1129,6 +1122,10 @@ typedef struct HEVCNAL {
 
     int size;
     const uint8_t *data;
+
+    /* data still holds its emulation prevention bytes, whose positions
+     * are kept in skipped_bytes_pos */
+    int escaped;
 } HEVCNAL;
 
 typedef struct HEVCLocalContext {
@@ -1167,6 +1164,7 @@ typedef struct HEVCLocalContext {
     uint8_t slice_or_tiles_up_boundary;
 
     int ctb_tile_rs;
+    int substream;      ///< next sh.data[] entry, when sh.data_split
     Crypto_Handle       dbs_g;
     
 } HEVCLocalContext;
@@ -1189,9 +1187,6 @@ typedef struct HEVCContext {
     const HEVCVPS *vps;
     const HEVCSPS *sps;
     const HEVCPPS *pps;
-    AVBufferRef *vps_list[MAX_VPS_COUNT];
-    AVBufferRef *sps_list[MAX_SPS_COUNT];
-    AVBufferRef *pps_list[MAX_PPS_COUNT];
 
     AVBufferPool *tab_mvf_pool;
     AVBufferPool *rpl_tab_pool;
@@ -1199,13 +1194,7 @@ typedef struct HEVCContext {
     SAOParams *sao;
     DBParams *deblock;
 
-    ///< candidate references for the current frame
-    RefPicList rps[5+2]; // 2 for inter layer reference pictures
-
-
     HEVCFrame *ref;
-    HEVCFrame DPB[32];
-    HEVCFrame Add_ref[2];
 
     int au_poc;
     int poc;
@@ -1220,10 +1209,6 @@ typedef struct HEVCContext {
 
     int is_decoded;
 
-    HEVCPredContext hpc;
-    HEVCDSPContext hevcdsp;
-    VideoDSPContext vdsp;
-    BswapDSPContext bdsp;
     int8_t  *qp_y_tab;
     uint8_t *horizontal_bs;
     uint8_t *vertical_bs;
@@ -1242,6 +1227,9 @@ typedef struct HEVCContext {
     // CTB-level flags affecting loop filter operation
     uint8_t *filter_slice_edges;
 
+    /** single allocation backing the tables above, see pic_arrays_init() */
+    uint8_t *pic_arena;
+
     /** used on BE to byteswap the lines for checksumming */
     uint8_t *checksum_buf;
     int      checksum_buf_size;
@@ -1262,8 +1250,6 @@ typedef struct HEVCContext {
     int **skipped_bytes_pos_nal;
     int *skipped_bytes_pos_size_nal;
 
-    const uint8_t *data;
-
     HEVCNAL *nals;
     int nb_nals;
     int nals_allocated;
@@ -1311,24 +1297,21 @@ typedef struct HEVCContext {
     /** 1 if the independent slice segment header was successfully parsed */
     uint8_t slice_initialized;
     long unsigned int dynamic_alloc;
+    int ctx_copy_bytes;     ///< bytes copied into sList[] for the current frame; with frame
+                            ///< threads, each thread context only counts its own frames
+    int bounded_dpb;        ///< only use the first dpb_frames entries of DPB[]
+    int dpb_frames;         ///< DPB entries the active SPS needs, see set_sps()
+    int shared_pools;       ///< take tab_mvf_pool and rpl_tab_pool from av_hevc_shared_pool_init()
 
     uint8_t threads_type;
     uint8_t threads_number;
+    uint8_t slice_parallel;     ///< the slices of the current picture are decoded concurrently
 #if FRAME_CONCEALMENT
     int prev_display_poc;
     int no_display_pic;
 #endif
     int     decode_checksum_sei;
 
-#if PARALLEL_SLICE
-    int NALListOrder[MAX_SLICES_FRAME];
-    int slice_segment_addr[MAX_SLICES_FRAME]; 
-    int NbListElement;
-    int self_id;
-    int job;
-    int max_slices;
-    uint8_t *decoded_rows; 
-#endif
     enum NALUnitType nal_unit_type;
     int temporal_id;  ///< temporal_id_plus1 - 1
     int nuh_layer_id;
@@ -1338,6 +1321,30 @@ typedef struct HEVCContext {
 	int64_t last_frame_pts;
     uint8_t encrypt_params;
     uint32_t prev_pos;
+
+    /**
+     * Everything from here on is left out of the per-slice copy into
+     * sList[]. The DSP contexts only change in set_sps() and are copied
+     * on the first slice of a picture.
+     */
+    HEVCPredContext hpc;
+    HEVCDSPContext hevcdsp;
+    VideoDSPContext vdsp;
+    BswapDSPContext bdsp;
+
+    /* Only used by the thread parsing the NAL units, never copied. */
+    AVBufferRef *vps_list[MAX_VPS_COUNT];
+    AVBufferRef *sps_list[MAX_SPS_COUNT];
+    AVBufferRef *pps_list[MAX_PPS_COUNT];
+
+    ///< candidate references for the current frame
+    RefPicList rps[5+2]; // 2 for inter layer reference pictures
+
+    HEVCFrame DPB[32];
+    HEVCFrame Add_ref[2];
+
+    int nb_slice_nals;          ///< slice NAL units of this layer in the current packet
+    int nb_queued_slices;       ///< slices waiting in sList[1..] for a slice-parallel batch
 } HEVCContext;
 
 int ff_hevc_decode_short_term_rps(HEVCContext *s, ShortTermRPS *rps,
@@ -1350,6 +1357,11 @@ int ff_hevc_decode_nal_sei(HEVCContext *s);
 int ff_hevc_extract_rbsp(HEVCContext *s, const uint8_t *src, int length,
                          HEVCNAL *nal);
 
+/**
+ * @return the implementation of av_hevc_find_nal_marker() for cpu_flags
+ */
+int (*ff_hevc_find_nal_marker_func(int cpu_flags))(const uint8_t *buf, int size);
+
 /**
  * Mark all frames in DPB as unused for reference.
  */
@@ -1378,6 +1390,7 @@ int ff_hevc_frame_rps(HEVCContext *s);
  */
 int ff_hevc_slice_rpl(HEVCContext *s);
 
+void ff_hevc_init_sig_ctx(void);
 void ff_hevc_save_states(HEVCContext *s, int ctb_addr_ts);
 void ff_hevc_cabac_init(HEVCContext *s, int ctb_addr_ts);
 int ff_hevc_sao_merge_flag_decode(HEVCContext *s);
@@ -1464,6 +1477,26 @@ int ff_hevc_cu_chroma_qp_offset_flag(HEVCContext *s);
 int ff_hevc_cu_chroma_qp_offset_idx(HEVCContext *s);
 void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size);
 void ff_hevc_hls_filters(HEVCContext *s, int x_ctb, int y_ctb, int ctb_size);
+/**
+ * Deblock and SAO filter the parts of a decoded tile that do not depend on
+ * samples of the neighbouring tiles.
+ */
+void ff_hevc_hls_filter_tile(HEVCContext *s, int tile_id);
+/**
+ * Filter the tile seams left over by ff_hevc_hls_filter_tile(), reporting
+ * the frame progress CTB row by CTB row.
+ */
+void ff_hevc_hls_filter_tile_seams(HEVCContext *s);
+/**
+ * Deblock and SAO filter the CTB rows that a slice decoded concurrently with
+ * the others covers entirely, [ctb_addr_rs0, ctb_addr_rs1) being its CTBs.
+ */
+void ff_hevc_hls_filter_slice_rows(HEVCContext *s, int ctb_addr_rs0, int ctb_addr_rs1);
+/**
+ * Filter what ff_hevc_hls_filter_slice_rows() left over once every slice is
+ * decoded: the rows shared by two slices and the edges between slices.
+ */
+void ff_hevc_hls_filter_slice_seams(HEVCContext *s);
 #if PARALLEL_FILTERS
 void ff_hevc_hls_filters_slice( HEVCContext *s, int x_ctb, int y_ctb, int ctb_size);
 void ff_hevc_hls_filter_slice(  HEVCContext *s, int x, int y, int ctb_size);
@@ -527,6 +527,85 @@ static const uint8_t diag_scan8x8_inv[8][8] = {
     { 28, 36, 43, 49, 54, 58, 61, 63, },
 };
 
+/**
+ * significant_coeff_flag context increments by scan position inside a 4x4
+ * sub-block, indexed by [log2_trafo_size - 2][scan_idx][c_idx > 0]
+ * [prev_csbf][first sub-block]. Entry 0 is the context of the DC coefficient
+ * of the sub-block when it is not inferred.
+ */
+static uint8_t sig_ctx_tab[4][3][2][4][2][16];
+
+/* same with transform_skip_context_enabled_flag and a transform skipped or
+ * bypassed block: one context per component */
+static uint8_t sig_ctx_ts[2][16];
+
+av_cold void ff_hevc_init_sig_ctx(void)
+{
+    static const uint8_t ctx_idx_map[] = {
+        0, 1, 4, 5, 2, 3, 4, 5, 6, 6, 8, 8, 7, 7, 8, 8, // log2_trafo_size == 2
+        1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, // prev_sig == 0
+        2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, // prev_sig == 1
+        2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0, // prev_sig == 2
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2  // default
+    };
+    static int initialized = 0;
+    int log2_trafo_size, scan_idx, c_idx, prev_sig, first, n;
+
+    if (initialized)
+        return;
+
+    for (log2_trafo_size = 2; log2_trafo_size <= 5; log2_trafo_size++)
+    for (scan_idx = SCAN_DIAG; scan_idx <= SCAN_VERT; scan_idx++)
+    for (c_idx = 0; c_idx < 2; c_idx++)
+    for (prev_sig = 0; prev_sig < 4; prev_sig++)
+    for (first = 0; first < 2; first++) {
+        uint8_t *tab = sig_ctx_tab[log2_trafo_size - 2][scan_idx][c_idx][prev_sig][first];
+        const uint8_t *scan_x_off, *scan_y_off, *map;
+        int scf_offset = c_idx ? 27 : 0;
+
+        switch (scan_idx) {
+        case SCAN_DIAG:
+            scan_x_off = ff_hevc_diag_scan4x4_x;
+            scan_y_off = ff_hevc_diag_scan4x4_y;
+            break;
+        case SCAN_HORIZ:
+            scan_x_off = horiz_scan4x4_x;
+            scan_y_off = horiz_scan4x4_y;
+            break;
+        default: //SCAN_VERT
+            scan_x_off = horiz_scan4x4_y;
+            scan_y_off = horiz_scan4x4_x;
+            break;
+        }
+
+        if (log2_trafo_size == 2) {
+            map = &ctx_idx_map[0];
+        } else {
+            map = &ctx_idx_map[(prev_sig + 1) << 4];
+            if (c_idx == 0) {
+                if (!first)
+                    scf_offset += 3;
+                if (log2_trafo_size == 3)
+                    scf_offset += (scan_idx == SCAN_DIAG) ? 9 : 15;
+                else
+                    scf_offset += 21;
+            } else {
+                if (log2_trafo_size == 3)
+                    scf_offset += 9;
+                else
+                    scf_offset += 12;
+            }
+        }
+        for (n = 1; n < 16; n++)
+            tab[n] = map[(scan_y_off[n] << 2) + scan_x_off[n]] + scf_offset;
+        tab[0] = first ? (c_idx ? 27 : 0) : scf_offset + 2;
+    }
+    memset(sig_ctx_ts[0], 42,      sizeof(sig_ctx_ts[0]));
+    memset(sig_ctx_ts[1], 16 + 27, sizeof(sig_ctx_ts[1]));
+
+    initialized = 1;
+}
+
 #if COM16_C806_EMT
 #ifndef MAX
 #define max(a,b) (a>=b?a:b)
@@ -564,11 +643,6 @@ static void load_states(HEVCContext *s)
     memcpy(s->HEVClc->cabac_state, s->cabac_state, HEVC_CONTEXTS);
 }
 
-static void cabac_reinit(HEVCLocalContext *lc)
-{
-    skip_bytes(&lc->cc, 0);
-}
-
 static void cabac_init_decoder(HEVCContext *s)
 {
     GetBitContext *gb = &s->HEVClc->gb;
@@ -579,6 +653,22 @@ static void cabac_init_decoder(HEVCContext *s)
                           (get_bits_left(gb) + 7) / 8);
 }
 
+static void cabac_reinit(HEVCContext *s)
+{
+    HEVCLocalContext *lc = s->HEVClc;
+
+    /* substreams of a NAL decoded in place do not follow each other in
+     * memory when some of them had to be unescaped; start the next one
+     * the way hls_decode_entry_wpp() does */
+    if (s->sh.data_split && lc->substream < s->sh.num_entry_point_offsets &&
+        init_get_bits8(&lc->gb, s->sh.data[lc->substream],
+                       s->sh.size[lc->substream]) >= 0) {
+        lc->substream++;
+        cabac_init_decoder(s);
+    } else
+        skip_bytes(&lc->cc, 0);
+}
+
 static void cabac_init_state(HEVCContext *s)
 {
     int init_type = 2 - s->sh.slice_type;
@@ -607,6 +697,7 @@ void ff_hevc_cabac_init(HEVCContext *s, int ctb_addr_ts)
 {
     if (ctb_addr_ts == s->pps->ctb_addr_rs_to_ts[s->sh.slice_ctb_addr_rs]) {
         cabac_init_decoder(s);
+        s->HEVClc->substream = 0;
         if (s->sh.dependent_slice_segment_flag == 0 ||
             (s->pps->tiles_enabled_flag &&
              s->pps->tile_id[ctb_addr_ts] != s->pps->tile_id[ctb_addr_ts - 1]))
@@ -627,7 +718,7 @@ void ff_hevc_cabac_init(HEVCContext *s, int ctb_addr_ts)
 
             s->HEVClc->ctb_tile_rs = 0;
             if (s->threads_number == 1)
-                cabac_reinit(s->HEVClc);
+                cabac_reinit(s);
             else
                 cabac_init_decoder(s);
             cabac_init_state(s);
@@ -639,7 +730,7 @@ void ff_hevc_cabac_init(HEVCContext *s, int ctb_addr_ts)
                     get_cabac_terminate(&s->HEVClc->cc);
 
                     if (s->threads_number == 1)
-                        cabac_reinit(s->HEVClc);
+                        cabac_reinit(s);
                     else
                         cabac_init_decoder(s);
 
@@ -1095,13 +1186,9 @@ static av_always_inline void last_significant_coeff_xy_prefix_decode(HEVCContext
 static av_always_inline int last_significant_coeff_suffix_decode(HEVCContext *s,
                                                  int last_significant_coeff_prefix)
 {
-    int i;
     int length = (last_significant_coeff_prefix >> 1) - 1;
-    int value = get_cabac_bypass(&s->HEVClc->cc);
 
-    for (i = 1; i < length; i++)
-        value = (value << 1) | get_cabac_bypass(&s->HEVClc->cc);
-    return value;
+    return get_cabac_bypass_bits(&s->HEVClc->cc, length);
 }
 
 static av_always_inline int significant_coeff_group_flag_decode(HEVCContext *s, int c_idx, int ctx_cg)
@@ -1112,18 +1199,11 @@ static av_always_inline int significant_coeff_group_flag_decode(HEVCContext *s,
 
     return GET_CABAC(elem_offset[SIGNIFICANT_COEFF_GROUP_FLAG] + inc);
 }
-static av_always_inline int significant_coeff_flag_decode(HEVCContext *s, int x_c, int y_c,
-                                           int offset, const uint8_t *ctx_idx_map)
+static av_always_inline int significant_coeff_flag_decode(HEVCContext *s, int inc)
 {
-    int inc = ctx_idx_map[(y_c << 2) + x_c] + offset;
     return GET_CABAC(elem_offset[SIGNIFICANT_COEFF_FLAG] + inc);
 }
 
-static av_always_inline int significant_coeff_flag_decode_0(HEVCContext *s, int c_idx, int offset)
-{
-    return GET_CABAC(elem_offset[SIGNIFICANT_COEFF_FLAG] + offset);
-}
-
 static av_always_inline int coeff_abs_level_greater1_flag_decode(HEVCContext *s, int c_idx, int inc)
 {
 
@@ -1334,23 +1414,18 @@ static av_always_inline int coeff_abs_level_greater2_flag_decode(HEVCContext *s,
 
 static av_always_inline int coeff_abs_level_remaining_decode(HEVCContext *s, int rc_rice_param)
 {
-    int prefix = 0;
-    int suffix = 0;
+    int prefix = get_cabac_bypass_unary(&s->HEVClc->cc, CABAC_MAX_BIN);
+    int suffix;
     int last_coeff_abs_level_remaining;
-    int i;
 
-    while (prefix < CABAC_MAX_BIN && get_cabac_bypass(&s->HEVClc->cc))
-        prefix++;
     if (prefix == CABAC_MAX_BIN)
         av_log(s->avctx, AV_LOG_ERROR, "CABAC_MAX_BIN : %d\n", prefix);
     if (prefix < 3) {
-        for (i = 0; i < rc_rice_param; i++)
-            suffix = (suffix << 1) | get_cabac_bypass(&s->HEVClc->cc);
+        suffix = get_cabac_bypass_bits(&s->HEVClc->cc, rc_rice_param);
         last_coeff_abs_level_remaining = (prefix << rc_rice_param) + suffix;
     } else {
         int prefix_minus3 = prefix - 3;
-        for (i = 0; i < prefix_minus3 + rc_rice_param; i++)
-            suffix = (suffix << 1) | get_cabac_bypass(&s->HEVClc->cc);
+        suffix = get_cabac_bypass_bits(&s->HEVClc->cc, prefix_minus3 + rc_rice_param);
         last_coeff_abs_level_remaining = (((1 << prefix_minus3) + 3 - 1)
                                               << rc_rice_param) + suffix;
     }
@@ -1359,11 +1434,8 @@ static av_always_inline int coeff_abs_level_remaining_decode(HEVCContext *s, int
 
 static av_always_inline int coeff_sign_flag_decode(HEVCContext *s, uint8_t nb)
 {
-    int i;
-    int ret = 0;
+    int ret = get_cabac_bypass_bits(&s->HEVClc->cc, nb);
 
-    for (i = 0; i < nb; i++)
-        ret = (ret << 1) | get_cabac_bypass(&s->HEVClc->cc);
     if(s->encrypt_params & HEVC_CRYPTO_TRANSF_COEFF_SIGNS)
       return ret^ff_get_key (&s->HEVClc->dbs_g, nb);
     return ret;
@@ -1621,74 +1693,23 @@ void ff_hevc_hls_residual_coding(HEVCContext *s, int x0, int y0,
             prev_sig += (!!significant_coeff_group_flag[x_cg][y_cg + 1] << 1);
 
         if (significant_coeff_group_flag[x_cg][y_cg] && n_end >= 0) {
-            static const uint8_t ctx_idx_map[] = {
-                0, 1, 4, 5, 2, 3, 4, 5, 6, 6, 8, 8, 7, 7, 8, 8, // log2_trafo_size == 2
-                1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, // prev_sig == 0
-                2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, // prev_sig == 1
-                2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0, // prev_sig == 2
-                2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2  // default
-            };
-            const uint8_t *ctx_idx_map_p;
-            int scf_offset = 0;
+            const uint8_t *sig_ctx;
+
             if (s->sps->spsRext.transform_skip_context_enabled_flag &&
-                (transform_skip_flag || lc->cu.cu_transquant_bypass_flag)) {
-                ctx_idx_map_p = (uint8_t*) &ctx_idx_map[4 * 16];
-                if (c_idx == 0) {
-                    scf_offset = 40;
-                } else {
-                    scf_offset = 14 + 27;
-                }
-            } else {
-                if (c_idx != 0)
-                    scf_offset = 27;
-                if (log2_trafo_size == 2) {
-                    ctx_idx_map_p = (uint8_t*) &ctx_idx_map[0];
-                } else {
-                    ctx_idx_map_p = (uint8_t*) &ctx_idx_map[(prev_sig + 1) << 4];
-                    if (c_idx == 0) {
-                        if ((x_cg > 0 || y_cg > 0))
-                            scf_offset += 3;
-                        if (log2_trafo_size == 3) {
-                            scf_offset += (scan_idx == SCAN_DIAG) ? 9 : 15;
-                        } else {
-                            scf_offset += 21;
-                        }
-                    } else {
-                        if (log2_trafo_size == 3)
-                            scf_offset += 9;
-                        else
-                            scf_offset += 12;
-                    }
-                }
-            }
+                (transform_skip_flag || lc->cu.cu_transquant_bypass_flag))
+                sig_ctx = sig_ctx_ts[c_idx > 0];
+            else
+                sig_ctx = sig_ctx_tab[log2_trafo_size - 2][scan_idx][c_idx > 0][prev_sig][i == 0];
+
             for (n = n_end; n > 0; n--) {
-                x_c = scan_x_off[n];
-                y_c = scan_y_off[n];
-                if (significant_coeff_flag_decode(s, x_c, y_c, scf_offset, ctx_idx_map_p)) {
+                if (significant_coeff_flag_decode(s, sig_ctx[n])) {
                     significant_coeff_flag_idx[nb_significant_coeff_flag] = n;
                     nb_significant_coeff_flag++;
                     implicit_non_zero_coeff = 0;
                 }
             }
             if (implicit_non_zero_coeff == 0) {
-                if (s->sps->spsRext.transform_skip_context_enabled_flag &&
-                    (transform_skip_flag || lc->cu.cu_transquant_bypass_flag)) {
-                    if (c_idx == 0) {
-                        scf_offset = 42;
-                    } else {
-                        scf_offset = 16 + 27;
-                    }
-                } else {
-                    if (i == 0) {
-                        if (c_idx == 0)
-                            scf_offset = 0;
-                        else
-                            scf_offset = 27;
-                    } else {
-                        scf_offset = 2 + scf_offset;
-                    }
-                }
-                if (significant_coeff_flag_decode_0(s, c_idx, scf_offset) == 1) {
+                if (significant_coeff_flag_decode(s, sig_ctx[0])) {
                     significant_coeff_flag_idx[nb_significant_coeff_flag] = 0;
                     nb_significant_coeff_flag++;
                 }
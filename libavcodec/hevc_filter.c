@@ -266,7 +266,7 @@ static void sao_filter_CTB(HEVCContext *s, int x, int y)
 
         switch (sao->type_idx[c_idx]) {
         case SAO_BAND:
-            copy_CTB(dst, src, width << s->sps->pixel_shift, height, stride_dst, stride_src);
+            // filters in place, dst still receives the deblocked samples
             s->hevcdsp.sao_band_filter(src, dst,
                                        stride_src, stride_dst,
                                        sao,
@@ -277,11 +277,13 @@ static void sao_filter_CTB(HEVCContext *s, int x, int y)
             break;
         case SAO_EDGE:
         {
-            uint8_t left_pixels = !edges[0] && (CTB(s->sao, x_ctb-1, y_ctb).type_idx[c_idx] != SAO_APPLIED);
+            // neighbours may already be filtered when CTBs are not processed in raster order
+            uint8_t left_pixels  = !edges[0] && (CTB(s->sao, x_ctb-1, y_ctb).type_idx[c_idx] != SAO_APPLIED);
+            uint8_t right_pixels =  edges[2] || (CTB(s->sao, x_ctb+1, y_ctb).type_idx[c_idx] != SAO_APPLIED);
             if (!edges[1]) {
                 uint8_t top_left  = !edges[0] && (CTB(s->sao, x_ctb-1, y_ctb-1).type_idx[c_idx] != SAO_APPLIED);
                 uint8_t top_right = !edges[2] && (CTB(s->sao, x_ctb+1, y_ctb-1).type_idx[c_idx] != SAO_APPLIED);
-                if (CTB(s->sao, x_ctb  , y_ctb-1).type_idx[c_idx] == 0)
+                if (CTB(s->sao, x_ctb  , y_ctb-1).type_idx[c_idx] != SAO_APPLIED)
                     memcpy( dst - stride_dst - (top_left << s->sps->pixel_shift),
                             src - stride_src - (top_left << s->sps->pixel_shift),
                             (top_left + width + top_right) << s->sps->pixel_shift);
@@ -297,14 +299,26 @@ static void sao_filter_CTB(HEVCContext *s, int x, int y)
                 }
             }
             if (!edges[3]) {                                                                // bottom and bottom right
-                uint8_t bottom_left = !edges[0] && (CTB(s->sao, x_ctb-1, y_ctb+1).type_idx[c_idx] != SAO_APPLIED);
-                memcpy( dst + height * stride_dst - (bottom_left << s->sps->pixel_shift),
-                        src + height * stride_src - (bottom_left << s->sps->pixel_shift),
-                        (width + 1 + bottom_left) << s->sps->pixel_shift);
+                uint8_t bottom_left  = !edges[0] && (CTB(s->sao, x_ctb-1, y_ctb+1).type_idx[c_idx] != SAO_APPLIED);
+                uint8_t bottom_right =  edges[2] || (CTB(s->sao, x_ctb+1, y_ctb+1).type_idx[c_idx] != SAO_APPLIED);
+                if (CTB(s->sao, x_ctb  , y_ctb+1).type_idx[c_idx] != SAO_APPLIED)
+                    memcpy( dst + height * stride_dst - (bottom_left << s->sps->pixel_shift),
+                            src + height * stride_src - (bottom_left << s->sps->pixel_shift),
+                            (width + bottom_right + bottom_left) << s->sps->pixel_shift);
+                else {
+                    if (bottom_left)
+                        memcpy( dst + height * stride_dst - (1 << s->sps->pixel_shift),
+                                src + height * stride_src - (1 << s->sps->pixel_shift),
+                                1 << s->sps->pixel_shift);
+                    if (bottom_right)
+                        memcpy( dst + height * stride_dst + (width << s->sps->pixel_shift),
+                                src + height * stride_src + (width << s->sps->pixel_shift),
+                                1 << s->sps->pixel_shift);
+                }
             }
             copy_CTB(dst - (left_pixels << s->sps->pixel_shift),
                      src - (left_pixels << s->sps->pixel_shift),
-                     (width + 1 + left_pixels) << s->sps->pixel_shift, height, stride_dst, stride_src);
+                     (width + right_pixels + left_pixels) << s->sps->pixel_shift, height, stride_dst, stride_src);
             s->hevcdsp.sao_edge_filter[restore](src, dst,
                                                 stride_src, stride_dst,
                                                 sao,
@@ -342,7 +356,49 @@ static int get_pcm(HEVCContext *s, int x, int y)
                     (tc_offset >> 1 << 1),                              \
                     0, MAX_QP + DEFAULT_INTRA_TC_OFFSET)]
 
-static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0)
+static av_always_inline int tile_col_boundary(HEVCContext *s, int x)
+{
+    int x_ctb = x >> s->sps->log2_ctb_size;
+
+    if (x <= 0 || x >= s->sps->width || (x & ((1 << s->sps->log2_ctb_size) - 1)))
+        return 0;
+    return s->pps->col_idxX[x_ctb] != s->pps->col_idxX[x_ctb - 1];
+}
+
+static av_always_inline int tile_row_boundary(HEVCContext *s, int y)
+{
+    int y_ctb = y >> s->sps->log2_ctb_size;
+
+    if (y <= 0 || y >= s->sps->height || (y & ((1 << s->sps->log2_ctb_size) - 1)))
+        return 0;
+    return s->pps->tile_id[s->pps->ctb_addr_rs_to_ts[ y_ctb      * s->sps->ctb_width]] !=
+           s->pps->tile_id[s->pps->ctb_addr_rs_to_ts[(y_ctb - 1) * s->sps->ctb_width]];
+}
+
+/**
+ * Edge selection for deblocking_filter_CTB(). A vertical edge lying on a tile
+ * column boundary, and a horizontal edge segment lying on a tile row boundary
+ * or sharing samples with a tile column boundary, belong to a tile seam and
+ * can only be filtered once both tiles are decoded. Of the other horizontal
+ * edges, the ones on the top boundary of the CTB are told apart for the
+ * concurrent slices, whose first CTB row borders the slice above.
+ */
+#define DEBLOCK_TILE_INNER  (1 << 0)
+#define DEBLOCK_SEAM_V      (1 << 1)
+#define DEBLOCK_SEAM_H      (1 << 2)
+#define DEBLOCK_CTB_TOP     (1 << 3)
+#define DEBLOCK_ALL         (DEBLOCK_TILE_INNER | DEBLOCK_SEAM_V | DEBLOCK_SEAM_H | DEBLOCK_CTB_TOP)
+
+#define DEBLOCK_V_EDGE(x)                                                     \
+    (edges == DEBLOCK_ALL ||                                                  \
+     (edges & (tile_col_boundary(s, x) ? DEBLOCK_SEAM_V : DEBLOCK_TILE_INNER)))
+#define DEBLOCK_H_EDGE(x, y, w)                                               \
+    (edges == DEBLOCK_ALL ||                                                  \
+     (edges & ((tile_row_boundary(s, y) || tile_col_boundary(s, x) ||         \
+                tile_col_boundary(s, (x) + (w))) ? DEBLOCK_SEAM_H :           \
+               (y) == y0 ? DEBLOCK_CTB_TOP : DEBLOCK_TILE_INNER)))
+
+static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0, int edges)
 {
     uint8_t *src;
     int x, y;
@@ -387,7 +443,7 @@ static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0)
         for (x = x0 ? x0 : 8; x < x_end; x += 8) {
             const int bs0 = s->vertical_bs[(x +  y      * s->bs_width) >> 2];
             const int bs1 = s->vertical_bs[(x + (y + 4) * s->bs_width) >> 2];
-            if (bs0 || bs1) {
+            if ((bs0 || bs1) && DEBLOCK_V_EDGE(x)) {
                 const int qp = (get_qPy(s, x - 1, y)     + get_qPy(s, x, y)     + 1) >> 1;
 
                 beta    = betatable[av_clip(qp + beta_offset, 0, MAX_QP)];
@@ -431,7 +487,7 @@ static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0)
                 const int bs0 = s->vertical_bs[(x +  y            * s->bs_width) >> 2];
                 const int bs1 = s->vertical_bs[(x + (y + (4 * v)) * s->bs_width) >> 2];
 
-                if ((bs0 == 2) || (bs1 == 2)) {
+                if (((bs0 == 2) || (bs1 == 2)) && DEBLOCK_V_EDGE(x)) {
                     const int qp0 = (get_qPy(s, x - 1, y)           + get_qPy(s, x, y)           + 1) >> 1;
                     const int qp1 = (get_qPy(s, x - 1, y + (4 * v)) + get_qPy(s, x, y + (4 * v)) + 1) >> 1;
 
@@ -486,7 +542,7 @@ static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0)
         for (x = x0 ? x0 - 8 : 0; x < x_end; x += 8) {
             const int bs0 = s->horizontal_bs[( x      + y * s->bs_width) >> 2];
             const int bs1 = s->horizontal_bs[((x + 4) + y * s->bs_width) >> 2];
-            if (bs0 || bs1) {
+            if ((bs0 || bs1) && DEBLOCK_H_EDGE(x, y, 8)) {
                 const int qp = (get_qPy(s, x, y - 1)     + get_qPy(s, x, y)     + 1) >> 1;
 
                 beta    = betatable[av_clip(qp + beta_offset, 0, MAX_QP)];
@@ -532,7 +588,7 @@ static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0)
             for (x = x0 ? x0 - 8 * h : 0; x < x_end; x += (8 * h)) {
                 const int bs0 = s->horizontal_bs[( x          + y * s->bs_width) >> 2];
                 const int bs1 = s->horizontal_bs[((x + 4 * h) + y * s->bs_width) >> 2];
-                if ((bs0 == 2) || (bs1 == 2)) {
+                if (((bs0 == 2) || (bs1 == 2)) && DEBLOCK_H_EDGE(x, y, 8 * h)) {
                     const int qp0 = bs0 == 2 ? (get_qPy(s, x,           y - 1) + get_qPy(s, x,           y) + 1) >> 1 : 0;
                     const int qp1 = bs1 == 2 ? (get_qPy(s, x + (4 * h), y - 1) + get_qPy(s, x + (4 * h), y) + 1) >> 1 : 0;
 
@@ -580,132 +636,13 @@ static void deblocking_filter_CTB(HEVCContext *s, int x0, int y0)
     }
 }
 
-#ifdef TEST_MV_POC
-static int boundary_strength(HEVCContext *s, MvField *curr, MvField *neigh)
-{
-#if HAVE_SSE42
-    {
-        __m128i x0, x1, x2, x3;
-        x0 = _mm_loadu_si128((__m128i *) neigh);
-        x1 = _mm_loadu_si128((__m128i *) curr);
-        x2 = _mm_loadl_epi64((__m128i *) &(neigh->pred_flag));
-        x3 = _mm_loadl_epi64((__m128i *) &(curr->pred_flag));
-        x0 = _mm_cmpeq_epi64 (x0, x1);
-        x2 = _mm_cmpeq_epi32 (x2, x3);
-
-        if (_mm_test_all_ones(x0) && _mm_test_all_ones(x2))
-            return 0;
-    }
-#else
-    if ( memcmp(curr, neigh, sizeof(MvField)) == 0)
-        return 0;
-#endif
-    if (curr->pred_flag == PF_BI &&  neigh->pred_flag == PF_BI) {
-        // same L0 and L1
-        if (curr->poc[0] == neigh->poc[0]  &&
-            curr->poc[0] == curr->poc[1] &&
-            neigh->poc[0] == neigh->poc[1]) {
-#if HAVE_SSE42
-            __m128i x0, x1, x2;
-            x0 = _mm_loadl_epi64((__m128i *) neigh);
-            x1 = _mm_loadl_epi64((__m128i *) curr);
-            x2 =  _mm_shufflelo_epi16(x0, 0x4E);
-            x0 = _mm_sub_epi16(x0, x1);
-            x2 = _mm_sub_epi16(x2, x1);
-            x1 = _mm_set1_epi16(4);
-            x0 = _mm_abs_epi16(x0);
-            x2 = _mm_abs_epi16(x2);
-            x0 = _mm_cmplt_epi16(x0, x1);
-            x2 = _mm_cmplt_epi16(x2, x1);
-            return !(_mm_test_all_ones(x0) || _mm_test_all_ones(x2));
-#else
-            if ((FFABS(neigh->mv[0].x - curr->mv[0].x) >= 4 || FFABS(neigh->mv[0].y - curr->mv[0].y) >= 4 ||
-                 FFABS(neigh->mv[1].x - curr->mv[1].x) >= 4 || FFABS(neigh->mv[1].y - curr->mv[1].y) >= 4) &&
-                (FFABS(neigh->mv[1].x - curr->mv[0].x) >= 4 || FFABS(neigh->mv[1].y - curr->mv[0].y) >= 4 ||
-                 FFABS(neigh->mv[0].x - curr->mv[1].x) >= 4 || FFABS(neigh->mv[0].y - curr->mv[1].y) >= 4))
-                return 1;
-            else
-                return 0;
-#endif
-        } else if (neigh->poc[0] == curr->poc[0] &&
-                   neigh->poc[1] == curr->poc[1]) {
-#if HAVE_SSE42
-            __m128i x0, x1;
-            x0 = _mm_loadl_epi64((__m128i *) neigh);
-            x1 = _mm_loadl_epi64((__m128i *) curr);
-            x0 = _mm_sub_epi16(x0, x1);
-            x1 = _mm_set1_epi16(4);
-            x0 = _mm_abs_epi16(x0);
-            x0 = _mm_cmplt_epi16(x0, x1);
-            return !(_mm_test_all_ones(x0));
-#else
-            if (FFABS(neigh->mv[0].x - curr->mv[0].x) >= 4 || FFABS(neigh->mv[0].y - curr->mv[0].y) >= 4 ||
-                FFABS(neigh->mv[1].x - curr->mv[1].x) >= 4 || FFABS(neigh->mv[1].y - curr->mv[1].y) >= 4)
-                return 1;
-            else
-                return 0;
-#endif
-        } else if (neigh->poc[1] == curr->poc[0] &&
-                   neigh->poc[0] == curr->poc[1]) {
-#if HAVE_SSE42
-            __m128i x0, x1, x2;
-            x0 = _mm_loadl_epi64((__m128i *) neigh);
-            x1 = _mm_loadl_epi64((__m128i *) curr);
-            x2 = _mm_shufflelo_epi16(x0, 0x4E);
-            x2 = _mm_sub_epi16(x2, x1);
-            x1 = _mm_set1_epi16(4);
-            x2 = _mm_abs_epi16(x2);
-            x2 = _mm_cmplt_epi16(x2, x1);
-            return !(_mm_test_all_ones(x2));
-#else
-            if (FFABS(neigh->mv[1].x - curr->mv[0].x) >= 4 || FFABS(neigh->mv[1].y - curr->mv[0].y) >= 4 ||
-                FFABS(neigh->mv[0].x - curr->mv[1].x) >= 4 || FFABS(neigh->mv[0].y - curr->mv[1].y) >= 4)
-                return 1;
-            else
-                return 0;
-#endif
-        } else {
-            return 1;
-        }
-    } else if ((curr->pred_flag != PF_BI) && (neigh->pred_flag != PF_BI)){ // 1 MV
-        Mv A, B;
-        int ref_A, ref_B;
-
-        if (curr->pred_flag & 1) {
-            A     = curr->mv[0];
-            ref_A = curr->poc[0];
-        } else {
-            A     = curr->mv[1];
-            ref_A = curr->poc[1];
-        }
-
-        if (neigh->pred_flag & 1) {
-            B     = neigh->mv[0];
-            ref_B = neigh->poc[0];
-        } else {
-            B     = neigh->mv[1];
-            ref_B = neigh->poc[1];
-        }
-
-        if (ref_A == ref_B) {
-            if (FFABS(A.x - B.x) >= 4 || FFABS(A.y - B.y) >= 4)
-                return 1;
-            else
-                return 0;
-        } else
-            return 1;
-    }
-
-    return 1;
-}
-#else
 static int boundary_strength(HEVCContext *s, MvField *curr, MvField *neigh,
-                             RefPicList *neigh_refPicList)
+                             RefPicList *refPicList, RefPicList *neigh_refPicList)
 {
     if (curr->pred_flag == PF_BI &&  neigh->pred_flag == PF_BI) {
         // same L0 and L1
-        if (s->ref->refPicList[0].list[curr->ref_idx[0]] == neigh_refPicList[0].list[neigh->ref_idx[0]]  &&
-            s->ref->refPicList[0].list[curr->ref_idx[0]] == s->ref->refPicList[1].list[curr->ref_idx[1]] &&
+        if (refPicList[0].list[curr->ref_idx[0]] == neigh_refPicList[0].list[neigh->ref_idx[0]]  &&
+            refPicList[0].list[curr->ref_idx[0]] == refPicList[1].list[curr->ref_idx[1]] &&
             neigh_refPicList[0].list[neigh->ref_idx[0]] == neigh_refPicList[1].list[neigh->ref_idx[1]]) {
 #if HAVE_SSE42
             __m128i x0, x1, x2;
@@ -729,8 +666,8 @@ static int boundary_strength(HEVCContext *s, MvField *curr, MvField *neigh,
             else
                 return 0;
 #endif
-        } else if (neigh_refPicList[0].list[neigh->ref_idx[0]] == s->ref->refPicList[0].list[curr->ref_idx[0]] &&
-                   neigh_refPicList[1].list[neigh->ref_idx[1]] == s->ref->refPicList[1].list[curr->ref_idx[1]]) {
+        } else if (neigh_refPicList[0].list[neigh->ref_idx[0]] == refPicList[0].list[curr->ref_idx[0]] &&
+                   neigh_refPicList[1].list[neigh->ref_idx[1]] == refPicList[1].list[curr->ref_idx[1]]) {
 #if HAVE_SSE42
             __m128i x0, x1;
             x0 = _mm_loadl_epi64((__m128i *) neigh);
@@ -747,8 +684,8 @@ static int boundary_strength(HEVCContext *s, MvField *curr, MvField *neigh,
             else
                 return 0;
 #endif
-        } else if (neigh_refPicList[1].list[neigh->ref_idx[1]] == s->ref->refPicList[0].list[curr->ref_idx[0]] &&
-                   neigh_refPicList[0].list[neigh->ref_idx[0]] == s->ref->refPicList[1].list[curr->ref_idx[1]]) {
+        } else if (neigh_refPicList[1].list[neigh->ref_idx[1]] == refPicList[0].list[curr->ref_idx[0]] &&
+                   neigh_refPicList[0].list[neigh->ref_idx[0]] == refPicList[1].list[curr->ref_idx[1]]) {
 #if HAVE_SSE42
             __m128i x0, x1, x2;
             x0 = _mm_loadl_epi64((__m128i *) neigh);
@@ -775,10 +712,10 @@ static int boundary_strength(HEVCContext *s, MvField *curr, MvField *neigh,
 
         if (curr->pred_flag & 1) {
             A     = curr->mv[0];
-            ref_A = s->ref->refPicList[0].list[curr->ref_idx[0]];
+            ref_A = refPicList[0].list[curr->ref_idx[0]];
         } else {
             A     = curr->mv[1];
-            ref_A = s->ref->refPicList[1].list[curr->ref_idx[1]];
+            ref_A = refPicList[1].list[curr->ref_idx[1]];
         }
 
         if (neigh->pred_flag & 1) {
@@ -800,7 +737,6 @@ static int boundary_strength(HEVCContext *s, MvField *curr, MvField *neigh,
 
     return 1;
 }
-#endif
 
 void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
                                            int log2_trafo_size)
@@ -813,11 +749,12 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
     int min_tu_width     = s->sps->min_tb_width;
     int is_intra = tab_mvf[(y0 >> log2_min_pu_size) * min_pu_width +
                            (x0 >> log2_min_pu_size)].pred_flag == PF_INTRA;
+    RefPicList *refPicList = ff_hevc_get_ref_list(s, s->ref, x0, y0);
     int i, j, bs;
 
     if (y0 > 0 && (y0 & 7) == 0) {
         int bd_ctby = y0 & ((1 << s->sps->log2_ctb_size) - 1);
-        int bd_slice = s->sh.slice_loop_filter_across_slices_enabled_flag ||
+        int bd_slice = (s->sh.slice_loop_filter_across_slices_enabled_flag && !s->slice_parallel) ||
                        !(lc->slice_or_tiles_up_boundary & 1);
         int bd_tiles = s->pps->loop_filter_across_tiles_enabled_flag ||
                        !(lc->slice_or_tiles_up_boundary & 2);
@@ -826,10 +763,8 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
             int yq_pu =  y0      >> log2_min_pu_size;
             int yp_tu = (y0 - 1) >> log2_min_tu_size;
             int yq_tu =  y0      >> log2_min_tu_size;
-#ifndef TEST_MV_POC
             RefPicList *top_refPicList = ff_hevc_get_ref_list(s, s->ref,
                                                               x0, y0 - 1);
-#endif
             for (i = 0; i < (1 << log2_trafo_size); i += 4) {
                 int x_pu = (x0 + i) >> log2_min_pu_size;
                 int x_tu = (x0 + i) >> log2_min_tu_size;
@@ -843,11 +778,7 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
                 else if (curr_cbf_luma || top_cbf_luma)
                     bs = 1;
                 else
-#ifdef TEST_MV_POC
-                    bs = boundary_strength(s, curr, top);
-#else
-                    bs = boundary_strength(s, curr, top, top_refPicList);
-#endif
+                    bs = boundary_strength(s, curr, top, refPicList, top_refPicList);
                 s->horizontal_bs[((x0 + i) + y0 * s->bs_width) >> 2] = bs;
             }
         }
@@ -856,7 +787,7 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
     // bs for vertical TU boundaries
     if (x0 > 0 && (x0 & 7) == 0) {
         int bd_ctbx = x0 & ((1 << s->sps->log2_ctb_size) - 1);
-        int bd_slice = s->sh.slice_loop_filter_across_slices_enabled_flag ||
+        int bd_slice = (s->sh.slice_loop_filter_across_slices_enabled_flag && !s->slice_parallel) ||
                        !(lc->slice_or_tiles_left_boundary & 1);
         int bd_tiles = s->pps->loop_filter_across_tiles_enabled_flag ||
                        !(lc->slice_or_tiles_left_boundary & 2);
@@ -865,10 +796,8 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
             int xq_pu =  x0      >> log2_min_pu_size;
             int xp_tu = (x0 - 1) >> log2_min_tu_size;
             int xq_tu =  x0      >> log2_min_tu_size;
-#ifndef TEST_MV_POC
             RefPicList *left_refPicList = ff_hevc_get_ref_list(s, s->ref,
                                                                x0 - 1, y0);
-#endif
             for (i = 0; i < (1 << log2_trafo_size); i += 4) {
                 int y_pu      = (y0 + i) >> log2_min_pu_size;
                 int y_tu      = (y0 + i) >> log2_min_tu_size;
@@ -882,22 +811,13 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
                 else if (curr_cbf_luma || left_cbf_luma)
                     bs = 1;
                 else
-#ifdef TEST_MV_POC
-                    bs = boundary_strength(s, curr, left);
-#else
-                    bs = boundary_strength(s, curr, left, left_refPicList);
-#endif
+                    bs = boundary_strength(s, curr, left, refPicList, left_refPicList);
                 s->vertical_bs[(x0 + (y0 + i) * s->bs_width) >> 2] = bs;
             }
         }
     }
 
     if (log2_trafo_size > log2_min_pu_size && !is_intra) {
-#ifndef TEST_MV_POC
-        RefPicList *refPicList = ff_hevc_get_ref_list(s, s->ref,
-                                                           x0,
-                                                           y0);
-#endif
         // bs for TU internal horizontal PU boundaries
         for (i = 0; i < (1 << log2_trafo_size); i += 4) {
             int x_pu  = (x0 + i) >> log2_min_pu_size;
@@ -908,11 +828,7 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
                 int yq_pu = (y0 + j)     >> log2_min_pu_size;
                 MvField *curr = &tab_mvf[yq_pu * min_pu_width + x_pu];
 
-#ifdef TEST_MV_POC
-                bs = boundary_strength(s, curr, top);
-#else
-                bs = boundary_strength(s, curr, top, refPicList);
-#endif
+                bs = boundary_strength(s, curr, top, refPicList, refPicList);
                 s->horizontal_bs[((x0 + i) + (y0 + j) * s->bs_width) >> 2] = bs;
                 top = curr;
             }
@@ -928,11 +844,7 @@ void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
                 int xq_pu = (x0 + i)     >> log2_min_pu_size;
                 MvField *curr = &tab_mvf[y_pu * min_pu_width + xq_pu];
 
-#ifdef TEST_MV_POC
-                bs = boundary_strength(s, curr, left);
-#else
-                bs = boundary_strength(s, curr, left, refPicList);
-#endif
+                bs = boundary_strength(s, curr, left, refPicList, refPicList);
                 s->vertical_bs[((x0 + i) + (y0 + j) * s->bs_width) >> 2] = bs;
                 left = curr;
             }
@@ -959,22 +871,17 @@ void ff_hevc_deblocking_boundary_strengths_h(HEVCContext *s, int x0, int y0, int
         MvField *curr = &tab_mvf[yq_pu * pic_width_in_min_pu + x_pu];
         uint8_t top_cbf_luma  = s->cbf_luma[yp_tu * pic_width_in_min_tu + x_tu];
         uint8_t curr_cbf_luma = s->cbf_luma[yq_tu * pic_width_in_min_tu + x_tu];
-#ifndef TEST_MV_POC
+        RefPicList *refPicList = ff_hevc_get_ref_list(s, s->ref, x0, y0);
         RefPicList* top_refPicList = ff_hevc_get_ref_list(s, s->ref, x0, y0 - 1);
-#endif
         if (curr->pred_flag == PF_INTRA || top->pred_flag == PF_INTRA)
             bs = 2;
         else if (curr_cbf_luma || top_cbf_luma)
             bs = 1;
         else
-#ifdef TEST_MV_POC
-                bs = boundary_strength(s, curr, top);
-#else
-                bs = boundary_strength(s, curr, top, top_refPicList);
-#endif
+                bs = boundary_strength(s, curr, top, refPicList, top_refPicList);
         if ((slice_up_boundary & 1) && (y0 % (1 << s->sps->log2_ctb_size)) == 0)
             bs = 0;
-        if (s->sh.disable_deblocking_filter_flag == 1)
+        if (s->deblock[(x0 >> s->sps->log2_ctb_size) + (y0 >> s->sps->log2_ctb_size) * s->sps->ctb_width].disable)
             bs = 0;
         s->horizontal_bs[(x0 + y0 * s->bs_width) >> 2] =  bs;
     }
@@ -1000,22 +907,17 @@ void ff_hevc_deblocking_boundary_strengths_v(HEVCContext *s, int x0, int y0, int
         MvField *curr = &tab_mvf[y_pu * pic_width_in_min_pu + xq_pu];
         uint8_t left_cbf_luma = s->cbf_luma[y_tu * pic_width_in_min_tu + xp_tu];
         uint8_t curr_cbf_luma = s->cbf_luma[y_tu * pic_width_in_min_tu + xq_tu];
-#ifndef TEST_MV_POC
+        RefPicList *refPicList = ff_hevc_get_ref_list(s, s->ref, x0, y0);
         RefPicList* left_refPicList = ff_hevc_get_ref_list(s, s->ref, x0 - 1, y0);
-#endif
         if (curr->pred_flag == PF_INTRA || left->pred_flag == PF_INTRA)
             bs = 2;
         else if (curr_cbf_luma || left_cbf_luma)
             bs = 1;
         else
-#ifdef TEST_MV_POC
-                bs = boundary_strength(s, curr, left);
-#else
-                bs = boundary_strength(s, curr, left, left_refPicList);
-#endif
+                bs = boundary_strength(s, curr, left, refPicList, left_refPicList);
         if ((slice_left_boundary & 1) && (x0 % (1 << s->sps->log2_ctb_size)) == 0)
             bs = 0;
-        if (s->sh.disable_deblocking_filter_flag == 1)
+        if (s->deblock[(x0 >> s->sps->log2_ctb_size) + (y0 >> s->sps->log2_ctb_size) * s->sps->ctb_width].disable)
             bs = 0;
         s->vertical_bs[(x0 + y0 * s->bs_width) >> 2] =  bs;
     }
@@ -1024,9 +926,8 @@ void ff_hevc_deblocking_boundary_strengths_v(HEVCContext *s, int x0, int y0, int
 #undef CB
 #undef CR
 
-void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size)
+static void sao_filter_and_report(HEVCContext *s, int x, int y, int ctb_size)
 {
-    deblocking_filter_CTB(s, x, y);
     if (s->sps->sao_enabled) {
         int x_end = x >= s->sps->width  - ctb_size;
         int y_end = y >= s->sps->height - ctb_size;
@@ -1034,15 +935,17 @@ void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size)
             sao_filter_CTB(s, x - ctb_size, y - ctb_size);
         if (x && y_end)
             sao_filter_CTB(s, x - ctb_size, y);
+        /* Once the row above is through SAO every sample above y is
+         * final, which is all hevc_await_progress() asks for. */
         if (y && x_end) {
             sao_filter_CTB(s, x, y - ctb_size);
             if (s->threads_type & FF_THREAD_FRAME )
-                ff_thread_report_progress(&s->ref->tf, y - ctb_size, 0);
+                ff_thread_report_progress(&s->ref->tf, y, 0);
         }
         if (x_end && y_end) {
             sao_filter_CTB(s, x , y);
             if (s->threads_type & FF_THREAD_FRAME )
-                ff_thread_report_progress(&s->ref->tf, y, 0);
+                ff_thread_report_progress(&s->ref->tf, s->sps->height, 0);
         }
     } else {
         if (y && x >= s->sps->width - ctb_size)
@@ -1051,6 +954,129 @@ void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size)
     }
 }
 
+void ff_hevc_hls_filter(HEVCContext *s, int x, int y, int ctb_size)
+{
+    deblocking_filter_CTB(s, x, y, DEBLOCK_ALL);
+    sao_filter_and_report(s, x, y, ctb_size);
+}
+
+/**
+ * A CTB can be SAO filtered inside its tile when none of the samples SAO
+ * reads are touched by the deferred seam deblocking, i.e. when its 3x3 CTB
+ * neighbourhood lies in the same tile.
+ */
+static int tile_interior_ctb(HEVCContext *s, int x_ctb, int y_ctb)
+{
+    int tile_id = s->pps->tile_id[s->pps->ctb_addr_rs_to_ts[y_ctb * s->sps->ctb_width + x_ctb]];
+    int x, y;
+
+    for (y = FFMAX(y_ctb - 1, 0); y <= FFMIN(y_ctb + 1, s->sps->ctb_height - 1); y++)
+        for (x = FFMAX(x_ctb - 1, 0); x <= FFMIN(x_ctb + 1, s->sps->ctb_width - 1); x++)
+            if (s->pps->tile_id[s->pps->ctb_addr_rs_to_ts[y * s->sps->ctb_width + x]] != tile_id)
+                return 0;
+    return 1;
+}
+
+void ff_hevc_hls_filter_tile(HEVCContext *s, int tile_id)
+{
+    int ctb_size    = 1 << s->sps->log2_ctb_size;
+    int ctb_addr_rs = s->pps->tile_pos_rs[tile_id];
+    int x_ctb0      = ctb_addr_rs % s->sps->ctb_width;
+    int y_ctb0      = ctb_addr_rs / s->sps->ctb_width;
+    int x_ctb1      = x_ctb0 + s->pps->column_width[tile_id % s->pps->num_tile_columns];
+    int y_ctb1      = y_ctb0 + s->pps->row_height[tile_id / s->pps->num_tile_columns];
+    int x_ctb, y_ctb;
+
+    for (y_ctb = y_ctb0; y_ctb < y_ctb1; y_ctb++)
+        for (x_ctb = x_ctb0; x_ctb < x_ctb1; x_ctb++)
+            deblocking_filter_CTB(s, x_ctb << s->sps->log2_ctb_size,
+                                  y_ctb << s->sps->log2_ctb_size,
+                                  DEBLOCK_TILE_INNER | DEBLOCK_CTB_TOP);
+
+    if (s->sps->sao_enabled)
+        for (y_ctb = y_ctb0; y_ctb < y_ctb1; y_ctb++)
+            for (x_ctb = x_ctb0; x_ctb < x_ctb1; x_ctb++)
+                if (tile_interior_ctb(s, x_ctb, y_ctb))
+                    sao_filter_CTB(s, x_ctb * ctb_size, y_ctb * ctb_size);
+}
+
+void ff_hevc_hls_filter_tile_seams(HEVCContext *s)
+{
+    int ctb_size = 1 << s->sps->log2_ctb_size;
+    int x, y;
+
+    // vertical seam edges of a CTB row must be filtered before its horizontal ones
+    for (y = 0; y < s->sps->height; y += ctb_size) {
+        for (x = 0; x < s->sps->width; x += ctb_size)
+            deblocking_filter_CTB(s, x, y, DEBLOCK_SEAM_V);
+        for (x = 0; x < s->sps->width; x += ctb_size)
+            deblocking_filter_CTB(s, x, y, DEBLOCK_SEAM_H);
+        for (x = 0; x < s->sps->width; x += ctb_size)
+            sao_filter_and_report(s, x, y, ctb_size);
+    }
+}
+
+void ff_hevc_hls_filter_slice_rows(HEVCContext *s, int ctb_addr_rs0, int ctb_addr_rs1)
+{
+    int ctb_size = 1 << s->sps->log2_ctb_size;
+    int y_ctb0   = (ctb_addr_rs0 + s->sps->ctb_width - 1) / s->sps->ctb_width;
+    int y_ctb1   = ctb_addr_rs1 / s->sps->ctb_width;
+    int x, y_ctb;
+
+    for (y_ctb = y_ctb0; y_ctb < y_ctb1; y_ctb++)
+        for (x = 0; x < s->sps->width; x += ctb_size)
+            deblocking_filter_CTB(s, x, y_ctb * ctb_size,
+                                  y_ctb == y_ctb0 && y_ctb ? DEBLOCK_ALL & ~DEBLOCK_CTB_TOP : DEBLOCK_ALL);
+
+    // SAO reads a sample of the rows above and below, the seams change them
+    if (s->sps->sao_enabled)
+        for (y_ctb = y_ctb0 + !!y_ctb0; y_ctb < y_ctb1 - (y_ctb1 < s->sps->ctb_height); y_ctb++)
+            for (x = 0; x < s->sps->width; x += ctb_size)
+                sao_filter_CTB(s, x, y_ctb * ctb_size);
+}
+
+/**
+ * Whether the SAO of a CTB row was applied by ff_hevc_hls_filter_slice_rows():
+ * the row and its neighbours lie in the same slice. Slices are runs of CTBs
+ * in raster order, so comparing the ends of the rows is enough.
+ */
+static int slice_inner_row(HEVCContext *s, int y_ctb)
+{
+    int ctb_width        = s->sps->ctb_width;
+    const int32_t *addr  = &s->tab_slice_address[y_ctb * ctb_width];
+
+    return addr[0] == addr[ctb_width - 1] &&
+           (!y_ctb || addr[-ctb_width] == addr[0]) &&
+           (y_ctb == s->sps->ctb_height - 1 || addr[2 * ctb_width - 1] == addr[0]);
+}
+
+void ff_hevc_hls_filter_slice_seams(HEVCContext *s)
+{
+    int ctb_size  = 1 << s->sps->log2_ctb_size;
+    int ctb_width = s->sps->ctb_width;
+    int x, y_ctb;
+
+    for (y_ctb = 0; y_ctb <= s->sps->ctb_height; y_ctb++) {
+        if (y_ctb < s->sps->ctb_height) {
+            const int32_t *addr = &s->tab_slice_address[y_ctb * ctb_width];
+            int whole = addr[0] == addr[ctb_width - 1];
+
+            // rows shared by two slices, or the top edges of a first whole row
+            if (!whole || (y_ctb && addr[-ctb_width] != addr[0]))
+                for (x = 0; x < s->sps->width; x += ctb_size)
+                    deblocking_filter_CTB(s, x, y_ctb * ctb_size,
+                                          whole ? DEBLOCK_CTB_TOP : DEBLOCK_ALL);
+        }
+        if (!y_ctb)
+            continue;
+        if (s->sps->sao_enabled && !slice_inner_row(s, y_ctb - 1))
+            for (x = 0; x < s->sps->width; x += ctb_size)
+                sao_filter_CTB(s, x, (y_ctb - 1) * ctb_size);
+        if (s->threads_type & FF_THREAD_FRAME)
+            ff_thread_report_progress(&s->ref->tf, FFMIN(y_ctb * ctb_size, s->sps->height), 0);
+    }
+}
+
 void ff_hevc_hls_filters(HEVCContext *s, int x_ctb, int y_ctb, int ctb_size)
 {
     int x_end = x_ctb >= s->sps->width  - ctb_size;
@@ -1101,7 +1127,7 @@ void ff_hevc_hls_filters_slice(HEVCContext *s, int x_ctb, int y_ctb, int ctb_siz
 void ff_hevc_hls_filter_slice(HEVCContext *s, int x, int y, int ctb_size)
 {
     int x_slice_end = 0, y_slice_end= 0;
-    deblocking_filter_CTB(s, x, y);
+    deblocking_filter_CTB(s, x, y, DEBLOCK_ALL);
     int ctb_addr_rs = (x >> s->sps->log2_ctb_size) + (y >> s->sps->log2_ctb_size) * s->sps->ctb_width;
 
     if (s->sps->sao_enabled) {
@@ -1172,6 +1198,12 @@ static void copy_block (pixel *src, pixel * dst, ptrdiff_t bl_stride, ptrdiff_t
     }
 }
 
+/* The fused kernels expect the base layer to be at most as large as the
+ * enhancement layer, so that a CTB needs at most CTB size + 8 base rows. */
+#define UPSAMPLE_HV(s, fn) ((s)->hevcdsp.fn[(s)->up_filter_inf.idx] &&  \
+                            (s)->up_filter_inf.scaleXLum <= 1 << 16   &&  \
+                            (s)->up_filter_inf.scaleYLum <= 1 << 16)
+
 static void upsample_block_luma(HEVCContext *s, HEVCFrame *ref0, int x0, int y0) {
     uint8_t *src,  *dst = ref0->frame->data[0];
     int ctb_size  = 1<<s->sps->log2_ctb_size;
@@ -1183,11 +1215,14 @@ static void upsample_block_luma(HEVCContext *s, HEVCFrame *ref0, int x0, int y0)
     int el_stride =  ref0->frame->linesize[0];
     int ePbW = x0 + ctb_size > el_width  ? el_width  - x0 : ctb_size ;
     int ePbH = y0 + ctb_size > el_height ? el_height - y0 : ctb_size;
+    int pixel_shift = s->sps->pixel_shift;
 
     if (s->up_filter_inf.idx == SNR) { /* x1 quality (SNR) scalability */
-        copy_block (s->BL_frame->frame->data[0] + y0 * bl_stride + x0,
-                    ref0->frame->data[0] + y0 * el_stride + x0,
-                    bl_stride, el_stride, ePbH, ePbW );
+        /* nothing to do when ref0 shares the base layer buffers */
+        if (ref0->frame->buf[0] != s->BL_frame->frame->buf[0])
+            copy_block (s->BL_frame->frame->data[0] + y0 * bl_stride + (x0 << pixel_shift),
+                        ref0->frame->data[0] + y0 * el_stride + (x0 << pixel_shift),
+                        bl_stride, el_stride, ePbH, ePbW << pixel_shift);
     } else { /* spatial scalability */
         int bl_edge_bottom, bl_edge_right, ret;
         int bPbW = ((( ePbW + 1 )*s->up_filter_inf.scaleXLum + s->up_filter_inf.addXLum) >> 12) >> 4; /*    FIXME: check if this method is correct  */
@@ -1209,13 +1244,20 @@ static void upsample_block_luma(HEVCContext *s, HEVCFrame *ref0, int x0, int y0)
         bl_edge_right  =  (MAX_EDGE > (bl_width  - bl_x - bPbW))  ? bl_width  - bl_x - bPbW: MAX_EDGE;
         bl_edge_bottom =  (MAX_EDGE > (bl_height - bl_y - bPbH))  ? bl_height - bl_y - bPbH: MAX_EDGE;
 
-        src = s->BL_frame->frame->data[0] + (bl_y - bl_edge_top) * bl_stride + (bl_x - bl_edge_left);
+        src = s->BL_frame->frame->data[0] + (bl_y - bl_edge_top) * bl_stride + ((bl_x - bl_edge_left) << pixel_shift);
         ret = s->vdsp.emulated_edge_up_h(src , bl_stride, &s->sps->scaled_ref_layer_window[ref_layer_id],
                                          bPbW + bl_edge_left + bl_edge_right, bPbH + bl_edge_top + bl_edge_bottom,
                                          bl_edge_left , bl_edge_right, MAX_EDGE-1);
 
         if(ret)
-            src += (MAX_EDGE-1);
+            src += (MAX_EDGE-1) << pixel_shift;
+
+        if (UPSAMPLE_HV(s, upsample_filter_block_luma_hv)) {
+            s->hevcdsp.upsample_filter_block_luma_hv[s->up_filter_inf.idx](dst, el_stride, src + bl_edge_top * bl_stride, bl_stride,
+                                                                           x0, y0, bl_x, bl_y, ePbW, ePbH, bl_height, el_width, el_height,
+                                                                           &s->sps->scaled_ref_layer_window[ref_layer_id], &s->up_filter_inf);
+            goto done;
+        }
 
         tmp0 = s->HEVClc->edge_emu_buffer_up_v+ ((MAX_EDGE - 1) * MAX_EDGE_BUFFER_STRIDE);
 
@@ -1234,6 +1276,7 @@ static void upsample_block_luma(HEVCContext *s, HEVCFrame *ref0, int x0, int y0)
                                                                       &s->sps->scaled_ref_layer_window[ref_layer_id], &s->up_filter_inf);
 
     }
+done:
     s->is_upsampled[(y0 / ctb_size * s->sps->ctb_width) + (x0 / ctb_size)] = 1;
 }
 
@@ -1253,12 +1296,14 @@ static void upsample_block_mc(HEVCContext *s, HEVCFrame *ref0, int x0, int y0) {
     int ePbH = y0 + ctb_size > el_height ? el_height - y0 : ctb_size;
     int bl_stride = s->BL_frame->frame->linesize[1];
     int el_stride = ref0->frame->linesize[1];
+    int pixel_shift = s->sps->pixel_shift;
 
     if (s->up_filter_inf.idx == SNR) {
-        for (cr = 1; cr <= 2; cr++)
-            copy_block(s->BL_frame->frame->data[cr] + y0 * bl_stride + x0,
-                       ref0->frame->data[cr] + y0 * el_stride + x0,
-                       bl_stride, el_stride, ePbH, ePbW );
+        if (ref0->frame->buf[0] != s->BL_frame->frame->buf[0])
+            for (cr = 1; cr <= 2; cr++)
+                copy_block(s->BL_frame->frame->data[cr] + y0 * bl_stride + (x0 << pixel_shift),
+                           ref0->frame->data[cr] + y0 * el_stride + (x0 << pixel_shift),
+                           bl_stride, el_stride, ePbH, ePbW << pixel_shift);
     } else {
         int bl_edge_right, bl_edge_bottom;
         int bPbW = ((( ePbW + 1 ) * s->up_filter_inf.scaleXLum + s->up_filter_inf.addXLum) >> 12)  >> 4;    /*    FIXME: check if this method is correct  */
@@ -1280,13 +1325,20 @@ static void upsample_block_mc(HEVCContext *s, HEVCFrame *ref0, int x0, int y0) {
         bl_edge_bottom = MAX_EDGE_CR < (bl_height - bl_y - bPbH) ? MAX_EDGE_CR:bl_height - bl_y - bPbH;
 
         for (cr = 1; cr <= 2; cr++) {
-            src = s->BL_frame->frame->data[cr]+ (bl_y-bl_edge_top)*bl_stride+(bl_x-bl_edge_left);
+            src = s->BL_frame->frame->data[cr]+ (bl_y-bl_edge_top)*bl_stride+((bl_x-bl_edge_left) << pixel_shift);
             ret = s->vdsp.emulated_edge_up_h(   src , bl_stride,
                                              &s->sps->scaled_ref_layer_window[ref_layer_id],
                                              bPbW + bl_edge_left+bl_edge_right, bPbH + bl_edge_top + bl_edge_bottom,
                                              bl_edge_left , bl_edge_right, MAX_EDGE_CR-1);
             if(ret)
-                src += (MAX_EDGE_CR - 1);
+                src += (MAX_EDGE_CR - 1) << pixel_shift;
+
+            if (UPSAMPLE_HV(s, upsample_filter_block_cr_hv)) {
+                s->hevcdsp.upsample_filter_block_cr_hv[s->up_filter_inf.idx](ref0->frame->data[cr], el_stride, src + bl_edge_top * bl_stride, bl_stride,
+                                                                             x0, y0, bl_x, bl_y, ePbW, ePbH, bl_height, el_width, el_height,
+                                                                             &s->sps->scaled_ref_layer_window[ref_layer_id], &s->up_filter_inf);
+                continue;
+            }
 
             tmp0 = s->HEVClc->edge_emu_buffer_up_v+ ((MAX_EDGE_CR - 1) * MAX_EDGE_BUFFER_STRIDE);
 
@@ -1338,9 +1390,6 @@ void ff_upscale_mv_block(HEVCContext *s, int ctb_x, int ctb_y) {
                             refEL->tab_mvf[pre_unit].mv[list].x  = av_clip_c( (s->sh.ScalingFactor[s->nuh_layer_id][0] * refBL->tab_mvf[Ref_pre_unit].mv[list].x + 127 + (s->sh.ScalingFactor[s->nuh_layer_id][0] * refBL->tab_mvf[Ref_pre_unit].mv[list].x < 0)) >> 8 , -32768, 32767);
                             refEL->tab_mvf[pre_unit].mv[list].y = av_clip_c( (s->sh.ScalingFactor[s->nuh_layer_id][1] * refBL->tab_mvf[Ref_pre_unit].mv[list].y + 127 + (s->sh.ScalingFactor[s->nuh_layer_id][1] * refBL->tab_mvf[Ref_pre_unit].mv[list].y < 0)) >> 8, -32768, 32767);
                             refEL->tab_mvf[pre_unit].ref_idx[list] = refBL->tab_mvf[Ref_pre_unit].ref_idx[list];
-#ifdef TEST_MV_POC
-                            refEL->tab_mvf[pre_unit].poc[list] = refBL->tab_mvf[Ref_pre_unit].poc[list];
-#endif
                             refEL->tab_mvf[pre_unit].pred_flag = refBL->tab_mvf[Ref_pre_unit].pred_flag;
                         }
                     }
@@ -1367,6 +1416,41 @@ void ff_upscale_mv_block(HEVCContext *s, int ctb_x, int ctb_y) {
     }
 }
 
+/* Number of base layer luma rows that must be decoded before the
+ * enhancement layer CTB starting at row y0 can be upsampled; mirrors the
+ * windows read by ff_upscale_mv_block() and upsample_block_luma/mc(). */
+static int bl_rows_needed(HEVCContext *s, HEVCFrame *ref0, int y0)
+{
+    const UpsamplInf *up = &s->up_filter_inf;
+    int ctb_size  = 1 << s->sps->log2_ctb_size;
+    int top       = s->sps->pic_conf_win.top_offset;
+    int bl_height = s->BL_frame->frame->coded_height;
+    int ePbH      = FFMIN(ctb_size, s->sps->height - y0);
+    int y_mv      = FFMIN(y0 + ePbH + 7, s->sps->height - 1);
+    int rows      = (((y_mv - top) * up->scaleYLum + (1 << 15)) >> 16) + 5;
+
+    /* an SNR reference sharing the BL buffers is waited on by MC itself */
+    if (ref0->frame->buf[0] != s->BL_frame->frame->buf[0]) {
+        int y0_c   = y0 >> 1;
+        int ePbH_c = FFMIN(ctb_size >> 1, (s->sps->height >> 1) - y0_c);
+        int bl_y   = (((y0   - top)        * up->scaleYLum + up->addYLum) >> 12) >> 4;
+        int bl_y_c = (((((y0_c - (top >> 1)) * up->scaleYLum + up->addYLum) >> 12) - 4) >> 4);
+
+        rows = FFMAX(rows, bl_y + ((((ePbH + 2) * up->scaleYLum + up->addYLum) >> 12) >> 4) + MAX_EDGE);
+        rows = FFMAX(rows, (bl_y_c + ((((ePbH_c + 2) * up->scaleYLum + up->addYLum) >> 12) >> 4) + MAX_EDGE_CR) << 1);
+    }
+    return FFMIN(rows, bl_height);
+}
+
+static void upsample_ctb(HEVCContext *s, HEVCFrame *ref0, int ctb_x, int ctb_y)
+{
+    if (s->threads_type & FF_THREAD_FRAME)
+        ff_thread_await_progress(&s->BL_frame->tf, bl_rows_needed(s, ref0, ctb_y), 0);
+    ff_upscale_mv_block(s, ctb_x, ctb_y);
+    upsample_block_mc  (s, ref0, ctb_x >> 1, ctb_y >> 1);
+    upsample_block_luma(s, ref0, ctb_x     , ctb_y);
+}
+
 void ff_upsample_block(HEVCContext *s, HEVCFrame *ref0, int x0, int y0, int nPbW, int nPbH) {
 
     int ctb_size =  1<<s->sps->log2_ctb_size;
@@ -1376,51 +1460,27 @@ void ff_upsample_block(HEVCContext *s, HEVCFrame *ref0, int x0, int y0, int nPbW
 
     if ((x0 - ctb_x0) < MAX_EDGE &&
         ctb_x0 > ctb_size        &&
-        !s->is_upsampled[(ctb_y0 / ctb_size * s->sps->ctb_width)+((ctb_x0 - ctb_size) / ctb_size)]){
-        ff_upscale_mv_block(s, ctb_x0 - ctb_size            , ctb_y0);
-        upsample_block_mc  (s, ref0, (ctb_x0-ctb_size) >> 1 , ctb_y0 >> 1);
-        upsample_block_luma(s, ref0, ctb_x0-ctb_size        , ctb_y0);
-    }
+        !s->is_upsampled[(ctb_y0 / ctb_size * s->sps->ctb_width)+((ctb_x0 - ctb_size) / ctb_size)])
+        upsample_ctb(s, ref0, ctb_x0 - ctb_size, ctb_y0);
 
     if ((y0 - ctb_y0) < MAX_EDGE &&
         ctb_y0 > ctb_size &&
-        !s->is_upsampled[((ctb_y0 - ctb_size) / ctb_size * s->sps->ctb_width) + (ctb_x0 / ctb_size)]){
-        ff_upscale_mv_block(s, ctb_x0            , ctb_y0 - ctb_size);
-        upsample_block_mc  (s, ref0, ctb_x0 >> 1 , (ctb_y0 - ctb_size) >> 1);
-        upsample_block_luma(s, ref0, ctb_x0      , ctb_y0 - ctb_size);
-    }
-
-    if(!s->is_upsampled[(ctb_y0 / ctb_size * s->sps->ctb_width) + (ctb_x0 / ctb_size)]){
-        ff_upscale_mv_block(s, ctb_x0           , ctb_y0);
-        upsample_block_mc  (s, ref0, ctb_x0 >> 1, ctb_y0 >> 1);
-        upsample_block_luma(s, ref0, ctb_x0     , ctb_y0);
+        !s->is_upsampled[((ctb_y0 - ctb_size) / ctb_size * s->sps->ctb_width) + (ctb_x0 / ctb_size)])
+        upsample_ctb(s, ref0, ctb_x0, ctb_y0 - ctb_size);
 
-    }
+    if(!s->is_upsampled[(ctb_y0 / ctb_size * s->sps->ctb_width) + (ctb_x0 / ctb_size)])
+        upsample_ctb(s, ref0, ctb_x0, ctb_y0);
 
     if((((x0 + nPbW + MAX_EDGE) >> log2_ctb) << log2_ctb) > ctb_x0 && ((ctb_x0 + ctb_size) < s->sps->width) &&
-       !s->is_upsampled[(ctb_y0 / ctb_size * s->sps->ctb_width) + ((ctb_x0 + ctb_size) / ctb_size)]){
-        ff_upscale_mv_block(s, ctb_x0 + ctb_size, ctb_y0);
-        upsample_block_mc  (s, ref0, (ctb_x0 + ctb_size) >> 1, ctb_y0 >> 1);
-        upsample_block_luma(s, ref0, ctb_x0 + ctb_size       , ctb_y0);
-    }
+       !s->is_upsampled[(ctb_y0 / ctb_size * s->sps->ctb_width) + ((ctb_x0 + ctb_size) / ctb_size)])
+        upsample_ctb(s, ref0, ctb_x0 + ctb_size, ctb_y0);
 
     if((((y0 + nPbH + MAX_EDGE) >> log2_ctb) << log2_ctb) > ctb_y0 &&
        ((ctb_y0 + ctb_size) < s->sps->height)) {
-        if (!s->is_upsampled[((ctb_y0 + ctb_size) / ctb_size * s->sps->ctb_width) + (ctb_x0 / ctb_size)]){
-            if (s->threads_type & FF_THREAD_FRAME ) {
-                int bl_y = ctb_y0 + ctb_size + ctb_size * 2 + 9;
-                bl_y = (( (bl_y  - s->sps->pic_conf_win.top_offset) * s->up_filter_inf.scaleYLum + s->up_filter_inf.addYLum) >> 12) >> 4;
-                ff_thread_await_progress(&s->BL_frame->tf, bl_y, 0);
-            }
-            ff_upscale_mv_block(s, ctb_x0, ctb_y0 + ctb_size);
-            upsample_block_mc  (s, ref0, ctb_x0 >> 1, (ctb_y0 + ctb_size) >> 1);
-            upsample_block_luma(s, ref0, ctb_x0     , ctb_y0 + ctb_size);
-        }
+        if (!s->is_upsampled[((ctb_y0 + ctb_size) / ctb_size * s->sps->ctb_width) + (ctb_x0 / ctb_size)])
+            upsample_ctb(s, ref0, ctb_x0, ctb_y0 + ctb_size);
         if((((x0 + nPbW + MAX_EDGE) >> log2_ctb) << log2_ctb) > ctb_x0 && ((ctb_x0 + ctb_size) < s->sps->width) &&
-           !s->is_upsampled[((ctb_y0 + ctb_size) / ctb_size * s->sps->ctb_width) + ((ctb_x0 + ctb_size) / ctb_size)]){
-            ff_upscale_mv_block(s, ctb_x0 + ctb_size, ctb_y0 + ctb_size);
-            upsample_block_mc  (s, ref0, (ctb_x0 + ctb_size) >> 1, (ctb_y0 + ctb_size) >> 1);
-            upsample_block_luma(s, ref0, (ctb_x0 + ctb_size)    , ctb_y0 + ctb_size);
-        }
+           !s->is_upsampled[((ctb_y0 + ctb_size) / ctb_size * s->sps->ctb_width) + ((ctb_x0 + ctb_size) / ctb_size)])
+            upsample_ctb(s, ref0, ctb_x0 + ctb_size, ctb_y0 + ctb_size);
     }
 }
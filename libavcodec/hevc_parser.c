@@ -37,19 +37,54 @@ typedef struct HEVCParseContext {
  * Find the end of the current frame in the bitstream.
  * @return the position of the first byte of the next frame, or END_NOT_FOUND
  */
+/* Shifts buf[from..to) into the parser state. */
+static uint64_t shift_state(uint64_t state, const uint8_t *buf, int from, int to)
+{
+    if (to - from >= 8)
+        return AV_RB64(buf + to - 8);
+    for (; from < to; from++)
+        state = (state << 8) | buf[from];
+    return state;
+}
+
+/* Offset of the first 00 00 01 at or after buf + from, size if none. */
+static int find_start_code(const uint8_t *buf, int from, int size)
+{
+    while (from < size) {
+        from += av_hevc_find_nal_marker(buf + from, size - from);
+        if (from + 2 < size && buf[from + 2] == 1)
+            return from;
+        from++;
+    }
+    return size;
+}
+
 static int hevc_find_frame_end(AVCodecParserContext *s, const uint8_t *buf,
                                int buf_size)
 {
-    int i;
+    int i = 0;
     ParseContext *pc = &((HEVCParseContext *)s->priv_data)->pc;
 
-    for (i = 0; i < buf_size; i++) {
+    while (i < buf_size) {
         int nut, layer_id;
 
-        pc->state64 = (pc->state64 << 8) | buf[i];
+        /* The first 5 bytes can complete a start code of the previous
+         * buffer, past them jump to the byte after the next NAL header. */
+        if (i >= 5) {
+            int next = find_start_code(buf, i - 5, buf_size) + 5;
+            if (next >= buf_size) {
+                pc->state64 = shift_state(pc->state64, buf, i, buf_size);
+                break;
+            }
+            pc->state64 = shift_state(pc->state64, buf, i, next + 1);
+            i = next;
+        } else
+            pc->state64 = (pc->state64 << 8) | buf[i];
 
-        if (((pc->state64 >> 3 * 8) & 0xFFFFFF) != START_CODE)
+        if (((pc->state64 >> 3 * 8) & 0xFFFFFF) != START_CODE) {
+            i++;
             continue;
+        }
 
         nut = (pc->state64 >> 2 * 8 + 1) & 0x3F;
         layer_id  =  (((pc->state64 >> 2 * 8) &0x01)<<5) + (((pc->state64 >> 1 * 8)&0xF8)>>3);
@@ -73,6 +108,7 @@ static int hevc_find_frame_end(AVCodecParserContext *s, const uint8_t *buf,
                 }
             }
         }
+        i++;
     }
 
     return END_NOT_FOUND;
@@ -1123,6 +1123,11 @@ int ff_hevc_decode_nal_vps(HEVCContext *s)
 
     vps->vps_max_layers               = get_bits(gb, 6) + 1;
     print_cabac("vps_max_layers_minus1", vps->vps_max_layers-1);
+    if (vps->vps_max_layers > MAX_LAYERS) {
+        av_log(s->avctx, AV_LOG_ERROR, "vps_max_layers out of range: %d\n",
+               vps->vps_max_layers);
+        goto err;
+    }
     vps->vps_max_sub_layers           = get_bits(gb, 3) + 1;
     print_cabac("vps_max_sub_layers_minus1", vps->vps_max_sub_layers-1);
     vps->vps_temporal_id_nesting_flag = get_bits1(gb);
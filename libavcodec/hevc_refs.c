@@ -21,6 +21,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "libavutil/atomic.h"
 #include "libavutil/pixdesc.h"
 
 #include "internal.h"
@@ -72,16 +73,125 @@ void ff_hevc_flush_dpb(HEVCContext *s)
         ff_hevc_unref_frame(s, &s->DPB[i], ~0);
 }
 
-static HEVCFrame *alloc_frame(HEVCContext *s)
+#define MAX_SHARED_POOLS 64
+
+typedef struct SharedPool {
+    AVBufferPool *pool;
+    int tag;
+    int format;
+    int width;
+    int height;
+    int size;
+    AVBufferRef* (*alloc)(int size);
+    int users;
+} SharedPool;
+
+/* process wide, the entries only change under shared_pools_lock */
+static SharedPool shared_pools[MAX_SHARED_POOLS];
+static void * volatile shared_pools_lock;
+
+static void lock_shared_pools(void)
+{
+    while (avpriv_atomic_ptr_cas(&shared_pools_lock, NULL, (void *) &shared_pools_lock))
+        ;
+}
+
+static void unlock_shared_pools(void)
+{
+    avpriv_atomic_ptr_cas(&shared_pools_lock, (void *) &shared_pools_lock, NULL);
+}
+
+AVBufferPool *av_hevc_shared_pool_init(int tag, int format, int width, int height, int size,
+                                       AVBufferRef* (*alloc)(int size))
+{
+    SharedPool   *entry = NULL;
+    AVBufferPool *pool  = NULL;
+    int i;
+
+    lock_shared_pools();
+    for (i = 0; i < MAX_SHARED_POOLS; i++) {
+        SharedPool *cur = &shared_pools[i];
+        if (!cur->pool) {
+            if (!entry)
+                entry = cur;
+        } else if (cur->tag   == tag   && cur->format == format &&
+                   cur->width == width && cur->height == height && cur->size == size &&
+                   cur->alloc == alloc) {
+            cur->users++;
+            pool = cur->pool;
+            break;
+        }
+    }
+    if (!pool) {
+        /* with the table full the pool is private to the caller */
+        pool = av_buffer_pool_init(size, alloc);
+        if (pool && entry) {
+            entry->pool   = pool;
+            entry->tag    = tag;
+            entry->format = format;
+            entry->width  = width;
+            entry->height = height;
+            entry->size   = size;
+            entry->alloc  = alloc;
+            entry->users  = 1;
+        }
+    }
+    unlock_shared_pools();
+    return pool;
+}
+
+void av_hevc_shared_pool_uninit(AVBufferPool **pool)
+{
+    int i;
+
+    if (!*pool)
+        return;
+    lock_shared_pools();
+    for (i = 0; i < MAX_SHARED_POOLS; i++) {
+        if (shared_pools[i].pool == *pool) {
+            if (--shared_pools[i].users) {
+                unlock_shared_pools();
+                *pool = NULL;
+                return;
+            }
+            shared_pools[i].pool = NULL;
+            break;
+        }
+    }
+    unlock_shared_pools();
+    av_buffer_pool_uninit(pool);
+}
+
+int av_hevc_shared_pool_users(int tag)
+{
+    int i, users = 0;
+
+    lock_shared_pools();
+    for (i = 0; i < MAX_SHARED_POOLS; i++)
+        if (shared_pools[i].pool && shared_pools[i].tag == tag)
+            users += shared_pools[i].users;
+    unlock_shared_pools();
+    return users;
+}
+
+/* src, if set, is referenced instead of allocating new picture buffers */
+static HEVCFrame *alloc_frame(HEVCContext *s, ThreadFrame *src)
 {
+    int nb_frames = FF_ARRAY_ELEMS(s->DPB);
     int i, j, ret;
-    for (i = 0; i < FF_ARRAY_ELEMS(s->DPB); i++) {
+
+    if (s->bounded_dpb && s->dpb_frames)
+        nb_frames = FFMIN(s->dpb_frames, nb_frames);
+    for (i = 0; i < nb_frames; i++) {
         HEVCFrame *frame = &s->DPB[i];
         if (frame->frame->buf[0])
             continue;
 
-        ret = ff_thread_get_buffer(s->avctx, &frame->tf,
-                                   AV_GET_BUFFER_FLAG_REF);
+        if (src)
+            ret = ff_thread_ref_frame(&frame->tf, src);
+        else
+            ret = ff_thread_get_buffer(s->avctx, &frame->tf,
+                                       AV_GET_BUFFER_FLAG_REF);
         if (ret < 0)
             return NULL;
 
@@ -130,7 +240,7 @@ int ff_hevc_set_new_ref(HEVCContext *s, AVFrame **frame, int poc)
         }
     }
 
-    ref = alloc_frame(s);
+    ref = alloc_frame(s, NULL);
     if (!ref)
         return AVERROR(ENOMEM);
 
@@ -148,8 +258,9 @@ int ff_hevc_set_new_ref(HEVCContext *s, AVFrame **frame, int poc)
 #ifdef REF_IDX_FRAMEWORK
 int ff_hevc_set_new_iter_layer_ref(HEVCContext *s, AVFrame **frame, int poc)
 {
+    const AVFrame *bl = s->BL_frame->frame;
     HEVCFrame *ref;
-    int i;
+    int i, shared;
     /* check that this POC doesn't already exist */
     for (i = 0; i < FF_ARRAY_ELEMS(s->DPB); i++) {
         HEVCFrame *frame = &s->DPB[i];
@@ -162,7 +273,15 @@ int ff_hevc_set_new_iter_layer_ref(HEVCContext *s, AVFrame **frame, int poc)
         }
     }
     
-    ref = alloc_frame(s);
+    /* With SNR scalability the inter-layer reference is the base layer
+     * picture itself: reference its buffers and its decoding progress
+     * instead of copying it block by block. */
+    shared = s->up_filter_inf.idx == SNR        &&
+             bl->format       == s->sps->pix_fmt &&
+             bl->coded_width  == s->sps->width   &&
+             bl->coded_height == s->sps->height;
+
+    ref = alloc_frame(s, shared ? &s->BL_frame->tf : NULL);
     if (!ref)
         return AVERROR(ENOMEM);
     
@@ -173,7 +292,7 @@ int ff_hevc_set_new_iter_layer_ref(HEVCContext *s, AVFrame **frame, int poc)
     ref->flags          = HEVC_FRAME_FLAG_LONG_REF;
     ref->sequence       = s->seq_decode;
     ref->window         = s->sps->output_window;
-    if (s->threads_type & FF_THREAD_FRAME)
+    if ((s->threads_type & FF_THREAD_FRAME) && !shared)
         ff_thread_report_progress(&s->inter_layer_ref->tf, INT_MAX, 0);
 
     return 0;
@@ -372,54 +491,46 @@ static HEVCFrame *find_ref_idx(HEVCContext *s, int poc)
 
 #ifdef SVC_EXTENSION
 
-#if ACTIVE_PU_UPSAMPLING
-static void set_refindex_data(HEVCContext *s){
+/* The upsampled motion field of the inter-layer reference keeps the base
+ * layer ref_idx values, so its lists must keep the base layer order: POCs
+ * are resolved through them when it is used as collocated picture. */
+static void copy_il_ref_lists(HEVCContext *s)
+{
+    HEVCFrame *refBL = s->BL_frame;
+    HEVCFrame *refEL = s->inter_layer_ref;
+    int nb_list = s->sh.slice_type == B_SLICE ? 2 : 1;
     int list, i;
-    HEVCFrame  *refBL, *refEL, *ref;
-    int nb_list = s->sh.slice_type==B_SLICE ? 2:1;
-    refBL = s->BL_frame;
-     
-    init_il_slice_rpl(s);
-    refEL = s->inter_layer_ref;
-    for( list=0; list < nb_list; list++) {
-        refEL->refPicList[s->slice_idx][list].nb_refs = 0;
-        for(i=0; refBL->refPicList[s->slice_idx] && i< refBL->refPicList[s->slice_idx][list].nb_refs; i++) {
-            ref = find_ref_idx(s, refBL->refPicList[s->slice_idx][list].list[i]);
-            if(ref) {
-                refEL->refPicList[s->slice_idx][list].list[refEL->refPicList[s->slice_idx][list].nb_refs]           = refBL->refPicList[s->slice_idx][list].list[i];
-                refEL->refPicList[s->slice_idx][list].ref[refEL->refPicList[s->slice_idx][list].nb_refs]            = ref;
-                refEL->refPicList[s->slice_idx][list].isLongTerm[refEL->refPicList[s->slice_idx][list].nb_refs++]   = refBL->refPicList[s->slice_idx][list].isLongTerm[i];
-            }
+
+    for (list = 0; list < nb_list; list++) {
+        RefPicList *rplEL = &refEL->refPicList[s->slice_idx][list];
+        RefPicList *rplBL = refBL->refPicList[s->slice_idx] ?
+                            &refBL->refPicList[s->slice_idx][list] : NULL;
+
+        rplEL->nb_refs = rplBL ? rplBL->nb_refs : 0;
+        for (i = 0; i < rplEL->nb_refs; i++) {
+            rplEL->list[i]       = rplBL->list[i];
+            rplEL->ref[i]        = find_ref_idx(s, rplBL->list[i]);
+            rplEL->isLongTerm[i] = rplBL->isLongTerm[i];
         }
     }
 }
+
+#if ACTIVE_PU_UPSAMPLING
+static void set_refindex_data(HEVCContext *s){
+    init_il_slice_rpl(s);
+    copy_il_ref_lists(s);
+}
 #else
 static void scale_upsampled_mv_field(AVCodecContext *avctxt, void *input_ctb_row) {
     HEVCContext *s = avctxt->priv_data;
 
-    int *index   = input_ctb_row, i, list;
+    int *index   = input_ctb_row, i;
     int ctb_size = 1 << s->sps->log2_ctb_size;
-    int nb_list = s->sh.slice_type==B_SLICE ? 2:1;
-
-    
-
-    HEVCFrame *refBL = s->BL_frame, *ref;
-    HEVCFrame *refEL = s->inter_layer_ref;
     int start = (*index) * ctb_size;
 
     if( *index ==0 ) {
         init_il_slice_rpl(s);
-        for( list=0; list < nb_list; list++) {
-            refEL->refPicList[s->slice_idx][list].nb_refs = 0;
-            for(i=0; refBL->refPicList[s->slice_idx] && i< refBL->refPicList[s->slice_idx][list].nb_refs; i++) {
-                ref = find_ref_idx(s, refBL->refPicList[s->slice_idx][list].list[i]);
-                if(ref) {
-                    refEL->refPicList[s->slice_idx][list].list[refEL->refPicList[s->slice_idx][list].nb_refs]           = refBL->refPicList[s->slice_idx][list].list[i];
-                    refEL->refPicList[s->slice_idx][list].ref[refEL->refPicList[s->slice_idx][list].nb_refs]            = ref;
-                    refEL->refPicList[s->slice_idx][list].isLongTerm[refEL->refPicList[s->slice_idx][list].nb_refs++]   = refBL->refPicList[s->slice_idx][list].isLongTerm[i];
-                }
-            }
-        }
+        copy_il_ref_lists(s);
     }
     for(i=0; i < s->sps->ctb_width; i++)
         ff_upscale_mv_block(s,  i*ctb_size, start);
@@ -546,7 +657,7 @@ static HEVCFrame *generate_missing_ref(HEVCContext *s, int poc)
     int x, y; 
 #endif
 
-    frame = alloc_frame(s);
+    frame = alloc_frame(s, NULL);
     if (!frame)
         return NULL;
 
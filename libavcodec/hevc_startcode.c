@@ -0,0 +1,75 @@
+/*
+ * HEVC start code and emulation prevention scanner
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/cpu.h"
+#include "libavutil/intreadwrite.h"
+#include "avcodec.h"
+#include "hevc.h"
+#if ARCH_X86
+#include "libavutil/x86/cpu.h"
+#include "x86/hevcdsp.h"
+#endif
+
+/* A marker starts with a zero byte, so the 8-byte words without any can be
+ * skipped whole: the bytes of a word with a zero are tested one by one. */
+static int find_nal_marker_c(const uint8_t *buf, int size)
+{
+    int i = 0;
+
+#if HAVE_FAST_UNALIGNED && HAVE_FAST_64BIT
+    for (; i + 10 <= size; ) {
+        uint64_t x = AV_RN64(buf + i);
+        int end;
+
+        if (!((x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL)) {
+            i += 8;
+            continue;
+        }
+        for (end = i + 8; i < end; i++)
+            if (!buf[i] && !buf[i + 1] && buf[i + 2] <= 3)
+                return i;
+    }
+#endif
+    for (; i + 2 < size; i++)
+        if (!buf[i] && !buf[i + 1] && buf[i + 2] <= 3)
+            return i;
+    return size;
+}
+
+int (*ff_hevc_find_nal_marker_func(int cpu_flags))(const uint8_t *buf, int size)
+{
+#if ARCH_X86
+#if HAVE_AVX2
+    if (EXTERNAL_AVX2(cpu_flags))
+        return ff_hevc_find_nal_marker_avx2;
+#endif
+#if HAVE_SSE2
+    if (EXTERNAL_SSE2(cpu_flags))
+        return ff_hevc_find_nal_marker_sse2;
+#endif
+#endif
+    return find_nal_marker_c;
+}
+
+int av_hevc_find_nal_marker(const uint8_t *buf, int size)
+{
+    return ff_hevc_find_nal_marker_func(av_get_cpu_flags())(buf, size);
+}
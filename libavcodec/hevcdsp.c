@@ -876,7 +876,7 @@ void fastInverseDST7_B32(int16_t *coeff, int16_t *block, int shift, int line, in
 #endif
 
 
-static const int8_t transform[32][32] = {
+DECLARE_ALIGNED(16, const int8_t, ff_hevc_transform)[32][32] = {
     { 64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,
       64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64,  64 },
     { 90,  90,  88,  85,  82,  78,  73,  67,  61,  54,  46,  38,  31,  22,  13,   4,
@@ -1304,6 +1304,8 @@ int i = 0;
     hevcdsp->upsample_filter_block_cr_v[0]   = FUNC(upsample_filter_block_cr_v_all, depth); \
     hevcdsp->upsample_filter_block_cr_v[1]   = FUNC(upsample_filter_block_cr_v_x2, depth); \
     hevcdsp->upsample_filter_block_cr_v[2]   = FUNC(upsample_filter_block_cr_v_x1_5, depth); \
+    memset(hevcdsp->upsample_filter_block_luma_hv, 0, sizeof(hevcdsp->upsample_filter_block_luma_hv)); \
+    memset(hevcdsp->upsample_filter_block_cr_hv,   0, sizeof(hevcdsp->upsample_filter_block_cr_hv));   \
     
     switch (bit_depth) {
     case 9:
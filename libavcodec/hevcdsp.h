@@ -26,6 +26,7 @@
 
 #ifndef AVCODEC_HEVCDSP_H
 #define AVCODEC_HEVCDSP_H
+struct SAOParams;
 struct AVFrame;
 struct UpsamplInf;
 struct HEVCWindow;
@@ -37,7 +38,10 @@ struct HEVCWindow;
 
 #define MAX_EDGE  4
 #define MAX_EDGE_CR  2
-#define N_SHIFT (20-8)
+/* the horizontal pass of the upsampling keeps 14 bits, the vertical pass
+ * brings them back to BIT_DEPTH (shift1 and shift2 in the SHVC spec) */
+#define H_SHIFT (BIT_DEPTH - 8)
+#define N_SHIFT (20 - BIT_DEPTH)
 #define I_OFFSET (1 << (N_SHIFT - 1))
 
 
@@ -57,6 +61,7 @@ typedef struct HEVCDSPContext {
 
     void (*idct_dc[4])(int16_t *coeffs);
 
+    /* filters _dst in place and saves the unfiltered samples to _src */
     void (*sao_band_filter)( uint8_t *_dst, uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, struct SAOParams *sao, int *borders, int width, int height, int c_idx);
 
     void (*sao_edge_filter[2])(uint8_t *_dst, uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,  struct SAOParams *sao, int *borders, int _width, int _height, int c_idx, uint8_t *vert_edge, uint8_t *horiz_edge, uint8_t *diag_edge);
@@ -121,12 +126,26 @@ typedef struct HEVCDSPContext {
                                            uint8_t *dst, ptrdiff_t dststride, int16_t *_src, ptrdiff_t _srcstride,
                                            int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                            const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info);
+    /* Both passes in one call, without the intermediate edge extension:
+     * src points at (x_BL, y_BL) of the base layer plane, whose rows are
+     * clamped to [0, bl_height). Optional, NULL when not implemented. */
+    void (*upsample_filter_block_luma_hv[3])(
+                                         uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                                         int x_EL, int y_EL, int x_BL, int y_BL, int block_w, int block_h,
+                                         int bl_height, int widthEL, int heightEL,
+                                         const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info);
+    void (*upsample_filter_block_cr_hv[3])(
+                                           uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                                           int x_EL, int y_EL, int x_BL, int y_BL, int block_w, int block_h,
+                                           int bl_height, int widthEL, int heightEL,
+                                           const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info);
 } HEVCDSPContext;
 
 void ff_hevc_dsp_init(HEVCDSPContext *hpc, int bit_depth);
 
 extern const int8_t ff_hevc_epel_filters[7][4];
 extern const int8_t ff_hevc_qpel_filters[3][16];
+extern const int8_t ff_hevc_transform[32][32];
 
 #if COM16_C806_EMT
 // ******************************************** Mode intra et SubSet ********************************************
@@ -227,7 +227,7 @@ static void FUNC(transform_4x4_luma)(int16_t *coeffs)
         int o_8[4] = { 0 };                                                    \
         for (i = 0; i < 4; i++)                                                \
             for (j = 1; j < end; j += 2)                                       \
-                o_8[i] += transform[4 * j][i] * src[j * sstep];                \
+                o_8[i] += ff_hevc_transform[4 * j][i] * src[j * sstep];        \
         TR_4(e_8, src, 1, 2 * sstep, SET, 4);                                  \
                                                                                \
         for (i = 0; i < 4; i++) {                                              \
@@ -243,7 +243,7 @@ static void FUNC(transform_4x4_luma)(int16_t *coeffs)
         int o_16[8] = { 0 };                                                   \
         for (i = 0; i < 8; i++)                                                \
             for (j = 1; j < end; j += 2)                                       \
-                o_16[i] += transform[2 * j][i] * src[j * sstep];               \
+                o_16[i] += ff_hevc_transform[2 * j][i] * src[j * sstep];       \
         TR_8(e_16, src, 1, 2 * sstep, SET, 8);                                 \
                                                                                \
         for (i = 0; i < 8; i++) {                                              \
@@ -259,7 +259,7 @@ static void FUNC(transform_4x4_luma)(int16_t *coeffs)
         int o_32[16] = { 0 };                                                  \
         for (i = 0; i < 16; i++)                                               \
             for (j = 1; j < end; j += 2)                                       \
-                o_32[i] += transform[j][i] * src[j * sstep];                   \
+                o_32[i] += ff_hevc_transform[j][i] * src[j * sstep];           \
         TR_16(e_32, src, 1, 2 * sstep, SET, end/2);                            \
                                                                                \
         for (i = 0; i < 16; i++) {                                             \
@@ -357,8 +357,11 @@ static void FUNC(sao_band_filter_0)(uint8_t *_dst, uint8_t *_src,
     for (k = 0; k < 4; k++)
         offset_table[(k + sao_left_class) & 31] = sao_offset_val[k + 1];
     for (y = 0; y < height; y++) {
-        for (x = 0; x < width; x++)
-            dst[x] = av_clip_pixel(src[x] + offset_table[src[x] >> shift]);
+        for (x = 0; x < width; x++) {
+            int v  = dst[x];
+            src[x] = v;
+            dst[x] = av_clip_pixel(v + offset_table[v >> shift]);
+        }
         dst += stride_dst;
         src += stride_src;
     }
@@ -1834,6 +1837,7 @@ static void FUNC(hevc_v_loop_filter_luma)(uint8_t *pix, ptrdiff_t stride,
 static void FUNC(upsample_filter_block_luma_h_all)( int16_t *_dst, ptrdiff_t _dststride, uint8_t *_src, ptrdiff_t _srcstride,
                                         int x_EL, int x_BL, int block_w, int block_h, int widthEL,
                                         const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info/*, int y_BL, short * buffer_frame*/) {
+    ptrdiff_t srcstride = _srcstride / sizeof(pixel);
     int rightEndL  = widthEL - Enhscal->right_offset;
     int leftStartL = Enhscal->left_offset;
     int x, i, j, phase, refPos16, refPos;
@@ -1853,10 +1857,10 @@ static void FUNC(upsample_filter_block_luma_h_all)( int16_t *_dst, ptrdiff_t _ds
         src_tmp  = src   + refPos;
         //srcY1 = buffer_frame + y_BL*widthEL+ x_EL+i;
         for( j = 0; j < block_h ; j++ ) {
-            *dst_tmp  = LumHor_FILTER_Block(src_tmp, coeff);
+            *dst_tmp  = LumHor_FILTER_Block(src_tmp, coeff) >> H_SHIFT;
             /*if(*srcY1 != *dst_tmp)
                 printf("--- %d %d %d %d %d %d %d %d %d \n",refPos, i, j, *srcY1, *dst_tmp, src_tmp[-3], src_tmp[-2], src_tmp[-1], src_tmp[0]);*/
-            src_tmp  += _srcstride;
+            src_tmp  += srcstride;
             dst_tmp  += _dststride;
             //srcY1    += widthEL;
         }
@@ -1866,6 +1870,7 @@ static void FUNC(upsample_filter_block_luma_h_all)( int16_t *_dst, ptrdiff_t _ds
 static void FUNC(upsample_filter_block_cr_h_all)(  int16_t *dst, ptrdiff_t dststride, uint8_t *_src, ptrdiff_t _srcstride,
                                                  int x_EL, int x_BL, int block_w, int block_h, int widthEL,
                                                  const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t srcstride = _srcstride / sizeof(pixel);
     int leftStartC = Enhscal->left_offset>>1;
     int rightEndC  = widthEL - (Enhscal->right_offset>>1);
     int x, i, j, phase, refPos16, refPos;
@@ -1882,8 +1887,8 @@ static void FUNC(upsample_filter_block_cr_h_all)(  int16_t *dst, ptrdiff_t dstst
         dst_tmp  = dst  + i;
         src_tmp  = src + refPos;
         for( j = 0; j < block_h ; j++ ) {
-            *dst_tmp   =  CroHor_FILTER_Block(src_tmp, coeff);
-            src_tmp  +=  _srcstride;
+            *dst_tmp   = CroHor_FILTER_Block(src_tmp, coeff) >> H_SHIFT;
+            src_tmp  +=  srcstride;
             dst_tmp   +=  dststride;
         }
     }
@@ -1893,6 +1898,7 @@ static void FUNC(upsample_filter_block_cr_h_all)(  int16_t *dst, ptrdiff_t dstst
 static void FUNC(upsample_filter_block_luma_v_all)( uint8_t *_dst, ptrdiff_t _dststride, int16_t *_src, ptrdiff_t _srcstride,
                                                    int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                                    const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t stride = _dststride / sizeof(pixel);
     int topStartL  = Enhscal->top_offset;
     int bottomEndL = heightEL - Enhscal->bottom_offset;
     int rightEndL  = widthEL - Enhscal->right_offset;
@@ -1911,7 +1917,7 @@ static void FUNC(upsample_filter_block_luma_v_all)( uint8_t *_dst, ptrdiff_t _ds
         coeff    = up_sample_filter_luma[phase];
         refPos   = (refPos16 >> 4) - y_BL;
         src_tmp  = _src  + refPos  * _srcstride;
-        dst_tmp  =  dst  + (y_EL+j) * _dststride + x_EL;
+        dst_tmp  =  dst  + (y_EL+j) * stride + x_EL;
         for( i = 0; i < block_w; i++ )	{
             *dst_tmp = av_clip_pixel( (LumVer_FILTER_Block(src_tmp, coeff, _srcstride) + I_OFFSET) >> (N_SHIFT));
 
@@ -1931,6 +1937,7 @@ static void FUNC(upsample_filter_block_luma_v_all)( uint8_t *_dst, ptrdiff_t _ds
 static void FUNC(upsample_filter_block_cr_v_all)( uint8_t *_dst, ptrdiff_t dststride, int16_t *_src, ptrdiff_t _srcstride,
                                                  int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                                  const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t stride = dststride / sizeof(pixel);
     int leftStartC = Enhscal->left_offset>>1;
     int rightEndC  = widthEL - (Enhscal->right_offset>>1);
     int topStartC  = Enhscal->top_offset>>1;
@@ -1946,7 +1953,7 @@ static void FUNC(upsample_filter_block_cr_v_all)( uint8_t *_dst, ptrdiff_t dstst
         coeff    = up_sample_filter_chroma[phase];
         refPos   = (refPos16>>4) - y_BL;
         src_tmp  = _src  + refPos  * _srcstride;
-        dst_tmp  =  dst  + y* dststride + x_EL;
+        dst_tmp  =  dst  + y* stride + x_EL;
         for( i = 0; i < block_w; i++ )	{
             *dst_tmp = av_clip_pixel( (CroVer_FILTER_Block(src_tmp, coeff, _srcstride) + I_OFFSET) >> (N_SHIFT));
             if( ((x_EL+i) >= leftStartC) && ((x_EL+i) <= rightEndC-2) )
@@ -1960,6 +1967,7 @@ static void FUNC(upsample_filter_block_cr_v_all)( uint8_t *_dst, ptrdiff_t dstst
 static void FUNC(upsample_filter_block_luma_h_x2)( int16_t *_dst, ptrdiff_t _dststride, uint8_t *_src, ptrdiff_t _srcstride,
                                                   int x_EL, int x_BL, int block_w, int block_h, int widthEL,
                                                   const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t srcstride = _srcstride / sizeof(pixel);
     int rightEndL  = widthEL - Enhscal->right_offset;
     int leftStartL = Enhscal->left_offset;
     int x, i, j;
@@ -1973,8 +1981,8 @@ static void FUNC(upsample_filter_block_luma_h_x2)( int16_t *_dst, ptrdiff_t _dst
         dst_tmp  = _dst  + i;
         src_tmp  = src + ((x-leftStartL)>>1);
         for( j = 0; j < block_h ; j++ ) {
-            *dst_tmp  = LumHor_FILTER_Block(src_tmp, coeff);
-            src_tmp  += _srcstride;
+            *dst_tmp  = LumHor_FILTER_Block(src_tmp, coeff) >> H_SHIFT;
+            src_tmp  += srcstride;
             dst_tmp  += _dststride;
         }
     }
@@ -1983,6 +1991,7 @@ static void FUNC(upsample_filter_block_luma_h_x2)( int16_t *_dst, ptrdiff_t _dst
 static void FUNC(upsample_filter_block_cr_h_x2)(  int16_t *dst, ptrdiff_t dststride, uint8_t *_src, ptrdiff_t _srcstride,
                                                 int x_EL, int x_BL, int block_w, int block_h, int widthEL,
                                                 const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t srcstride = _srcstride / sizeof(pixel);
     int leftStartC = Enhscal->left_offset>>1;
     int rightEndC  = widthEL - (Enhscal->right_offset>>1);
     int x, i, j;
@@ -1996,8 +2005,8 @@ static void FUNC(upsample_filter_block_cr_h_x2)(  int16_t *dst, ptrdiff_t dststr
         dst_tmp  = dst  + i;
         src_tmp  = src + (x>>1) ;
         for( j = 0; j < block_h ; j++ ) {
-            *dst_tmp   =  CroHor_FILTER_Block(src_tmp, coeff);
-            src_tmp  +=  _srcstride;
+            *dst_tmp   = CroHor_FILTER_Block(src_tmp, coeff) >> H_SHIFT;
+            src_tmp  +=  srcstride;
             dst_tmp   +=  dststride;
         }
     }
@@ -2008,13 +2017,14 @@ static void FUNC(upsample_filter_block_cr_h_x2)(  int16_t *dst, ptrdiff_t dststr
 static void FUNC(upsample_filter_block_luma_v_x2)( uint8_t *_dst, ptrdiff_t _dststride, int16_t *_src, ptrdiff_t _srcstride,
                                                   int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                                   const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t stride = _dststride / sizeof(pixel);
     int topStartL  = Enhscal->top_offset;
     int bottomEndL = heightEL - Enhscal->bottom_offset;
     int rightEndL  = widthEL - Enhscal->right_offset;
     int leftStartL = Enhscal->left_offset;
     int y, i, j;
     const int8_t  *   coeff;
-    pixel *dst_tmp, *dst    = (pixel *)_dst + y_EL * _dststride + x_EL;
+    pixel *dst_tmp, *dst    = (pixel *)_dst + y_EL * stride + x_EL;
     int16_t *   src_tmp;
 
     for( j = 0; j < block_h; j++ )	{
@@ -2028,7 +2038,7 @@ static void FUNC(upsample_filter_block_luma_v_x2)( uint8_t *_dst, ptrdiff_t _dst
                 src_tmp++;
             dst_tmp++;
         }
-        dst  +=  _dststride;
+        dst  +=  stride;
     }
 }
 
@@ -2036,6 +2046,7 @@ static void FUNC(upsample_filter_block_luma_v_x2)( uint8_t *_dst, ptrdiff_t _dst
 static void FUNC(upsample_filter_block_cr_v_x2)( uint8_t *_dst, ptrdiff_t dststride, int16_t *_src, ptrdiff_t _srcstride,
                                                 int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                                 const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t stride = dststride / sizeof(pixel);
     int leftStartC = Enhscal->left_offset>>1;
     int rightEndC  = widthEL - (Enhscal->right_offset>>1);
     int topStartC  = Enhscal->top_offset>>1;
@@ -2050,7 +2061,7 @@ static void FUNC(upsample_filter_block_cr_v_x2)( uint8_t *_dst, ptrdiff_t dststr
         coeff = up_sample_filter_chroma_x2_v[y&0x01];
         refPos   = (refPos16>>4) - y_BL;
         src_tmp  = _src  + refPos  * _srcstride;
-        dst_tmp  =  dst  + y* dststride + x_EL;
+        dst_tmp  =  dst  + y* stride + x_EL;
         for( i = 0; i < block_w; i++ ) {
             *dst_tmp = av_clip_pixel( (CroVer_FILTER_Block(src_tmp, coeff, _srcstride) + I_OFFSET) >> (N_SHIFT));
             if( ((x_EL+i) >= leftStartC) && ((x_EL+i) <= rightEndC-2) )
@@ -2063,6 +2074,7 @@ static void FUNC(upsample_filter_block_cr_v_x2)( uint8_t *_dst, ptrdiff_t dststr
 static void FUNC(upsample_filter_block_luma_h_x1_5)( int16_t *_dst, ptrdiff_t _dststride, uint8_t *_src, ptrdiff_t _srcstride,
                                                   int x_EL, int x_BL, int block_w, int block_h, int widthEL,
                                                   const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t srcstride = _srcstride / sizeof(pixel);
     int rightEndL  = widthEL - Enhscal->right_offset;
     int leftStartL = Enhscal->left_offset;
     int x, i, j;
@@ -2077,8 +2089,8 @@ static void FUNC(upsample_filter_block_luma_h_x1_5)( int16_t *_dst, ptrdiff_t _d
         src_tmp  = src + (((x-leftStartL)<<1)/3);
 
         for( j = 0; j < block_h ; j++ ) {
-            *dst_tmp  = LumHor_FILTER_Block(src_tmp, coeff);
-            src_tmp  += _srcstride;
+            *dst_tmp  = LumHor_FILTER_Block(src_tmp, coeff) >> H_SHIFT;
+            src_tmp  += srcstride;
             dst_tmp  += _dststride;
         }
     }
@@ -2087,6 +2099,7 @@ static void FUNC(upsample_filter_block_luma_h_x1_5)( int16_t *_dst, ptrdiff_t _d
 static void FUNC(upsample_filter_block_cr_h_x1_5)(  int16_t *dst, ptrdiff_t dststride, uint8_t *_src, ptrdiff_t _srcstride,
                                                   int x_EL, int x_BL, int block_w, int block_h, int widthEL,
                                                   const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t srcstride = _srcstride / sizeof(pixel);
     int leftStartC = Enhscal->left_offset>>1;
     int rightEndC  = widthEL - (Enhscal->right_offset>>1);
     int x, i, j;
@@ -2100,8 +2113,8 @@ static void FUNC(upsample_filter_block_cr_h_x1_5)(  int16_t *dst, ptrdiff_t dsts
         dst_tmp  = dst  + i;
         src_tmp  = src + (((x-leftStartC)<<1)/3);
         for( j = 0; j < block_h ; j++ ) {
-            *dst_tmp   =  CroHor_FILTER_Block(src_tmp, coeff);
-            src_tmp  +=  _srcstride;
+            *dst_tmp   = CroHor_FILTER_Block(src_tmp, coeff) >> H_SHIFT;
+            src_tmp  +=  srcstride;
             dst_tmp   +=  dststride;
         }
     }
@@ -2110,13 +2123,14 @@ static void FUNC(upsample_filter_block_cr_h_x1_5)(  int16_t *dst, ptrdiff_t dsts
 static void FUNC(upsample_filter_block_luma_v_x1_5)( uint8_t *_dst, ptrdiff_t _dststride, int16_t *_src, ptrdiff_t _srcstride,
                                                     int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                                     const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t stride = _dststride / sizeof(pixel);
     int topStartL  = Enhscal->top_offset;
     int bottomEndL = heightEL - Enhscal->bottom_offset;
     int rightEndL  = widthEL - Enhscal->right_offset;
     int leftStartL = Enhscal->left_offset;
     int y, i, j;
     const int8_t  *   coeff;
-    pixel *dst_tmp, *dst    = (pixel *)_dst + x_EL + y_EL * _dststride;
+    pixel *dst_tmp, *dst    = (pixel *)_dst + x_EL + y_EL * stride;
     int16_t *   src_tmp;
 
     for( j = 0; j < block_h; j++ )	{
@@ -2130,13 +2144,14 @@ static void FUNC(upsample_filter_block_luma_v_x1_5)( uint8_t *_dst, ptrdiff_t _d
                 src_tmp++;
             dst_tmp++;
         }
-        dst  += _dststride;
+        dst  += stride;
     }
 }
 
 static void FUNC(upsample_filter_block_cr_v_x1_5)( uint8_t *_dst, ptrdiff_t dststride, int16_t *_src, ptrdiff_t _srcstride,
                                                   int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
                                                   const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info) {
+    ptrdiff_t stride = dststride / sizeof(pixel);
     int leftStartC = Enhscal->left_offset>>1;
     int rightEndC  = widthEL - (Enhscal->right_offset>>1);
     int topStartC  = Enhscal->top_offset>>1;
@@ -2151,7 +2166,7 @@ static void FUNC(upsample_filter_block_cr_v_x1_5)( uint8_t *_dst, ptrdiff_t dsts
         coeff    = up_sample_filter_x1_5chroma[y%3];
         refPos   = (refPos16>>4) - y_BL;
         src_tmp  = _src  + refPos  * _srcstride;
-        dst_tmp  =  dst  + y* dststride + x_EL;
+        dst_tmp  =  dst  + y* stride + x_EL;
         for ( i = 0; i < block_w; i++ ) {
             *dst_tmp = av_clip_pixel( (CroVer_FILTER_Block(src_tmp, coeff, _srcstride) + I_OFFSET) >> (N_SHIFT));
             if( ((x_EL+i) >= leftStartC) && ((x_EL+i) <= rightEndC-2) )
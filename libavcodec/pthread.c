@@ -75,6 +75,10 @@ static void validate_thread_parameters(AVCodecContext *avctx)
         avctx->active_thread_type = 0;
     }
 
+    if ((avctx->active_thread_type & FF_THREAD_SLICE) &&
+        (avctx->thread_type & FF_THREAD_SLICE_PARALLEL))
+        avctx->active_thread_type |= FF_THREAD_SLICE_PARALLEL;
+
     if (avctx->thread_count > MAX_AUTO_THREADS)
         av_log(avctx, AV_LOG_WARNING,
                "Application has requested %d threads. Using a thread count greater than %d is not recommended.\n",
@@ -91,10 +95,11 @@ int ff_thread_init(AVCodecContext *avctx)
         ret = ff_frame_thread_init(avctx);
     else if (avctx->active_thread_type&FF_THREAD_SLICE)
         ret = ff_slice_thread_init(avctx);
-    av_log(avctx, AV_LOG_INFO, "nb threads_frame = %d, nb threads_slice %d, thread_type = %s%s \n",
+    av_log(avctx, AV_LOG_INFO, "nb threads_frame = %d, nb threads_slice %d, thread_type = %s%s%s \n",
            avctx->thread_count_frame, avctx->thread_count,
            (avctx->active_thread_type == 0 ? "null" : (avctx->active_thread_type & FF_THREAD_FRAME ? "frame" : "")),
-           (avctx->active_thread_type & FF_THREAD_SLICE ? "slice" : ""));
+           (avctx->active_thread_type & FF_THREAD_SLICE ? "slice" : ""),
+           (avctx->active_thread_type & FF_THREAD_SLICE_PARALLEL ? "+slice_parallel" : ""));
 
     return ret;
 }
@@ -791,8 +791,12 @@ int ff_frame_thread_init(AVCodecContext *avctx)
         copy->internal->thread_ctx_frame = p;
         copy->internal->pkt = &p->avpkt;
 
-        if (avctx->active_thread_type&FF_THREAD_SLICE)
-            ff_slice_thread_init(copy);
+        if (avctx->active_thread_type&FF_THREAD_SLICE) {
+            err = i ? ff_slice_thread_init_shared(copy, fctx->threads[0].avctx) :
+                      ff_slice_thread_init(copy);
+            if (err < 0)
+                goto error;
+        }
 
         if (!i) {
             src = copy;
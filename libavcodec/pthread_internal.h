@@ -26,6 +26,11 @@
 #define MAX_AUTO_THREADS 16
 
 int ff_slice_thread_init(AVCodecContext *avctx);
+/**
+ * Set up slice threading for avctx on top of the worker pool of owner,
+ * so that the frame threads of one decoder share their slice workers.
+ */
+int ff_slice_thread_init_shared(AVCodecContext *avctx, AVCodecContext *owner);
 void ff_slice_thread_free(AVCodecContext *avctx);
 
 int ff_frame_thread_init(AVCodecContext *avctx);
@@ -37,15 +37,37 @@
 #include "pthread_internal.h"
 #include "thread.h"
 
+#include "libavutil/atomic.h"
 #include "libavutil/common.h"
 #include "libavutil/cpu.h"
 #include "libavutil/mem.h"
+#include "libavutil/time.h"
 
 typedef int (action_func)(AVCodecContext *c, void *arg);
 typedef int (action_func2)(AVCodecContext *c, void *arg, int jobnr, int threadnr);
 
+/**
+ * Per-worker counters, reported when FF_DEBUG_THREADS is set.
+ * busy time includes the time spent blocked on row progress.
+ */
+typedef struct SliceThreadStats {
+    int64_t idle;
+    int64_t busy;
+    int jobs;
+} SliceThreadStats;
+
+typedef struct SliceThreadPool SliceThreadPool;
+
+/**
+ * Slice threading state of one AVCodecContext. With frame+slice
+ * threading every frame thread has its own context, but they all feed
+ * the same SliceThreadPool.
+ */
 typedef struct SliceThreadContext {
-    pthread_t *workers;
+    SliceThreadPool *pool;
+    AVCodecContext *avctx;
+    struct SliceThreadContext *next;
+
     action_func *func;
     action_func2 *func2;
     void *args;
@@ -54,89 +76,189 @@ typedef struct SliceThreadContext {
     int job_count;
     int job_size;
 
-    pthread_cond_t last_job_cond;
-    pthread_cond_t current_job_cond;
-    pthread_mutex_t current_job_lock;
-    unsigned current_execute;
-    int current_job;
-    int done;
-
-    int *entries;
+    /**
+     * Next job index to hand out. Jobs are claimed with an atomic
+     * increment, in increasing order, so a row is never started before
+     * the rows it depends on have been picked up by someone.
+     */
+    volatile int next_job;
+    int max_helpers;            ///< pool workers allowed to join one execute
+    int nb_helpers;             ///< pool workers that joined the current execute
+    int users;                  ///< pool workers still running jobs of it
+    pthread_cond_t batch_cond;
+
+    /**
+     * Row progress. Readers poll the counters without locking; the
+     * mutex/cond pair is only used to sleep once the dependency is
+     * known not to be met yet.
+     */
+    volatile int *entries;
     int entries_count;
-    int thread_count;
-    pthread_cond_t *progress_cond;
-    pthread_mutex_t *progress_mutex;
+    int entries_allocated;
+    volatile int progress_waiters;
+    pthread_cond_t progress_cond;
+    pthread_mutex_t progress_mutex;
+
+    int64_t progress_wait;
+    int progress_wait_count;
 } SliceThreadContext;
 
+struct SliceThreadPool {
+    pthread_t *workers;
+    int nb_workers;
+    int nb_started;
+    int refs;
+    int done;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    SliceThreadContext *queue;  ///< executes in progress, oldest first
+
+    SliceThreadStats *stats;
+    int timing;                 ///< fill stats, only with FF_DEBUG_THREADS
+    int64_t progress_wait;
+    int progress_wait_count;
+};
+
+static void run_job(SliceThreadContext *c, int job, int slot)
+{
+    c->rets[job%c->rets_count] = c->func ? c->func(c->avctx, (char*)c->args + job*c->job_size):
+                                           c->func2(c->avctx, c->args, job, slot);
+}
+
+static int run_jobs(SliceThreadContext *c, int slot)
+{
+    int job, nb_jobs = 0;
+
+    while ((job = avpriv_atomic_int_add_and_fetch(&c->next_job, 1) - 1) < c->job_count) {
+        run_job(c, job, slot);
+        nb_jobs++;
+    }
+    return nb_jobs;
+}
+
+static SliceThreadContext *next_batch(SliceThreadPool *pool)
+{
+    SliceThreadContext *c;
+
+    for (c = pool->queue; c; c = c->next)
+        if (c->nb_helpers < c->max_helpers &&
+            avpriv_atomic_int_get(&c->next_job) < c->job_count)
+            return c;
+    return NULL;
+}
+
 static void* attribute_align_arg worker(void *v)
 {
-    AVCodecContext *avctx = v;
-    SliceThreadContext *c = avctx->internal->thread_ctx;
-    unsigned last_execute = 0;
-    int our_job = c->job_count;
-    int thread_count = avctx->thread_count;
-    int self_id;
+    SliceThreadPool *pool = v;
+    SliceThreadContext *c;
+    SliceThreadStats *st;
+    int64_t t0 = 0, t1 = 0;
+    int slot;
 
-    pthread_mutex_lock(&c->current_job_lock);
-    self_id = c->current_job++;
+    pthread_mutex_lock(&pool->lock);
+    st = &pool->stats[pool->nb_started++];
     for (;;){
-        while (our_job >= c->job_count) {
-            if (c->current_job == thread_count + c->job_count)
-                pthread_cond_signal(&c->last_job_cond);
-
-            while (last_execute == c->current_execute && !c->done)
-                pthread_cond_wait(&c->current_job_cond, &c->current_job_lock);
-            last_execute = c->current_execute;
-            our_job = self_id;
-
-            if (c->done) {
-                pthread_mutex_unlock(&c->current_job_lock);
-                return NULL;
-            }
+        if (pool->timing)
+            t0 = av_gettime();
+        while (!pool->done && !(c = next_batch(pool)))
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+
+        if (pool->done) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
         }
-        pthread_mutex_unlock(&c->current_job_lock);
+        slot = ++c->nb_helpers;
+        c->users++;
+        pthread_mutex_unlock(&pool->lock);
 
-        c->rets[our_job%c->rets_count] = c->func ? c->func(avctx, (char*)c->args + our_job*c->job_size):
-                                                   c->func2(avctx, c->args, our_job, self_id);
+        if (pool->timing) {
+            t1 = av_gettime();
+            st->idle += t1 - t0;
+        }
+        st->jobs += run_jobs(c, slot);
+        if (pool->timing)
+            st->busy += av_gettime() - t1;
 
-        pthread_mutex_lock(&c->current_job_lock);
-        our_job = c->current_job++;
+        pthread_mutex_lock(&pool->lock);
+        if (!--c->users)
+            pthread_cond_signal(&c->batch_cond);
     }
 }
 
-void ff_slice_thread_free(AVCodecContext *avctx)
+static void print_thread_stats(AVCodecContext *avctx, SliceThreadPool *pool)
 {
-    SliceThreadContext *c = avctx->internal->thread_ctx;
+    int64_t idle = 0, busy = 0;
     int i;
 
-    pthread_mutex_lock(&c->current_job_lock);
-    c->done = 1;
-    pthread_cond_broadcast(&c->current_job_cond);
-    pthread_mutex_unlock(&c->current_job_lock);
+    for (i = 0; i < pool->nb_workers; i++) {
+        SliceThreadStats *st = &pool->stats[i];
+        if (st->idle + st->busy <= 0)
+            continue;
+        av_log(avctx, AV_LOG_INFO,
+               "slice thread %2d: %7d jobs, busy %9"PRId64" us, idle %9"PRId64" us (%5.1f%%)\n",
+               i, st->jobs, st->busy, st->idle, 100.0 * st->idle / (st->idle + st->busy));
+        idle += st->idle;
+        busy += st->busy;
+    }
+    if (idle + busy > 0)
+        av_log(avctx, AV_LOG_INFO,
+               "slice threads: idle %5.1f%%, %d row waits blocked %"PRId64" us\n",
+               100.0 * idle / (idle + busy), pool->progress_wait_count, pool->progress_wait);
+}
 
-    for (i=0; i<avctx->thread_count; i++)
-         pthread_join(c->workers[i], NULL);
+static void pool_free(AVCodecContext *avctx, SliceThreadPool *pool)
+{
+    int i;
 
-    pthread_mutex_destroy(&c->current_job_lock);
-    pthread_cond_destroy(&c->current_job_cond);
-    pthread_cond_destroy(&c->last_job_cond);
-    av_free(c->workers);
-    av_freep(&c->entries);
-    av_freep(&c->progress_mutex);
-    av_freep(&c->progress_cond);
-    av_freep(&avctx->internal->thread_ctx);
+    pthread_mutex_lock(&pool->lock);
+    pool->done = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->nb_workers; i++)
+         pthread_join(pool->workers[i], NULL);
+
+    if (avctx->debug & FF_DEBUG_THREADS)
+        print_thread_stats(avctx, pool);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_cond);
+    av_free(pool->workers);
+    av_free(pool->stats);
+    av_free(pool);
 }
 
-static av_always_inline void thread_park_workers(SliceThreadContext *c, int thread_count)
+void ff_slice_thread_free(AVCodecContext *avctx)
 {
-    while (c->current_job != thread_count + c->job_count)
-        pthread_cond_wait(&c->last_job_cond, &c->current_job_lock);
-    pthread_mutex_unlock(&c->current_job_lock);
+    SliceThreadContext *c = avctx->internal->thread_ctx;
+    SliceThreadPool *pool;
+    int last;
+
+    if (!c)
+        return;
+    pool = c->pool;
+    pthread_mutex_lock(&pool->lock);
+    pool->progress_wait       += c->progress_wait;
+    pool->progress_wait_count += c->progress_wait_count;
+    last = !--pool->refs;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (last)
+        pool_free(avctx, pool);
+
+    pthread_cond_destroy(&c->batch_cond);
+    pthread_mutex_destroy(&c->progress_mutex);
+    pthread_cond_destroy(&c->progress_cond);
+    av_freep(&c->entries);
+    av_freep(&avctx->internal->thread_ctx);
 }
 
 static int thread_execute(AVCodecContext *avctx, action_func* func, void *arg, int *ret, int job_count, int job_size)
 {
     SliceThreadContext *c = avctx->internal->thread_ctx;
+    SliceThreadPool *pool;
+    SliceThreadContext **tail;
     int dummy_ret;
 
     if (!(avctx->active_thread_type&FF_THREAD_SLICE) || avctx->thread_count <= 1)
@@ -145,9 +267,11 @@ static int thread_execute(AVCodecContext *avctx, action_func* func, void *arg, i
     if (job_count <= 0)
         return 0;
 
-    pthread_mutex_lock(&c->current_job_lock);
+    pool = c->pool;
+    pthread_mutex_lock(&pool->lock);
 
-    c->current_job = avctx->thread_count;
+    c->next_job = 1;
+    c->nb_helpers = 0;
     c->job_count = job_count;
     c->job_size = job_size;
     c->args = arg;
@@ -159,10 +283,26 @@ static int thread_execute(AVCodecContext *avctx, action_func* func, void *arg, i
         c->rets = &dummy_ret;
         c->rets_count = 1;
     }
-    c->current_execute++;
-    pthread_cond_broadcast(&c->current_job_cond);
-
-    thread_park_workers(c, avctx->thread_count);
+    c->next = NULL;
+    for (tail = &pool->queue; *tail; tail = &(*tail)->next);
+    *tail = c;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    /* The calling thread takes part in its own execute; this is what
+     * guarantees progress when the pool is busy with other frames.
+     * Job 0 is always its own, in slot 0: the first WPP row or tile
+     * carries on with the bitstream reader the slice header was parsed
+     * with, which belongs to the caller. */
+    run_job(c, 0, 0);
+    run_jobs(c, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    for (tail = &pool->queue; *tail != c; tail = &(*tail)->next);
+    *tail = c->next;
+    while (c->users)
+        pthread_cond_wait(&c->batch_cond, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
 
     return 0;
 }
@@ -174,11 +314,35 @@ static int thread_execute2(AVCodecContext *avctx, action_func2* func2, void *arg
     return thread_execute(avctx, NULL, arg, ret, job_count, 0);
 }
 
+static int slice_thread_context_init(AVCodecContext *avctx, SliceThreadPool *pool)
+{
+    SliceThreadContext *c = av_mallocz(sizeof(SliceThreadContext));
+    if (!c)
+        return -1;
+
+    c->pool        = pool;
+    c->avctx       = avctx;
+    c->max_helpers = avctx->thread_count - 1;
+    pthread_cond_init(&c->batch_cond, NULL);
+    pthread_cond_init(&c->progress_cond, NULL);
+    pthread_mutex_init(&c->progress_mutex, NULL);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->refs++;
+    pthread_mutex_unlock(&pool->lock);
+
+    avctx->internal->thread_ctx = c;
+    avctx->execute = thread_execute;
+    avctx->execute2 = thread_execute2;
+    return 0;
+}
+
 int ff_slice_thread_init(AVCodecContext *avctx)
 {
     int i;
-    SliceThreadContext *c;
+    SliceThreadPool *pool;
     int thread_count = avctx->thread_count;
+    int nb_workers;
 
 #if HAVE_W32THREADS
     w32thread_init();
@@ -200,92 +364,111 @@ int ff_slice_thread_init(AVCodecContext *avctx)
         return 0;
     }
 
-    c = av_mallocz(sizeof(SliceThreadContext));
-    if (!c)
+    /* The caller of execute() runs jobs too. With frame threading the
+     * pool is shared by all frame threads, each of which may keep
+     * thread_count - 1 workers busy. */
+    nb_workers = thread_count - 1;
+    if (avctx->active_thread_type & FF_THREAD_FRAME)
+        nb_workers *= FFMAX(avctx->thread_count_frame, 1);
+
+    pool = av_mallocz(sizeof(SliceThreadPool));
+    if (!pool)
         return -1;
 
-    c->workers = av_mallocz_array(thread_count, sizeof(pthread_t));
-    if (!c->workers) {
-        av_free(c);
+    pool->workers = av_mallocz_array(nb_workers, sizeof(pthread_t));
+    pool->stats   = av_mallocz_array(nb_workers, sizeof(SliceThreadStats));
+    if (!pool->workers || !pool->stats) {
+        av_free(pool->workers);
+        av_free(pool->stats);
+        av_free(pool);
         return -1;
     }
+    pool->timing = !!(avctx->debug & FF_DEBUG_THREADS);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
 
-    avctx->internal->thread_ctx = c;
-    c->current_job = 0;
-    c->job_count = 0;
-    c->job_size = 0;
-    c->done = 0;
-    pthread_cond_init(&c->current_job_cond, NULL);
-    pthread_cond_init(&c->last_job_cond, NULL);
-    pthread_mutex_init(&c->current_job_lock, NULL);
-    pthread_mutex_lock(&c->current_job_lock);
-    for (i=0; i<thread_count; i++) {
-        if(pthread_create(&c->workers[i], NULL, worker, avctx)) {
-           avctx->thread_count = i;
-           pthread_mutex_unlock(&c->current_job_lock);
-           ff_thread_free(avctx);
-           return -1;
-        }
+    if (slice_thread_context_init(avctx, pool) < 0) {
+        pool_free(avctx, pool);
+        return -1;
     }
 
-    thread_park_workers(c, thread_count);
+    for (i = 0; i < nb_workers; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker, pool)) {
+            ff_slice_thread_free(avctx);
+            return -1;
+        }
+        pool->nb_workers++;
+    }
 
-    avctx->execute = thread_execute;
-    avctx->execute2 = thread_execute2;
     return 0;
 }
 
+int ff_slice_thread_init_shared(AVCodecContext *avctx, AVCodecContext *owner)
+{
+    SliceThreadContext *c = owner->internal->thread_ctx;
+
+    if (!c)
+        return ff_slice_thread_init(avctx);
+    return slice_thread_context_init(avctx, c->pool);
+}
+
+
 void ff_thread_report_progress2(AVCodecContext *avctx, int field, int thread, int n)
 {
     SliceThreadContext *p = avctx->internal->thread_ctx;
-    int *entries = p->entries;
 
-    pthread_mutex_lock(&p->progress_mutex[thread]);
-    entries[field] +=n;
-    pthread_cond_signal(&p->progress_cond[thread]);
-    pthread_mutex_unlock(&p->progress_mutex[thread]);
+    avpriv_atomic_int_add_and_fetch(&p->entries[field], n);
+    if (avpriv_atomic_int_get(&p->progress_waiters)) {
+        pthread_mutex_lock(&p->progress_mutex);
+        pthread_cond_broadcast(&p->progress_cond);
+        pthread_mutex_unlock(&p->progress_mutex);
+    }
+}
+
+static av_always_inline int progress_ready(volatile int *entries, int field, int shift)
+{
+    return avpriv_atomic_int_get(&entries[field - 1]) - entries[field] >= shift;
 }
 
 void ff_thread_await_progress2(AVCodecContext *avctx, int field, int thread, int shift)
 {
     SliceThreadContext *p  = avctx->internal->thread_ctx;
-    int *entries      = p->entries;
-
-    if (!entries || !field) return;
-
-    thread = thread ? thread - 1 : p->thread_count - 1;
-
-    pthread_mutex_lock(&p->progress_mutex[thread]);
-    while ((entries[field - 1] - entries[field]) < shift){
-        pthread_cond_wait(&p->progress_cond[thread], &p->progress_mutex[thread]);
-    }
-    pthread_mutex_unlock(&p->progress_mutex[thread]);
+    volatile int *entries  = p->entries;
+    int64_t t0 = 0;
+
+    if (!entries || !field || progress_ready(entries, field, shift))
+        return;
+
+    if (p->pool->timing)
+        t0 = av_gettime();
+
+    pthread_mutex_lock(&p->progress_mutex);
+    /* Register as a waiter before re-checking, so that a report landing in
+     * between either sees us or is seen by the check. */
+    avpriv_atomic_int_add_and_fetch(&p->progress_waiters, 1);
+    while (!progress_ready(entries, field, shift))
+        pthread_cond_wait(&p->progress_cond, &p->progress_mutex);
+    avpriv_atomic_int_add_and_fetch(&p->progress_waiters, -1);
+    if (p->pool->timing)
+        p->progress_wait += av_gettime() - t0;
+    p->progress_wait_count++;
+    pthread_mutex_unlock(&p->progress_mutex);
 }
 
 int ff_alloc_entries(AVCodecContext *avctx, int count)
 {
-    int i;
-
     if (avctx->active_thread_type & FF_THREAD_SLICE)  {
         SliceThreadContext *p = avctx->internal->thread_ctx;
-        p->thread_count  = avctx->thread_count;
-        p->entries       = av_mallocz_array(count, sizeof(int));
-
-        p->progress_mutex = av_malloc_array(p->thread_count, sizeof(pthread_mutex_t));
-        p->progress_cond  = av_malloc_array(p->thread_count, sizeof(pthread_cond_t));
 
-        if (!p->entries || !p->progress_mutex || !p->progress_cond) {
+        if (count > p->entries_allocated) {
             av_freep(&p->entries);
-            av_freep(&p->progress_mutex);
-            av_freep(&p->progress_cond);
-            return AVERROR(ENOMEM);
-        }
-        p->entries_count  = count;
-
-        for (i = 0; i < p->thread_count; i++) {
-            pthread_mutex_init(&p->progress_mutex[i], NULL);
-            pthread_cond_init(&p->progress_cond[i], NULL);
+            p->entries_allocated = 0;
+            p->entries = av_mallocz_array(count, sizeof(int));
+            if (!p->entries)
+                return AVERROR(ENOMEM);
+            p->entries_allocated = count;
         }
+        p->entries_count = count;
     }
 
     return 0;
@@ -295,5 +478,5 @@ void ff_reset_entries(AVCodecContext *avctx)
 {
     SliceThreadContext *p = avctx->internal->thread_ctx;
     if (p)
-        memset(p->entries, 0, p->entries_count * sizeof(int));
+        memset((int *)p->entries, 0, p->entries_count * sizeof(int));
 }
@@ -151,14 +151,4 @@ void ff_reset_entries(AVCodecContext *avctx);
 void ff_thread_report_progress2(AVCodecContext *avctx, int field, int thread, int n);
 void ff_thread_await_progress2(AVCodecContext *avctx,  int field, int thread, int shift);
 
-void ff_thread_report_progress_slice(AVCodecContext *avctx);
-void ff_thread_await_progress_slice(AVCodecContext *avctx);
-void ff_thread_set_slice_flag(AVCodecContext *avctx, int flag);
-
-
-void ff_thread_await_progress_slice2(AVCodecContext *avctx, int i);
-void ff_thread_report_progress_slice2(AVCodecContext *avctx, int i);
-void ff_init_flags(AVCodecContext *avctx);
-
-
 #endif /* AVCODEC_THREAD_H */
@@ -104,13 +104,15 @@ static int FUNC(ff_emulated_edge_up_h)(uint8_t *src, ptrdiff_t linesize,
                                     const struct HEVCWindow *Enhscal,
                                     int block_w, int block_h, int bl_edge_left, int bl_edge_right, int shift)
 {
-    int i;
-    uint8_t   *src_tmp = src;
-    
+    int i, j;
+    pixel     *src_tmp = (pixel *) src;
+
+    linesize /= sizeof(pixel);
     if(bl_edge_left < shift) {
       //  printf("------------ bl_edge_left %d \n", bl_edge_left);
         for(i=0; i < block_h; i++) {
-            memset(src_tmp-(shift), src_tmp[0], shift);
+            for (j = 1; j <= shift; j++)
+                src_tmp[-j] = src_tmp[0];
             src_tmp += linesize;
         }
         return 0;
@@ -119,7 +121,8 @@ static int FUNC(ff_emulated_edge_up_h)(uint8_t *src, ptrdiff_t linesize,
     if(bl_edge_right<(shift+1)) {
         //printf("------------  bl_edge_right %d \n", bl_edge_right);
         for( i = 0; i < block_h ; i++ ) {
-            memset(src_tmp+block_w,               src_tmp[block_w-1], shift+1);
+            for (j = 0; j <= shift; j++)
+                src_tmp[block_w + j] = src_tmp[block_w - 1];
             src_tmp += linesize;
         }
     }
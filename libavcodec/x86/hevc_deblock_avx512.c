@@ -0,0 +1,239 @@
+/*
+ * Provide AVX-512 deblocking functions for HEVC decoding
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/avassert.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX512
+#include <immintrin.h>
+
+/*
+ * Luma deblocking of one 8 line edge, one 32-bit lane per line.  A call
+ * only covers 8 lines, so this works on ymm registers and uses the opmask
+ * registers of AVX-512VL for the per segment decisions of the C version
+ * instead of branching on them.
+ */
+
+#define ABS_DIFF(a, b) _mm256_abs_epi32(_mm256_sub_epi32(a, b))
+#define CLIP(v, lo, hi) _mm256_max_epi32(_mm256_min_epi32(v, hi), lo)
+#define CLIP_DELTA(x, v, lim) \
+    _mm256_add_epi32(v, CLIP(_mm256_sub_epi32(x, v), _mm256_sub_epi32(zero, lim), lim))
+
+/* a per line condition holds for a segment when it holds on its lines 0 and 3 */
+static av_always_inline __mmask8 segment_mask(__mmask8 m)
+{
+    return ((m & 0x09) == 0x09 ? 0x0f : 0) | ((m & 0x90) == 0x90 ? 0xf0 : 0);
+}
+
+/* filters p[0..2] and q[0..2] in place and returns the lines it may have modified */
+static av_always_inline __mmask8 filter_luma(__m256i *p, __m256i *q, int beta, const int *_tc,
+                                             const uint8_t *no_p, const uint8_t *no_q,
+                                             int bit_depth)
+{
+    const __m256i zero   = _mm256_setzero_si256();
+    const __m256i maxpix = _mm256_set1_epi32((1 << bit_depth) - 1);
+    const __m256i line0  = _mm256_set_epi32(4, 4, 4, 4, 0, 0, 0, 0);
+    const __m256i line3  = _mm256_set_epi32(7, 7, 7, 7, 3, 3, 3, 3);
+    const int tc0 = _tc[0] << (bit_depth - 8);
+    const int tc1 = _tc[1] << (bit_depth - 8);
+    const __m256i tc = _mm256_set_epi32(tc1, tc1, tc1, tc1, tc0, tc0, tc0, tc0);
+    const __mmask8 mp = ~((no_p[0] ? 0x0f : 0) | (no_p[1] ? 0xf0 : 0));
+    const __mmask8 mq = ~((no_q[0] ? 0x0f : 0) | (no_q[1] ? 0xf0 : 0));
+    __m256i dp, dq, d, dp03, tc2, tc_2, tc25, delta0, deltap1, deltaq1;
+    __m256i sp0, sp1, sp2, sq0, sq1, sq2, np0, np1, nq0, nq1;
+    __mmask8 on, strong, normal, nd_p, nd_q;
+
+    beta <<= bit_depth - 8;
+
+    dp = ABS_DIFF(_mm256_add_epi32(p[2], p[0]), _mm256_slli_epi32(p[1], 1));
+    dq = ABS_DIFF(_mm256_add_epi32(q[2], q[0]), _mm256_slli_epi32(q[1], 1));
+    d  = _mm256_add_epi32(dp, dq);
+    on = _mm256_cmplt_epi32_mask(_mm256_add_epi32(_mm256_permutexvar_epi32(line0, d),
+                                                  _mm256_permutexvar_epi32(line3, d)),
+                                 _mm256_set1_epi32(beta));
+    if (!on)
+        return 0;
+
+    tc25   = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(tc, _mm256_set1_epi32(5)),
+                                                _mm256_set1_epi32(1)), 1);
+    strong = _mm256_cmplt_epi32_mask(_mm256_add_epi32(ABS_DIFF(p[3], p[0]), ABS_DIFF(q[3], q[0])),
+                                     _mm256_set1_epi32(beta >> 3)) &
+             _mm256_cmplt_epi32_mask(ABS_DIFF(p[0], q[0]), tc25) &
+             _mm256_cmplt_epi32_mask(_mm256_slli_epi32(d, 1), _mm256_set1_epi32(beta >> 2));
+    strong = on & segment_mask(strong);
+    normal = on & ~strong;
+
+    // strong filtering
+    tc2 = _mm256_slli_epi32(tc, 1);
+#define SUM3(a, b, c) _mm256_add_epi32(_mm256_add_epi32(a, b), c)
+#define X2(a)         _mm256_slli_epi32(a, 1)
+#define ROUND(v, n)   _mm256_srai_epi32(_mm256_add_epi32(v, _mm256_set1_epi32(1 << ((n) - 1))), n)
+    sp0 = ROUND(SUM3(SUM3(p[2], X2(p[1]), X2(p[0])), X2(q[0]), q[1]), 3);
+    sp1 = ROUND(SUM3(p[2], p[1], _mm256_add_epi32(p[0], q[0])), 2);
+    sp2 = ROUND(SUM3(SUM3(X2(p[3]), X2(p[2]), p[2]), p[1], _mm256_add_epi32(p[0], q[0])), 3);
+    sq0 = ROUND(SUM3(SUM3(q[2], X2(q[1]), X2(q[0])), X2(p[0]), p[1]), 3);
+    sq1 = ROUND(SUM3(q[2], q[1], _mm256_add_epi32(q[0], p[0])), 2);
+    sq2 = ROUND(SUM3(SUM3(X2(q[3]), X2(q[2]), q[2]), q[1], _mm256_add_epi32(q[0], p[0])), 3);
+    sp0 = CLIP_DELTA(sp0, p[0], tc2);
+    sp1 = CLIP_DELTA(sp1, p[1], tc2);
+    sp2 = CLIP_DELTA(sp2, p[2], tc2);
+    sq0 = CLIP_DELTA(sq0, q[0], tc2);
+    sq1 = CLIP_DELTA(sq1, q[1], tc2);
+    sq2 = CLIP_DELTA(sq2, q[2], tc2);
+
+    // normal filtering
+    delta0 = _mm256_sub_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(q[0], p[0]), _mm256_set1_epi32(9)),
+                              _mm256_mullo_epi32(_mm256_sub_epi32(q[1], p[1]), _mm256_set1_epi32(3)));
+    delta0 = ROUND(delta0, 4);
+    normal &= _mm256_cmplt_epi32_mask(_mm256_abs_epi32(delta0),
+                                      _mm256_mullo_epi32(tc, _mm256_set1_epi32(10)));
+    delta0 = CLIP(delta0, _mm256_sub_epi32(zero, tc), tc);
+    np0    = CLIP(_mm256_add_epi32(p[0], delta0), zero, maxpix);
+    nq0    = CLIP(_mm256_sub_epi32(q[0], delta0), zero, maxpix);
+
+    tc_2    = _mm256_srai_epi32(tc, 1);
+    dp03    = _mm256_set1_epi32((beta + (beta >> 1)) >> 3);
+    nd_p    = _mm256_cmplt_epi32_mask(_mm256_add_epi32(_mm256_permutexvar_epi32(line0, dp),
+                                                       _mm256_permutexvar_epi32(line3, dp)), dp03);
+    nd_q    = _mm256_cmplt_epi32_mask(_mm256_add_epi32(_mm256_permutexvar_epi32(line0, dq),
+                                                       _mm256_permutexvar_epi32(line3, dq)), dp03);
+    deltap1 = _mm256_sub_epi32(ROUND(_mm256_add_epi32(p[2], p[0]), 1), p[1]);
+    deltap1 = _mm256_srai_epi32(_mm256_add_epi32(deltap1, delta0), 1);
+    deltaq1 = _mm256_sub_epi32(ROUND(_mm256_add_epi32(q[2], q[0]), 1), q[1]);
+    deltaq1 = _mm256_srai_epi32(_mm256_sub_epi32(deltaq1, delta0), 1);
+    np1     = CLIP(_mm256_add_epi32(p[1], CLIP(deltap1, _mm256_sub_epi32(zero, tc_2), tc_2)), zero, maxpix);
+    nq1     = CLIP(_mm256_add_epi32(q[1], CLIP(deltaq1, _mm256_sub_epi32(zero, tc_2), tc_2)), zero, maxpix);
+#undef SUM3
+#undef X2
+#undef ROUND
+
+    p[0] = _mm256_mask_mov_epi32(_mm256_mask_mov_epi32(p[0], strong & mp, sp0), normal & mp, np0);
+    p[1] = _mm256_mask_mov_epi32(_mm256_mask_mov_epi32(p[1], strong & mp, sp1), normal & mp & nd_p, np1);
+    p[2] = _mm256_mask_mov_epi32(p[2], strong & mp, sp2);
+    q[0] = _mm256_mask_mov_epi32(_mm256_mask_mov_epi32(q[0], strong & mq, sq0), normal & mq, nq0);
+    q[1] = _mm256_mask_mov_epi32(_mm256_mask_mov_epi32(q[1], strong & mq, sq1), normal & mq & nd_q, nq1);
+    q[2] = _mm256_mask_mov_epi32(q[2], strong & mq, sq2);
+    return on;
+}
+
+static av_always_inline __m128i load_row(const uint8_t *src, int bit_depth)
+{
+    if (bit_depth == 8)
+        return _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) src));
+    return _mm_loadu_si128((const __m128i *) src);
+}
+
+static av_always_inline void store_row(uint8_t *dst, __m128i v, int bit_depth)
+{
+    if (bit_depth == 8)
+        _mm_storel_epi64((__m128i *) dst, _mm_packus_epi16(v, v));
+    else
+        _mm_storeu_si128((__m128i *) dst, v);
+}
+
+static av_always_inline void transpose8x8_epi16(__m128i *r)
+{
+    __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]), a1 = _mm_unpackhi_epi16(r[0], r[1]);
+    __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]), a3 = _mm_unpackhi_epi16(r[2], r[3]);
+    __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]), a5 = _mm_unpackhi_epi16(r[4], r[5]);
+    __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]), a7 = _mm_unpackhi_epi16(r[6], r[7]);
+    __m128i b0 = _mm_unpacklo_epi32(a0, a2), b1 = _mm_unpackhi_epi32(a0, a2);
+    __m128i b2 = _mm_unpacklo_epi32(a1, a3), b3 = _mm_unpackhi_epi32(a1, a3);
+    __m128i b4 = _mm_unpacklo_epi32(a4, a6), b5 = _mm_unpackhi_epi32(a4, a6);
+    __m128i b6 = _mm_unpacklo_epi32(a5, a7), b7 = _mm_unpackhi_epi32(a5, a7);
+
+    r[0] = _mm_unpacklo_epi64(b0, b4);
+    r[1] = _mm_unpackhi_epi64(b0, b4);
+    r[2] = _mm_unpacklo_epi64(b1, b5);
+    r[3] = _mm_unpackhi_epi64(b1, b5);
+    r[4] = _mm_unpacklo_epi64(b2, b6);
+    r[5] = _mm_unpackhi_epi64(b2, b6);
+    r[6] = _mm_unpacklo_epi64(b3, b7);
+    r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/* horizontal edge: each row is one of p3..q3 for the 8 columns */
+static av_always_inline void h_loop_filter_luma(uint8_t *pix, ptrdiff_t stride, int beta,
+                                                int *tc, uint8_t *no_p, uint8_t *no_q,
+                                                int bit_depth)
+{
+    __m256i p[4], q[4];
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        p[i] = _mm256_cvtepu16_epi32(load_row(pix - (i + 1) * stride, bit_depth));
+        q[i] = _mm256_cvtepu16_epi32(load_row(pix + i * stride, bit_depth));
+    }
+    if (!filter_luma(p, q, beta, tc, no_p, no_q, bit_depth))
+        return;
+    for (i = 0; i < 3; i++) {
+        store_row(pix - (i + 1) * stride, _mm256_cvtepi32_epi16(p[i]), bit_depth);
+        store_row(pix + i * stride, _mm256_cvtepi32_epi16(q[i]), bit_depth);
+    }
+}
+
+/* vertical edge: the 8 rows of p3..q3 are transposed into columns */
+static av_always_inline void v_loop_filter_luma(uint8_t *pix, ptrdiff_t stride, int beta,
+                                                int *tc, uint8_t *no_p, uint8_t *no_q,
+                                                int bit_depth)
+{
+    const int pel = bit_depth > 8 ? 2 : 1;
+    __m256i p[4], q[4];
+    __m128i r[8];
+    int i;
+
+    pix -= 4 * pel;
+    for (i = 0; i < 8; i++)
+        r[i] = load_row(pix + i * stride, bit_depth);
+    transpose8x8_epi16(r);
+    for (i = 0; i < 4; i++) {
+        p[i] = _mm256_cvtepu16_epi32(r[3 - i]);
+        q[i] = _mm256_cvtepu16_epi32(r[4 + i]);
+    }
+    if (!filter_luma(p, q, beta, tc, no_p, no_q, bit_depth))
+        return;
+    for (i = 0; i < 3; i++) {
+        r[3 - i] = _mm256_cvtepi32_epi16(p[i]);
+        r[4 + i] = _mm256_cvtepi32_epi16(q[i]);
+    }
+    transpose8x8_epi16(r);
+    for (i = 0; i < 8; i++)
+        store_row(pix + i * stride, r[i], bit_depth);
+}
+
+#define LOOP_FILTER_FUNCS(D)                                                                      \
+void ff_hevc_h_loop_filter_luma_ ## D ## _avx512(uint8_t *pix, ptrdiff_t stride, int beta,       \
+                                                  int *tc, uint8_t *no_p, uint8_t *no_q)          \
+{                                                                                                 \
+    h_loop_filter_luma(pix, stride, beta, tc, no_p, no_q, D);                                     \
+}                                                                                                 \
+void ff_hevc_v_loop_filter_luma_ ## D ## _avx512(uint8_t *pix, ptrdiff_t stride, int beta,       \
+                                                  int *tc, uint8_t *no_p, uint8_t *no_q)          \
+{                                                                                                 \
+    v_loop_filter_luma(pix, stride, beta, tc, no_p, no_q, D);                                     \
+}
+
+LOOP_FILTER_FUNCS(8)
+LOOP_FILTER_FUNCS(10)
+LOOP_FILTER_FUNCS(12)
+
+#endif // HAVE_AVX512
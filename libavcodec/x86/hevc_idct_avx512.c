@@ -0,0 +1,144 @@
+/*
+ * Provide AVX-512 transform functions for HEVC decoding
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/avassert.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX512
+#include <immintrin.h>
+
+/*
+ * 32x32 inverse transform as two plain matrix products: one zmm holds a
+ * whole 32-sample row, so each output row is the sum of the transform rows
+ * weighted by one input column.  Each pass writes its result transposed,
+ * which lets the second pass read the first one row by row.  The products
+ * are exact, so the result matches the butterfly in hevcdsp_template.c.
+ */
+
+/* int32 index of column c in the unpacklo/unpackhi halves of a row pair */
+#define PAIR_IDX(c) ((((c) & 4) ? 16 : 0) + ((c) >> 3) * 4 + ((c) & 3))
+
+static av_always_inline void load_row_pairs(__m512i *dst, const int8_t (*m)[32], int npairs)
+{
+    int i;
+
+    for (i = 0; i < npairs; i++) {
+        __m512i r0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *) m[2 * i]));
+        __m512i r1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *) m[2 * i + 1]));
+        _mm512_store_si512(dst + 2 * i,     _mm512_unpacklo_epi16(r0, r1));
+        _mm512_store_si512(dst + 2 * i + 1, _mm512_unpackhi_epi16(r0, r1));
+    }
+}
+
+/* dst row c = clip((sum_k src[k][c] * transform[k] + add) >> shift), for
+ * the first npairs pairs of source rows and the first nout columns; the
+ * remaining dst rows are left untouched */
+static av_always_inline void transform_pass(int16_t *dst, const int16_t *src,
+                                            const __m512i *m, int npairs,
+                                            int nout, int shift)
+{
+    DECLARE_ALIGNED(64, int32_t, pairs)[16][32];
+    const __m512i add = _mm512_set1_epi32(1 << (shift - 1));
+    int i, c;
+
+    for (i = 0; i < npairs; i++) {
+        __m512i r0 = _mm512_loadu_si512(src + 64 * i);
+        __m512i r1 = _mm512_loadu_si512(src + 64 * i + 32);
+        _mm512_store_si512(pairs[i],      _mm512_unpacklo_epi16(r0, r1));
+        _mm512_store_si512(pairs[i] + 16, _mm512_unpackhi_epi16(r0, r1));
+    }
+
+    for (c = 0; c < nout; c += 4) {
+        __m512i lo[4], hi[4];
+        int j;
+
+        for (j = 0; j < 4; j++)
+            lo[j] = hi[j] = add;
+        for (i = 0; i < npairs; i++) {
+            const __m512i mlo = _mm512_load_si512(m + 2 * i);
+            const __m512i mhi = _mm512_load_si512(m + 2 * i + 1);
+            for (j = 0; j < 4; j++) {
+                const __m512i x = _mm512_set1_epi32(pairs[i][PAIR_IDX(c + j)]);
+                lo[j] = _mm512_add_epi32(lo[j], _mm512_madd_epi16(x, mlo));
+                hi[j] = _mm512_add_epi32(hi[j], _mm512_madd_epi16(x, mhi));
+            }
+        }
+        for (j = 0; j < 4; j++)
+            _mm512_storeu_si512(dst + 32 * (c + j),
+                                _mm512_packs_epi32(_mm512_srai_epi32(lo[j], shift),
+                                                   _mm512_srai_epi32(hi[j], shift)));
+    }
+}
+
+static av_always_inline void transform_32x32(int16_t *coeffs, int col_limit, int bit_depth)
+{
+    DECLARE_ALIGNED(64, int16_t, tmp)[32 * 32];
+    __m512i m[32];
+    /* as in the C version, coefficients are zero from column col_limit and
+     * from row col_limit + 4 on */
+    const int limit  = (FFMIN(col_limit,     32) + 3) & ~3;
+    const int limit2 = (FFMIN(col_limit + 4, 32) + 3) & ~3;
+
+    load_row_pairs(m, ff_hevc_transform, limit2 >> 1);
+    transform_pass(tmp, coeffs, m, limit2 >> 1, limit, 7);
+    transform_pass(coeffs, tmp, m, limit >> 1, 32, 20 - bit_depth);
+}
+
+static av_always_inline void transform_add_32x32(uint8_t *dst, const int16_t *coeffs,
+                                                 ptrdiff_t stride, int bit_depth)
+{
+    int y;
+
+    for (y = 0; y < 32; y++) {
+        __m512i v = _mm512_loadu_si512(coeffs);
+
+        if (bit_depth == 8) {
+            v = _mm512_adds_epi16(v, _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *) dst)));
+            v = _mm512_max_epi16(v, _mm512_setzero_si512());
+            _mm256_storeu_si256((__m256i *) dst, _mm512_cvtusepi16_epi8(v));
+        } else {
+            v = _mm512_adds_epi16(v, _mm512_loadu_si512(dst));
+            v = _mm512_max_epi16(v, _mm512_setzero_si512());
+            v = _mm512_min_epi16(v, _mm512_set1_epi16((1 << bit_depth) - 1));
+            _mm512_storeu_si512(dst, v);
+        }
+        coeffs += 32;
+        dst    += stride;
+    }
+}
+
+#define TRANSFORM_FUNCS(D)                                                          \
+void ff_hevc_transform_32x32_ ## D ## _avx512(int16_t *coeffs, int col_limit)      \
+{                                                                                   \
+    transform_32x32(coeffs, col_limit, D);                                          \
+}                                                                                   \
+void ff_hevc_transform_32x32_add_ ## D ## _avx512(uint8_t *dst, int16_t *coeffs,   \
+                                                   ptrdiff_t stride)                \
+{                                                                                   \
+    transform_add_32x32(dst, coeffs, stride, D);                                    \
+}
+
+TRANSFORM_FUNCS(8)
+TRANSFORM_FUNCS(10)
+TRANSFORM_FUNCS(12)
+
+#endif // HAVE_AVX512
@@ -0,0 +1,397 @@
+/*
+ * Provide AVX2 inter-layer upsampling functions for SHVC decoding
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/avassert.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX2 && defined(SVC_EXTENSION)
+#include <immintrin.h>
+
+/*
+ * Both passes of a block run back to back: the horizontal pass filters the
+ * base layer rows the block needs into a local buffer, clamping the row
+ * index at the top and bottom of the picture instead of extending the
+ * intermediate buffer afterwards, and the vertical pass reads that buffer
+ * while it is still in L1.
+ *
+ * The tap positions and phases of each column and row are computed once per
+ * block with the formulas of the C functions of the same ratio, so x2, x1.5
+ * and arbitrary ratios share the kernels. With a base layer no larger than
+ * the enhancement layer, consecutive columns advance by at most one base
+ * sample: the taps of 8 columns (8 bit) or 4 columns (10 bit) fit in one
+ * 16-byte load, respectively two overlapping ones, and are picked with
+ * vpshufb.
+ */
+
+#define TMP_STRIDE  MAX_PB_SIZE
+#define TMP_ROWS    (MAX_PB_SIZE + 8)
+#define MAX_UNITS   (MAX_PB_SIZE / 8)
+
+DECLARE_ALIGNED(16, static const int8_t, up_sample_filter_chroma[16][4])=
+{
+    {  0,  64,   0,  0},
+    { -2,  62,   4,  0},
+    { -2,  58,  10, -2},
+    { -4,  56,  14, -2},
+    { -4,  54,  16, -2},
+    { -6,  52,  20, -2},
+    { -6,  46,  28, -4},
+    { -4,  42,  30, -4},
+    { -4,  36,  36, -4},
+    { -4,  30,  42, -4},
+    { -4,  28,  46, -6},
+    { -2,  20,  52, -6},
+    { -2,  16,  54, -4},
+    { -2,  14,  56, -4},
+    { -2,  10,  58, -2},
+    {  0,   4,  62, -2}
+};
+
+DECLARE_ALIGNED(16, static const int8_t, up_sample_filter_luma[16][8] )=
+{
+    {  0,  0,   0,  64,   0,   0,  0,  0},
+    {  0,  1,  -3,  63,   4,  -2,  1,  0},
+    { -1,  2,  -5,  62,   8,  -3,  1,  0},
+    { -1,  3,  -8,  60,  13,  -4,  1,  0},
+    { -1,  4, -10,  58,  17,  -5,  1,  0},
+    { -1,  4, -11,  52,  26,  -8,  3, -1},
+    { -1,  3,  -9,  47,  31, -10,  4, -1},
+    { -1,  4, -11,  45,  34, -10,  4, -1},
+    { -1,  4, -11,  40,  40, -11,  4, -1},
+    { -1,  4, -10,  34,  45, -11,  4, -1},
+    { -1,  4, -10,  31,  47,  -9,  3, -1},
+    { -1,  3,  -8,  26,  52, -11,  4, -1},
+    {  0,  1,  -5,  17,  58, -10,  4, -1},
+    {  0,  1,  -4,  13,  60,  -8,  3, -1},
+    {  0,  1,  -3,   8,  62,  -5,  2, -1},
+    {  0,  1,  -2,   4,  63,  -3,  1,  0}
+};
+
+/* phases of the fixed ratio filters of hevcdsp.c */
+static const uint8_t x1_5_phase[3]      = {  0, 11, 5 };
+static const uint8_t cr_x2_v_phase[2]   = { 14,  6 };
+static const uint8_t cr_x1_5_v_phase[3] = { 15,  9, 4 };
+
+typedef struct UpsampleTable {
+    /* vpshufb indices of each tap pair; at 10 bit [1] picks from the second load */
+    uint8_t shuf[MAX_UNITS][4][2][32];
+    /* coefficients of each tap pair, int8 pairs at 8 bit, int16 pairs at 10 bit */
+    int16_t coef[MAX_UNITS][4][16];
+    /* first tap of each 128-bit lane, in samples from x_BL */
+    int     base[MAX_UNITS][2];
+} UpsampleTable;
+
+static void column_taps(int *pos, const int8_t **taps, int x_EL, int x_BL, int block_w, int widthEL,
+                        const struct HEVCWindow *win, const struct UpsamplInf *up, int ratio, int chroma)
+{
+    int left  = chroma ? win->left_offset >> 1 : win->left_offset;
+    int right = widthEL - (chroma ? win->right_offset >> 1 : win->right_offset);
+    int i, col = 0;
+
+    for (i = 0; i < block_w; i++) {
+        int x = av_clip(col + x_EL, left, right);
+        int ref, phase;
+
+        if (ratio == X2) {
+            phase = (x & 1) << 3;
+            ref   = (chroma ? x : x - left) >> 1;
+        } else if (ratio == X1_5) {
+            phase = x1_5_phase[(x - left) % 3];
+            ref   = ((x - left) << 1) / 3;
+        } else {
+            int refPos16 = chroma ? ((x - left) * up->scaleXCr  + up->addXCr)  >> 12 :
+                                    ((x - left) * up->scaleXLum + up->addXLum) >> 12;
+            phase = refPos16 & 15;
+            ref   = refPos16 >> 4;
+        }
+        pos[i]  = ref - x_BL - (chroma ? 1 : 3);
+        taps[i] = chroma ? up_sample_filter_chroma[phase] : up_sample_filter_luma[phase];
+        /* the vertical pass of the C functions stops advancing at the
+         * window edges, which amounts to repeating the column there */
+        if (x_EL + i >= left && x_EL + i <= right - 2)
+            col++;
+    }
+}
+
+static void row_taps(int *ref, const int8_t **taps, int y_EL, int block_h, int heightEL,
+                     const struct HEVCWindow *win, const struct UpsamplInf *up, int ratio, int chroma)
+{
+    int top    = chroma ? win->top_offset >> 1 : win->top_offset;
+    int bottom = heightEL - (chroma ? win->bottom_offset >> 1 : win->bottom_offset);
+    int j;
+
+    for (j = 0; j < block_h; j++) {
+        int y = av_clip(y_EL + j, top, bottom - 1);
+        int phase;
+
+        if (chroma) {
+            int refPos16 = (((y - top) * up->scaleYCr + up->addYCr) >> 12) - 4;
+            phase  = ratio == X2   ? cr_x2_v_phase[y & 1]   :
+                     ratio == X1_5 ? cr_x1_5_v_phase[y % 3] : refPos16 & 15;
+            ref[j] = refPos16 >> 4;
+        } else if (ratio == X2) {
+            phase  = ((y - top) & 1) << 3;
+            ref[j] = (y - top) >> 1;
+        } else if (ratio == X1_5) {
+            phase  = x1_5_phase[(y - top) % 3];
+            ref[j] = ((y - top) << 1) / 3;
+        } else {
+            int refPos16 = ((y - top) * up->scaleYLum + up->addYLum) >> 12;
+            phase  = refPos16 & 15;
+            ref[j] = refPos16 >> 4;
+        }
+        taps[j] = chroma ? up_sample_filter_chroma[phase] : up_sample_filter_luma[phase];
+    }
+}
+
+/* A unit is one register of horizontal output: 16 columns in two lanes of
+ * 8 at 8 bit, 8 columns in two lanes of 4 at 10 bit. */
+static void build_table(UpsampleTable *t, const int *pos, const int8_t **taps,
+                        int block_w, int ntaps, int high)
+{
+    int lane_w = high ? 4 : 8;
+    int i, c, p, b;
+
+    for (i = 0; i < FFALIGN(block_w, 16); i += lane_w) {
+        int u    = i / (2 * lane_w);
+        int l    = (i / lane_w) & 1;
+        int base = pos[FFMIN(i, block_w - 1)];
+
+        t->base[u][l] = base;
+        for (c = 0; c < lane_w; c++) {
+            int col = FFMIN(i + c, block_w - 1);
+            int d   = pos[col] - base;
+
+            av_assert2(d >= 0 && d < lane_w);
+            for (p = 0; p < ntaps >> 1; p++) {
+                int c0 = taps[col][2 * p], c1 = taps[col][2 * p + 1];
+
+                if (!high) {
+                    t->shuf[u][p][0][16 * l + 2 * c]     = d + 2 * p;
+                    t->shuf[u][p][0][16 * l + 2 * c + 1] = d + 2 * p + 1;
+                    t->coef[u][p][8 * l + c] = (int16_t) ((uint8_t) c0 | (uint8_t) c1 << 8);
+                    continue;
+                }
+                for (b = 0; b < 2; b++) {
+                    int w = d + 2 * p + b;
+                    int o = 16 * l + 4 * c + 2 * b;
+
+                    /* words 0-7 come from the first load, 8-10 from the
+                     * second one, which starts 4 words later */
+                    t->shuf[u][p][0][o]     = w < 8 ? 2 * w     : 0x80;
+                    t->shuf[u][p][0][o + 1] = w < 8 ? 2 * w + 1 : 0x80;
+                    t->shuf[u][p][1][o]     = w < 8 ? 0x80 : 2 * (w - 4);
+                    t->shuf[u][p][1][o + 1] = w < 8 ? 0x80 : 2 * (w - 4) + 1;
+                }
+                t->coef[u][p][8 * l + 2 * c]     = c0;
+                t->coef[u][p][8 * l + 2 * c + 1] = c1;
+            }
+        }
+    }
+}
+
+static av_always_inline __m256i load_lanes(const uint8_t *lo, const uint8_t *hi)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) lo)),
+                                   _mm_loadu_si128((const __m128i *) hi), 1);
+}
+
+static av_always_inline __m256i h_unit_10(const uint8_t *row, const UpsampleTable *t, int u, int npairs, int shift)
+{
+    const uint8_t *lo = row + 2 * t->base[u][0];
+    const uint8_t *hi = row + 2 * t->base[u][1];
+    __m256i a   = load_lanes(lo,     hi);
+    __m256i b   = load_lanes(lo + 8, hi + 8);
+    __m256i sum = _mm256_setzero_si256();
+    int p;
+
+    for (p = 0; p < npairs; p++) {
+        __m256i x = _mm256_or_si256(_mm256_shuffle_epi8(a, _mm256_load_si256((const __m256i *) t->shuf[u][p][0])),
+                                    _mm256_shuffle_epi8(b, _mm256_load_si256((const __m256i *) t->shuf[u][p][1])));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(x, _mm256_load_si256((const __m256i *) t->coef[u][p])));
+    }
+    return _mm256_srai_epi32(sum, shift);
+}
+
+static av_always_inline void h_pass(int16_t *dst, const uint8_t *row, const UpsampleTable *t,
+                                    int units, int npairs, int bit_depth)
+{
+    int u, p;
+
+    if (bit_depth == 8) {
+        for (u = 0; u < units; u++) {
+            __m256i v   = load_lanes(row + t->base[u][0], row + t->base[u][1]);
+            __m256i sum = _mm256_setzero_si256();
+
+            for (p = 0; p < npairs; p++)
+                sum = _mm256_add_epi16(sum, _mm256_maddubs_epi16(_mm256_shuffle_epi8(v, _mm256_load_si256((const __m256i *) t->shuf[u][p][0])),
+                                                                 _mm256_load_si256((const __m256i *) t->coef[u][p])));
+            _mm256_store_si256((__m256i *) &dst[16 * u], sum);
+        }
+    } else {
+        for (u = 0; u < units; u += 2) {
+            __m256i s0 = h_unit_10(row, t, u,     npairs, bit_depth - 8);
+            __m256i s1 = h_unit_10(row, t, u + 1, npairs, bit_depth - 8);
+
+            _mm256_store_si256((__m256i *) &dst[8 * u],
+                               _mm256_permute4x64_epi64(_mm256_packs_epi32(s0, s1), 0xD8));
+        }
+    }
+}
+
+/* store the first n (1 to 16) columns of v */
+static av_always_inline void store_cols(uint8_t *dst, __m256i v, int n, int bit_depth)
+{
+    __m128i x;
+
+    if (bit_depth == 8) {
+        x = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08));
+        if (n == 16) {
+            _mm_storeu_si128((__m128i *) dst, x);
+            return;
+        }
+        if (n & 8) {
+            _mm_storel_epi64((__m128i *) dst, x);
+            x    = _mm_srli_si128(x, 8);
+            dst += 8;
+        }
+        if (n & 4) {
+            *(int32_t *) dst = _mm_cvtsi128_si32(x);
+            x    = _mm_srli_si128(x, 4);
+            dst += 4;
+        }
+        if (n & 2) {
+            *(int16_t *) dst = _mm_cvtsi128_si32(x);
+            x    = _mm_srli_si128(x, 2);
+            dst += 2;
+        }
+        if (n & 1)
+            *dst = _mm_cvtsi128_si32(x);
+    } else {
+        if (n == 16) {
+            _mm256_storeu_si256((__m256i *) dst, v);
+            return;
+        }
+        x = _mm256_castsi256_si128(v);
+        if (n & 8) {
+            _mm_storeu_si128((__m128i *) dst, x);
+            x    = _mm256_extracti128_si256(v, 1);
+            dst += 16;
+        }
+        if (n & 4) {
+            _mm_storel_epi64((__m128i *) dst, x);
+            x    = _mm_srli_si128(x, 8);
+            dst += 8;
+        }
+        if (n & 2) {
+            *(int32_t *) dst = _mm_cvtsi128_si32(x);
+            x    = _mm_srli_si128(x, 4);
+            dst += 4;
+        }
+        if (n & 1)
+            *(int16_t *) dst = _mm_cvtsi128_si32(x);
+    }
+}
+
+static av_always_inline void v_pass(uint8_t *dst, const int16_t *src, const int8_t *taps,
+                                    int width, int npairs, int bit_depth)
+{
+    const int shift = 20 - bit_depth;
+    __m256i offset  = _mm256_set1_epi32(1 << (shift - 1));
+    __m256i c[4];
+    int x, p;
+
+    for (p = 0; p < npairs; p++)
+        c[p] = _mm256_set1_epi32((uint16_t) taps[2 * p] | (uint32_t) (uint16_t) taps[2 * p + 1] << 16);
+
+    for (x = 0; x < width; x += 16) {
+        __m256i lo = offset, hi = offset, v;
+
+        for (p = 0; p < npairs; p++) {
+            __m256i r0 = _mm256_load_si256((const __m256i *) &src[(2 * p)     * TMP_STRIDE + x]);
+            __m256i r1 = _mm256_load_si256((const __m256i *) &src[(2 * p + 1) * TMP_STRIDE + x]);
+
+            lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(r0, r1), c[p]));
+            hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(r0, r1), c[p]));
+        }
+        v = _mm256_packs_epi32(_mm256_srai_epi32(lo, shift), _mm256_srai_epi32(hi, shift));
+        if (bit_depth > 8)
+            v = _mm256_min_epi16(_mm256_max_epi16(v, _mm256_setzero_si256()),
+                                 _mm256_set1_epi16((1 << bit_depth) - 1));
+        store_cols(dst + (x << (bit_depth > 8)), v, FFMIN(16, width - x), bit_depth);
+    }
+}
+
+static av_always_inline void upsample_block(uint8_t *_dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                                            int x_EL, int y_EL, int x_BL, int y_BL, int block_w, int block_h,
+                                            int bl_height, int widthEL, int heightEL,
+                                            const struct HEVCWindow *win, const struct UpsamplInf *up,
+                                            int ratio, int chroma, int bit_depth)
+{
+    DECLARE_ALIGNED(32, int16_t, tmp)[TMP_ROWS * TMP_STRIDE];
+    DECLARE_ALIGNED(32, UpsampleTable, t);
+    int pos[MAX_PB_SIZE], ref[MAX_PB_SIZE];
+    const int8_t *htaps[MAX_PB_SIZE], *vtaps[MAX_PB_SIZE];
+    int ntaps  = chroma ? 4 : 8;
+    int units  = FFALIGN(block_w, 16) / (bit_depth > 8 ? 8 : 16);
+    uint8_t *dst;
+    int first, last, y;
+
+    column_taps(pos, htaps, x_EL, x_BL, block_w, widthEL, win, up, ratio, chroma);
+    row_taps(ref, vtaps, y_EL, block_h, heightEL, win, up, ratio, chroma);
+    build_table(&t, pos, htaps, block_w, ntaps, bit_depth > 8);
+
+    first = ref[0] - (ntaps / 2 - 1);
+    last  = ref[block_h - 1] + ntaps / 2;
+    av_assert2(last - first < TMP_ROWS);
+    for (y = first; y <= last; y++)
+        h_pass(&tmp[(y - first) * TMP_STRIDE], src + (av_clip(y, 0, bl_height - 1) - y_BL) * srcstride,
+               &t, units, ntaps >> 1, bit_depth);
+
+    dst = _dst + y_EL * dststride + (x_EL << (bit_depth > 8));
+    for (y = 0; y < block_h; y++, dst += dststride)
+        v_pass(dst, &tmp[(ref[y] - (ntaps / 2 - 1) - first) * TMP_STRIDE], vtaps[y],
+               block_w, ntaps >> 1, bit_depth);
+}
+
+#define UPSAMPLE_FUNC(comp, name, ratio, chroma, D)                                                       \
+void ff_upsample_filter_block_ ## comp ## _hv_ ## name ## _ ## D ## _avx2(uint8_t *dst, ptrdiff_t dststride, \
+        uint8_t *src, ptrdiff_t srcstride, int x_EL, int y_EL, int x_BL, int y_BL,                          \
+        int block_w, int block_h, int bl_height, int widthEL, int heightEL,                                 \
+        const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info)                                       \
+{                                                                                                           \
+    upsample_block(dst, dststride, src, srcstride, x_EL, y_EL, x_BL, y_BL, block_w, block_h,                \
+                   bl_height, widthEL, heightEL, Enhscal, up_info, ratio, chroma, D);                       \
+}
+
+#define UPSAMPLE_FUNCS(D)                       \
+UPSAMPLE_FUNC(luma, all,  DEFAULT, 0, D)        \
+UPSAMPLE_FUNC(luma, x2,   X2,      0, D)        \
+UPSAMPLE_FUNC(luma, x1_5, X1_5,    0, D)        \
+UPSAMPLE_FUNC(cr,   all,  DEFAULT, 1, D)        \
+UPSAMPLE_FUNC(cr,   x2,   X2,      1, D)        \
+UPSAMPLE_FUNC(cr,   x1_5, X1_5,    1, D)
+
+UPSAMPLE_FUNCS(8)
+UPSAMPLE_FUNCS(10)
+
+#endif // HAVE_AVX2 && SVC_EXTENSION
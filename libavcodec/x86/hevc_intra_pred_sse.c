@@ -46,7 +46,6 @@ static av_always_inline __m128i _MM_PACKUS_EPI32( __m128i a, __m128i b )
     uint16_t *src = (uint16_t*)_src;                                           \
     const uint16_t *top = (const uint16_t*)_top;                               \
     const uint16_t *left = (const uint16_t*)_left
-#define PLANAR_INIT_12() PLANAR_INIT_10()
 
 #define PLANAR_COMPUTE(val, shift)                                             \
     add = _mm_mullo_epi16(_mm_set1_epi16(1+y), l0);                            \
@@ -83,7 +82,6 @@ static av_always_inline __m128i _MM_PACKUS_EPI32( __m128i a, __m128i b )
     tx   = _mm_loadl_epi64((__m128i*) top);                                    \
     ly   = _mm_unpacklo_epi16(ly, ly);                                         \
     tx   = _mm_unpacklo_epi64(tx, tx)
-#define PLANAR_LOAD_0_12()  PLANAR_LOAD_0_10()
 
 #define PLANAR_COMPUTE_0(dst , v1, v2, v3, v4)                                 \
     dst = _mm_mullo_epi16(tmp1, ly1);                                          \
@@ -105,7 +103,6 @@ static av_always_inline __m128i _MM_PACKUS_EPI32( __m128i a, __m128i b )
     _mm_storel_epi64((__m128i*)(src +     stride), _mm_unpackhi_epi64(c0, c0));\
     _mm_storel_epi64((__m128i*)(src + 2 * stride), C0);                        \
     _mm_storel_epi64((__m128i*)(src + 3 * stride), _mm_unpackhi_epi64(C0, C0))
-#define PLANAR_STORE_0_12() PLANAR_STORE_0_10()
 
 #define PRED_PLANAR_0(D)                                                       \
 void pred_planar_0_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
@@ -129,7 +126,6 @@ void pred_planar_0_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
 }
 PRED_PLANAR_0( 8)
 PRED_PLANAR_0(10)
-PRED_PLANAR_0(12)
 
 ////////////////////////////////////////////////////////////////////////////////
 //
@@ -142,7 +138,6 @@ PRED_PLANAR_0(12)
 #define PLANAR_LOAD_1_10()                                                     \
     ly   = _mm_loadu_si128((__m128i*)left);                                    \
     tx   = _mm_loadu_si128((__m128i*)top)
-#define PLANAR_LOAD_1_12() PLANAR_LOAD_1_10()
 
 #define PLANAR_COMPUTE_1()                                                     \
     PLANAR_COMPUTE(7, 4)
@@ -156,7 +151,6 @@ PRED_PLANAR_0(12)
     _mm_storeu_si128((__m128i*)(src), c0);                                     \
     src+= stride;                                                              \
     ly  = _mm_srli_si128(ly,2)
-#define PLANAR_STORE_1_12() PLANAR_STORE_1_10()
 
 #define PRED_PLANAR_1(D)                                                       \
 void pred_planar_1_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
@@ -180,7 +174,6 @@ void pred_planar_1_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
 
 PRED_PLANAR_1( 8)
 PRED_PLANAR_1(10)
-PRED_PLANAR_1(12)
 
 ////////////////////////////////////////////////////////////////////////////////
 //
@@ -198,7 +191,6 @@ PRED_PLANAR_1(12)
     lh   = _mm_loadu_si128((__m128i*)&left[8]);                                \
     tx   = _mm_loadu_si128((__m128i*) top);                                    \
     th   = _mm_loadu_si128((__m128i*)&top[8])
-#define PLANAR_LOAD_2_12() PLANAR_LOAD_2_10()
 
 #define PLANAR_COMPUTE_2()                                                     \
     PLANAR_COMPUTE(15, 5)
@@ -215,7 +207,6 @@ PRED_PLANAR_1(12)
     _mm_storeu_si128((__m128i*)&src[8], C0);                                   \
     src+= stride;                                                              \
     ly  = _mm_srli_si128(ly,2)
-#define PLANAR_STORE_2_12() PLANAR_STORE_2_10()
 
 #define PRED_PLANAR_2(D)                                                       \
 void pred_planar_2_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
@@ -246,7 +237,6 @@ void pred_planar_2_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
 
 PRED_PLANAR_2( 8)
 PRED_PLANAR_2(10)
-PRED_PLANAR_2(12)
 
 ////////////////////////////////////////////////////////////////////////////////
 //
@@ -268,7 +258,6 @@ PRED_PLANAR_2(12)
     th   = _mm_loadu_si128((__m128i*)&top[ 8]);                                \
     TX   = _mm_loadu_si128((__m128i*)&top[16]);                                \
     TH   = _mm_loadu_si128((__m128i*)&top[24])
-#define PLANAR_LOAD_3_12() PLANAR_LOAD_3_10()
 
 #define PLANAR_RELOAD_3_8()                                                    \
     ly = _mm_loadu_si128((__m128i*)(left+16));                                 \
@@ -277,7 +266,6 @@ PRED_PLANAR_2(12)
 #define PLANAR_RELOAD_3_10()                                                   \
     ly = _mm_loadu_si128((__m128i*)&left[16]);                                 \
     lh = _mm_loadu_si128((__m128i*)&left[24])
-#define PLANAR_RELOAD_3_12()  PLANAR_RELOAD_3_10()
 
 #define PLANAR_COMPUTE_3()                                                     \
     PLANAR_COMPUTE(31, 6)
@@ -315,8 +303,6 @@ PRED_PLANAR_2(12)
     _mm_storeu_si128((__m128i*)&src[24], C0);                                  \
     src+= stride;                                                              \
     ly  = _mm_srli_si128(ly, 2)
-#define PLANAR_STORE1_3_12() PLANAR_STORE1_3_10()
-#define PLANAR_STORE2_3_12() PLANAR_STORE2_3_10()
 
 
 #define PRED_PLANAR_3(D)                                                       \
@@ -361,7 +347,59 @@ void pred_planar_3_ ## D ## _sse(uint8_t *_src, const uint8_t *_top,           \
 
 PRED_PLANAR_3( 8)
 PRED_PLANAR_3(10)
-PRED_PLANAR_3(12)
+
+////////////////////////////////////////////////////////////////////////////////
+// 12 bit: the weighted sums reach 2 * size * 4095, which overflows the 16 bit
+// lanes used above, so pair each top sample with its column weight and let
+// madd produce 32 bit sums.
+////////////////////////////////////////////////////////////////////////////////
+static av_always_inline void pred_planar_12(uint8_t *_src, const uint8_t *_top,
+        const uint8_t *_left, ptrdiff_t stride, int log2_size)
+{
+    uint16_t *src        = (uint16_t *) _src;
+    const uint16_t *top  = (const uint16_t *) _top;
+    const uint16_t *left = (const uint16_t *) _left;
+    const int size       = 1 << log2_size;
+    __m128i pairs[8], base[8];
+    int x, y;
+
+    for (x = 0; x < size; x += 4) {
+        const __m128i xr = _mm_sub_epi16(_mm_set1_epi16(size - 1 - x),
+                                         _mm_set_epi16(0, 0, 0, 0, 3, 2, 1, 0));
+        pairs[x >> 2] = _mm_unpacklo_epi16(xr, _mm_loadl_epi64((const __m128i *) &top[x]));
+        base[x >> 2]  = _mm_add_epi32(_mm_mullo_epi32(_mm_set_epi32(x + 4, x + 3, x + 2, x + 1),
+                                                      _mm_set1_epi32(top[size])),
+                                      _mm_set1_epi32(size));
+    }
+    for (y = 0; y < size; y++) {
+        const __m128i w   = _mm_set1_epi32(((size - 1 - y) << 16) | left[y]);
+        const __m128i add = _mm_set1_epi32((y + 1) * left[size]);
+        for (x = 0; x < size; x += 4) {
+            __m128i r = _mm_madd_epi16(pairs[x >> 2], w);
+            r = _mm_add_epi32(r, _mm_add_epi32(base[x >> 2], add));
+            r = _mm_srli_epi32(r, log2_size + 1);
+            _mm_storel_epi64((__m128i *) &src[x], _mm_packus_epi32(r, r));
+        }
+        src += stride;
+    }
+}
+
+void pred_planar_0_12_sse(uint8_t *_src, const uint8_t *_top,
+        const uint8_t *_left, ptrdiff_t stride) {
+    pred_planar_12(_src, _top, _left, stride, 2);
+}
+void pred_planar_1_12_sse(uint8_t *_src, const uint8_t *_top,
+        const uint8_t *_left, ptrdiff_t stride) {
+    pred_planar_12(_src, _top, _left, stride, 3);
+}
+void pred_planar_2_12_sse(uint8_t *_src, const uint8_t *_top,
+        const uint8_t *_left, ptrdiff_t stride) {
+    pred_planar_12(_src, _top, _left, stride, 4);
+}
+void pred_planar_3_12_sse(uint8_t *_src, const uint8_t *_top,
+        const uint8_t *_left, ptrdiff_t stride) {
+    pred_planar_12(_src, _top, _left, stride, 5);
+}
 
 #endif
 
@@ -671,10 +709,23 @@ PRED_PLANAR_3(12)
 #define ANGULAR_COMPUTE16_10()   ANGULAR_COMPUTE_10(16)
 #define ANGULAR_COMPUTE32_10()   ANGULAR_COMPUTE_10(32)
 
-#define ANGULAR_COMPUTE4_12()    ANGULAR_COMPUTE_10( 4)
-#define ANGULAR_COMPUTE8_12()    ANGULAR_COMPUTE_10( 8)
-#define ANGULAR_COMPUTE16_12()   ANGULAR_COMPUTE_10(16)
-#define ANGULAR_COMPUTE32_12()   ANGULAR_COMPUTE_10(32)
+// 32 * 4095 does not fit the 16 bit rounding trick above
+#define ANGULAR_COMPUTE_12(W)                                                  \
+    for (x = 0; x < W; x += 4) {                                               \
+        r3 = _mm_set1_epi32((fact << 16) + (32 - fact));                       \
+        r1 = _mm_loadu_si128((__m128i*)(&ref[x+idx+1]));                       \
+        r0 = _mm_srli_si128(r1, 2);                                            \
+        r1 = _mm_unpacklo_epi16(r1, r0);                                       \
+        r1 = _mm_madd_epi16(r1, r3);                                           \
+        r1 = _mm_add_epi32(r1, _mm_set1_epi32(16));                            \
+        r1 = _mm_srli_epi32(r1, 5);                                            \
+        r1 = _MM_PACKUS_EPI32(r1, r1);                                         \
+        _mm_storel_epi64((__m128i *) &p_src[x], r1);                           \
+    }
+#define ANGULAR_COMPUTE4_12()    ANGULAR_COMPUTE_12( 4)
+#define ANGULAR_COMPUTE8_12()    ANGULAR_COMPUTE_12( 8)
+#define ANGULAR_COMPUTE16_12()   ANGULAR_COMPUTE_12(16)
+#define ANGULAR_COMPUTE32_12()   ANGULAR_COMPUTE_12(32)
 
 #define ANGULAR_COMPUTE_ELSE_10(W)                                             \
     for (x = 0; x < W; x += 8) {                                               \
@@ -1308,4 +1359,99 @@ void pred_angular_3_12_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_l
             ptrdiff_t _stride, int c_idx, int mode) {
     pred_angular_32_12_sse(_src, _top, _left, _stride, c_idx, mode);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////
+static av_always_inline __m128i dc_load8(const uint8_t *p, int high)
+{
+    if (high)
+        return _mm_loadu_si128((const __m128i *) p);
+    return _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *) p));
+}
+
+static av_always_inline __m128i dc_load4(const uint8_t *p, int high)
+{
+    if (high)
+        return _mm_loadl_epi64((const __m128i *) p);
+    return _mm_cvtepu8_epi16(_mm_cvtsi32_si128(*(const uint32_t *) p));
+}
+
+static av_always_inline void pred_dc_sse(uint8_t *src, const uint8_t *top,
+        const uint8_t *left, ptrdiff_t stride, int log2_size, int c_idx, int high)
+{
+    const int size = 1 << log2_size;
+    const int pel  = high + 1;
+    __m128i sum    = _mm_setzero_si128();
+    __m128i dcv, r0;
+    int x, y, dc;
+
+    if (size == 4) {
+        r0  = _mm_add_epi16(dc_load4(top, high), dc_load4(left, high));
+        sum = _mm_madd_epi16(r0, _mm_set1_epi16(1));
+    } else {
+        for (x = 0; x < size; x += 8) {
+            r0  = _mm_add_epi16(dc_load8(top + x * pel, high), dc_load8(left + x * pel, high));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(r0, _mm_set1_epi16(1)));
+        }
+    }
+    sum = _mm_add_epi32(sum, _mm_unpackhi_epi64(sum, sum));
+    sum = _mm_add_epi32(sum, _mm_srli_epi64(sum, 32));
+    dc  = (_mm_cvtsi128_si32(sum) + size) >> (log2_size + 1);
+
+    dcv = high ? _mm_set1_epi16(dc) : _mm_set1_epi8(dc);
+    for (y = 0; y < size; y++) {
+        uint8_t *p = src + y * stride * pel;
+        if (size * pel == 4)
+            *(uint32_t *) p = _mm_cvtsi128_si32(dcv);
+        else if (size * pel == 8)
+            _mm_storel_epi64((__m128i *) p, dcv);
+        else
+            for (x = 0; x < size * pel; x += 16)
+                _mm_storeu_si128((__m128i *) &p[x], dcv);
+    }
+
+    if (c_idx == 0 && size < 32) {
+        const __m128i dc3 = _mm_set1_epi16(3 * dc + 2);
+        for (x = 0; x < size; x += 8) {
+            r0 = size == 4 ? dc_load4(top, high) : dc_load8(top + x * pel, high);
+            r0 = _mm_srli_epi16(_mm_add_epi16(r0, dc3), 2);
+            if (high) {
+                if (size == 4)
+                    _mm_storel_epi64((__m128i *) src, r0);
+                else
+                    _mm_storeu_si128((__m128i *) &src[x * 2], r0);
+            } else {
+                r0 = _mm_packus_epi16(r0, r0);
+                if (size == 4)
+                    *(uint32_t *) src = _mm_cvtsi128_si32(r0);
+                else
+                    _mm_storel_epi64((__m128i *) &src[x], r0);
+            }
+        }
+        if (high) {
+            const uint16_t *l = (const uint16_t *) left;
+            ((uint16_t *) src)[0] = (l[0] + 2 * dc + ((const uint16_t *) top)[0] + 2) >> 2;
+            for (y = 1; y < size; y++)
+                ((uint16_t *) src)[y * stride] = (l[y] + 3 * dc + 2) >> 2;
+        } else {
+            src[0] = (left[0] + 2 * dc + top[0] + 2) >> 2;
+            for (y = 1; y < size; y++)
+                src[y * stride] = (left[y] + 3 * dc + 2) >> 2;
+        }
+    }
+}
+
+void pred_dc_8_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left,
+        ptrdiff_t stride, int log2_size, int c_idx) {
+    pred_dc_sse(_src, _top, _left, stride, log2_size, c_idx, 0);
+}
+void pred_dc_10_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left,
+        ptrdiff_t stride, int log2_size, int c_idx) {
+    pred_dc_sse(_src, _top, _left, stride, log2_size, c_idx, 1);
+}
+void pred_dc_12_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left,
+        ptrdiff_t stride, int log2_size, int c_idx) {
+    pred_dc_sse(_src, _top, _left, stride, log2_size, c_idx, 1);
+}
 #endif
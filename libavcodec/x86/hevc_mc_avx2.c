@@ -0,0 +1,459 @@
+/*
+ * Provide AVX2 MC functions for HEVC decoding
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/avassert.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX2_MC
+#include <immintrin.h>
+
+/*
+ * The kernels below work on 16 samples per 256-bit register, widened to
+ * 16 bits whatever the bit depth.  Filter taps are applied pairwise with
+ * vpmaddwd on interleaved rows so the sums are exact in 32 bits, then
+ * packed back to the 14-bit intermediate format of hevcdsp_template.c.
+ * The 8-bit pixel passes use byte taps instead, see filter_h_8().
+ * Widths that are not a multiple of 16 (24) finish with one 8-wide column
+ * using the low 128-bit half only.
+ */
+
+enum {
+    MC_PIXELS,
+    MC_H,
+    MC_V,
+    MC_HV,
+};
+
+enum {
+    MC_OP_PUT,
+    MC_OP_UNI,
+    MC_OP_BI,
+    MC_OP_UNI_W,
+    MC_OP_BI_W,
+};
+
+typedef struct MCWeight {
+    __m256i w;      ///< wx (uni) or wx1:wx0 pairs (bi)
+    __m256i offset; ///< 32-bit rounding term
+    __m256i ox;     ///< 32-bit output offset (uni only)
+    __m128i shift;
+} MCWeight;
+
+static av_always_inline __m256i load_int16(const int16_t *src, int n)
+{
+    if (n == 16)
+        return _mm256_loadu_si256((const __m256i *) src);
+    return _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) src));
+}
+
+static av_always_inline __m256i load_pixels(const uint8_t *src, int n, int bit_depth)
+{
+    if (bit_depth == 8)
+        return _mm256_cvtepu8_epi16(n == 16 ? _mm_loadu_si128((const __m128i *) src) :
+                                              _mm_loadl_epi64((const __m128i *) src));
+    return load_int16((const int16_t *) src, n);
+}
+
+static av_always_inline void store_int16(int16_t *dst, __m256i v, int n)
+{
+    if (n == 16)
+        _mm256_storeu_si256((__m256i *) dst, v);
+    else
+        _mm_storeu_si128((__m128i *) dst, _mm256_castsi256_si128(v));
+}
+
+static av_always_inline void store_pixels(uint8_t *dst, __m256i v, int n, int bit_depth)
+{
+    if (bit_depth == 8) {
+        v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08);
+        if (n == 16)
+            _mm_storeu_si128((__m128i *) dst, _mm256_castsi256_si128(v));
+        else
+            _mm_storel_epi64((__m128i *) dst, _mm256_castsi256_si128(v));
+    } else {
+        v = _mm256_max_epi16(v, _mm256_setzero_si256());
+        v = _mm256_min_epi16(v, _mm256_set1_epi16((1 << bit_depth) - 1));
+        store_int16((int16_t *) dst, v, n);
+    }
+}
+
+static av_always_inline void load_filter(__m256i *c, intptr_t m, int ntaps, int bytes)
+{
+    const int8_t *filter = ntaps == 8 ? ff_hevc_qpel_filters[m - 1] : ff_hevc_epel_filters[m - 1];
+#define TAP_PAIR(i) (bytes ? _mm256_set1_epi16((filter[i] & 0xFF) | (filter[i + 1] << 8)) : \
+                             _mm256_set1_epi32((filter[i] & 0xFFFF) | (filter[i + 1] << 16)))
+    c[0] = TAP_PAIR(0);
+    c[1] = TAP_PAIR(2);
+    if (ntaps == 8) {
+        c[2] = TAP_PAIR(4);
+        c[3] = TAP_PAIR(6);
+    }
+#undef TAP_PAIR
+}
+
+static av_always_inline __m256i filter_taps(const __m256i *v, const __m256i *c,
+                                            int ntaps, int shift)
+{
+#define MADD_PAIR(unpack, i) _mm256_madd_epi16(unpack(v[i], v[i + 1]), c[i >> 1])
+    __m256i lo = _mm256_add_epi32(MADD_PAIR(_mm256_unpacklo_epi16, 0), MADD_PAIR(_mm256_unpacklo_epi16, 2));
+    __m256i hi = _mm256_add_epi32(MADD_PAIR(_mm256_unpackhi_epi16, 0), MADD_PAIR(_mm256_unpackhi_epi16, 2));
+
+    if (ntaps == 8) {
+        lo = _mm256_add_epi32(lo, _mm256_add_epi32(MADD_PAIR(_mm256_unpacklo_epi16, 4),
+                                                   MADD_PAIR(_mm256_unpacklo_epi16, 6)));
+        hi = _mm256_add_epi32(hi, _mm256_add_epi32(MADD_PAIR(_mm256_unpackhi_epi16, 4),
+                                                   MADD_PAIR(_mm256_unpackhi_epi16, 6)));
+    }
+#undef MADD_PAIR
+    if (shift) {
+        lo = _mm256_srai_epi32(lo, shift);
+        hi = _mm256_srai_epi32(hi, shift);
+    }
+    return _mm256_packs_epi32(lo, hi);
+}
+
+/*
+ * 8-bit rows are kept as bytes: each 128-bit lane holds the source of 8
+ * outputs, byte pairs are gathered with vpshufb (h) or vpunpcklbw (v) and
+ * reduced with vpmaddubsw, whose 16-bit sums cannot overflow at 8 bits.
+ */
+DECLARE_ALIGNED(32, static const int8_t, qpel_h_shuf_avx2)[4][32] = {
+    { 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+      0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8 },
+    { 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
+      2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10 },
+    { 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12,
+      4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12 },
+    { 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14,
+      6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14 },
+};
+
+static av_always_inline __m256i filter_h_8(const uint8_t *src, const __m256i *c,
+                                           int ntaps, int n)
+{
+    __m256i r, sum;
+
+    src -= ntaps / 2 - 1;
+    r = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) src));
+    if (n == 16)
+        r = _mm256_inserti128_si256(r, _mm_loadu_si128((const __m128i *) (src + 8)), 1);
+#define MADDUBS_PAIR(i) _mm256_maddubs_epi16(_mm256_shuffle_epi8(r, *(const __m256i *) qpel_h_shuf_avx2[i]), c[i])
+    sum = _mm256_add_epi16(MADDUBS_PAIR(0), MADDUBS_PAIR(1));
+    if (ntaps == 8)
+        sum = _mm256_add_epi16(sum, _mm256_add_epi16(MADDUBS_PAIR(2), MADDUBS_PAIR(3)));
+#undef MADDUBS_PAIR
+    return sum;
+}
+
+static av_always_inline __m256i load_row_v_8(const uint8_t *src, int n)
+{
+    __m128i r = n == 16 ? _mm_loadu_si128((const __m128i *) src) :
+                          _mm_loadl_epi64((const __m128i *) src);
+    return _mm256_permute4x64_epi64(_mm256_castsi128_si256(r), 0x10);
+}
+
+static av_always_inline __m256i filter_v_8(const __m256i *v, const __m256i *c, int ntaps)
+{
+#define MADDUBS_PAIR(i) _mm256_maddubs_epi16(_mm256_unpacklo_epi8(v[i], v[i + 1]), c[i >> 1])
+    __m256i sum = _mm256_add_epi16(MADDUBS_PAIR(0), MADDUBS_PAIR(2));
+
+    if (ntaps == 8)
+        sum = _mm256_add_epi16(sum, _mm256_add_epi16(MADDUBS_PAIR(4), MADDUBS_PAIR(6)));
+#undef MADDUBS_PAIR
+    return sum;
+}
+
+static av_always_inline __m256i filter_h(const uint8_t *src, const __m256i *c,
+                                         int ntaps, int n, int bit_depth)
+{
+    const int16_t *s = (const int16_t *) src - (ntaps / 2 - 1);
+    __m256i v[8];
+
+    if (bit_depth == 8)
+        return filter_h_8(src, c, ntaps, n);
+
+    v[0] = load_int16(s,     n);
+    v[1] = load_int16(s + 1, n);
+    v[2] = load_int16(s + 2, n);
+    v[3] = load_int16(s + 3, n);
+    if (ntaps == 8) {
+        v[4] = load_int16(s + 4, n);
+        v[5] = load_int16(s + 5, n);
+        v[6] = load_int16(s + 6, n);
+        v[7] = load_int16(s + 7, n);
+    }
+    return filter_taps(v, c, ntaps, bit_depth - 8);
+}
+
+/* Finishes one row of 16 (or 8) intermediate samples. */
+static av_always_inline void mc_store(int op, uint8_t *dst, const int16_t *src2,
+                                      __m256i v, const MCWeight *w, int n, int bit_depth)
+{
+    const int shift = 14 - bit_depth;
+    __m256i lo, hi;
+
+    switch (op) {
+    case MC_OP_PUT:
+        store_int16((int16_t *) dst, v, n);
+        break;
+    case MC_OP_UNI:
+        v = _mm256_adds_epi16(v, _mm256_set1_epi16(1 << (shift - 1)));
+        store_pixels(dst, _mm256_srai_epi16(v, shift), n, bit_depth);
+        break;
+    case MC_OP_BI:
+        /* saturation only kicks in where the result clips anyway */
+        v = _mm256_adds_epi16(v, load_int16(src2, n));
+        v = _mm256_adds_epi16(v, _mm256_set1_epi16(1 << shift));
+        store_pixels(dst, _mm256_srai_epi16(v, shift + 1), n, bit_depth);
+        break;
+    case MC_OP_UNI_W:
+        lo = _mm256_mullo_epi16(v, w->w);
+        hi = _mm256_mulhi_epi16(v, w->w);
+        v  = _mm256_unpacklo_epi16(lo, hi);
+        hi = _mm256_unpackhi_epi16(lo, hi);
+        lo = _mm256_sra_epi32(_mm256_add_epi32(v,  w->offset), w->shift);
+        hi = _mm256_sra_epi32(_mm256_add_epi32(hi, w->offset), w->shift);
+        lo = _mm256_add_epi32(lo, w->ox);
+        hi = _mm256_add_epi32(hi, w->ox);
+        store_pixels(dst, _mm256_packs_epi32(lo, hi), n, bit_depth);
+        break;
+    case MC_OP_BI_W:
+        hi = load_int16(src2, n);
+        lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(v, hi), w->w);
+        hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(v, hi), w->w);
+        lo = _mm256_sra_epi32(_mm256_add_epi32(lo, w->offset), w->shift);
+        hi = _mm256_sra_epi32(_mm256_add_epi32(hi, w->offset), w->shift);
+        store_pixels(dst, _mm256_packs_epi32(lo, hi), n, bit_depth);
+        break;
+    }
+}
+
+/* One column of n samples for MC_PIXELS and MC_H. */
+static av_always_inline void mc_column_h(int op, int type, int ntaps, int bit_depth, int n,
+                                         uint8_t *dst, ptrdiff_t dststride,
+                                         const uint8_t *src, ptrdiff_t srcstride,
+                                         const int16_t *src2, ptrdiff_t src2stride, int height,
+                                         const __m256i *c, const MCWeight *w)
+{
+    int y;
+
+    for (y = 0; y < height; y++) {
+        __m256i v;
+        if (type == MC_PIXELS)
+            v = _mm256_slli_epi16(load_pixels(src, n, bit_depth), 14 - bit_depth);
+        else
+            v = filter_h(src, c, ntaps, n, bit_depth);
+        mc_store(op, dst, src2, v, w, n, bit_depth);
+        src  += srcstride;
+        dst  += dststride;
+        src2 += src2stride;
+    }
+}
+
+/*
+ * One column of n samples filtered vertically, either from pixels (MC_V)
+ * or from the 16-bit horizontal pass (MC_HV); the taps slide down the
+ * column so each source row is loaded once.
+ */
+static av_always_inline void mc_column_v(int op, int type, int ntaps, int bit_depth, int n,
+                                         uint8_t *dst, ptrdiff_t dststride,
+                                         const uint8_t *src, ptrdiff_t srcstride,
+                                         const int16_t *src2, ptrdiff_t src2stride, int height,
+                                         const __m256i *c, const MCWeight *w)
+{
+    const int shift = type == MC_HV ? 6 : bit_depth - 8;
+    const int bytes = type == MC_V && bit_depth == 8;
+    __m256i v[8];
+    int y;
+
+#define LOAD_ROW(src) (type == MC_HV ? load_int16((const int16_t *) (src), n) :  \
+                       bytes ? load_row_v_8(src, n) : load_int16((const int16_t *) (src), n))
+    src -= (ntaps / 2 - 1) * srcstride;
+    v[0] = LOAD_ROW(src);
+    v[1] = LOAD_ROW(src +     srcstride);
+    v[2] = LOAD_ROW(src + 2 * srcstride);
+    if (ntaps == 8) {
+        v[3] = LOAD_ROW(src + 3 * srcstride);
+        v[4] = LOAD_ROW(src + 4 * srcstride);
+        v[5] = LOAD_ROW(src + 5 * srcstride);
+        v[6] = LOAD_ROW(src + 6 * srcstride);
+    }
+    src += (ntaps - 1) * srcstride;
+    for (y = 0; y < height; y++) {
+        v[ntaps - 1] = LOAD_ROW(src);
+        mc_store(op, dst, src2, bytes ? filter_v_8(v, c, ntaps) : filter_taps(v, c, ntaps, shift),
+                 w, n, bit_depth);
+        v[0] = v[1];
+        v[1] = v[2];
+        v[2] = v[3];
+        if (ntaps == 8) {
+            v[3] = v[4];
+            v[4] = v[5];
+            v[5] = v[6];
+            v[6] = v[7];
+        }
+        src  += srcstride;
+        dst  += dststride;
+        src2 += src2stride;
+    }
+#undef LOAD_ROW
+}
+
+static av_always_inline void mc_block(int op, int type, int ntaps, int bit_depth, int width,
+                                      uint8_t *dst, ptrdiff_t dststride,
+                                      const uint8_t *src, ptrdiff_t srcstride,
+                                      const int16_t *src2, ptrdiff_t src2stride, int height,
+                                      int denom, int wx0, int wx1, int ox0, int ox1,
+                                      intptr_t mx, intptr_t my)
+{
+    const int pel   = bit_depth > 8 ? 2 : 1;
+    const int dpel  = op == MC_OP_PUT ? 2 : pel;
+    DECLARE_ALIGNED(32, int16_t, tmp_array)[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
+    __m256i c[4];
+    MCWeight w;
+    int x;
+
+    if (op == MC_OP_UNI_W) {
+        int shift = denom + 14 - bit_depth;
+        w.w      = _mm256_set1_epi16(wx0);
+        w.offset = _mm256_set1_epi32(1 << (shift - 1));
+        w.ox     = _mm256_set1_epi32(ox0 * (1 << (bit_depth - 8)));
+        w.shift  = _mm_cvtsi32_si128(shift);
+    } else if (op == MC_OP_BI_W) {
+        int log2Wd = denom + 14 - bit_depth;
+        ox0 = ox0 * (1 << (bit_depth - 8));
+        ox1 = ox1 * (1 << (bit_depth - 8));
+        w.w      = _mm256_set1_epi32((wx1 & 0xFFFF) | (wx0 << 16));
+        w.offset = _mm256_set1_epi32((ox0 + ox1 + 1) << log2Wd);
+        w.shift  = _mm_cvtsi32_si128(log2Wd + 1);
+    }
+
+    if (type == MC_HV) {
+        const int extra_before = ntaps / 2 - 1;
+        const uint8_t *s = src - extra_before * srcstride;
+        int16_t *tmp     = tmp_array;
+        int y;
+
+        load_filter(c, mx, ntaps, bit_depth == 8);
+        for (y = 0; y < height + ntaps - 1; y++) {
+            for (x = 0; x + 16 <= width; x += 16)
+                store_int16(tmp + x, filter_h(s + x * pel, c, ntaps, 16, bit_depth), 16);
+            if (width & 8)
+                store_int16(tmp + x, filter_h(s + x * pel, c, ntaps, 8, bit_depth), 8);
+            s   += srcstride;
+            tmp += MAX_PB_SIZE;
+        }
+        src       = (const uint8_t *) (tmp_array + extra_before * MAX_PB_SIZE);
+        srcstride = MAX_PB_SIZE * sizeof(int16_t);
+        load_filter(c, my, ntaps, 0);
+    } else if (type == MC_H) {
+        load_filter(c, mx, ntaps, bit_depth == 8);
+    } else if (type == MC_V) {
+        load_filter(c, my, ntaps, bit_depth == 8);
+    }
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        const uint8_t *s = src + x * (type == MC_HV ? 2 : pel);
+        if (type == MC_PIXELS || type == MC_H)
+            mc_column_h(op, type, ntaps, bit_depth, 16, dst + x * dpel, dststride,
+                        s, srcstride, src2 + x, src2stride, height, c, &w);
+        else
+            mc_column_v(op, type, ntaps, bit_depth, 16, dst + x * dpel, dststride,
+                        s, srcstride, src2 + x, src2stride, height, c, &w);
+    }
+    if (width & 8) {
+        const uint8_t *s = src + x * (type == MC_HV ? 2 : pel);
+        if (type == MC_PIXELS || type == MC_H)
+            mc_column_h(op, type, ntaps, bit_depth, 8, dst + x * dpel, dststride,
+                        s, srcstride, src2 + x, src2stride, height, c, &w);
+        else
+            mc_column_v(op, type, ntaps, bit_depth, 8, dst + x * dpel, dststride,
+                        s, srcstride, src2 + x, src2stride, height, c, &w);
+    }
+}
+
+#define MC_FUNCS(name, type, ntaps, W, D)                                                       \
+void ff_hevc_put_hevc_ ## name ## W ## _ ## D ## _avx2(int16_t *dst, ptrdiff_t dststride,        \
+                                                       uint8_t *_src, ptrdiff_t _srcstride,      \
+                                                       int height, intptr_t mx, intptr_t my,     \
+                                                       int width)                                \
+{                                                                                               \
+    mc_block(MC_OP_PUT, type, ntaps, D, W, (uint8_t *) dst, dststride * sizeof(int16_t),        \
+             _src, _srcstride, NULL, 0, height, 0, 0, 0, 0, 0, mx, my);                            \
+}                                                                                               \
+void ff_hevc_put_hevc_uni_ ## name ## W ## _ ## D ## _avx2(uint8_t *_dst, ptrdiff_t _dststride, \
+                                                           uint8_t *_src, ptrdiff_t _srcstride,  \
+                                                           int height, intptr_t mx, intptr_t my, \
+                                                           int width)                            \
+{                                                                                               \
+    mc_block(MC_OP_UNI, type, ntaps, D, W, _dst, _dststride, _src, _srcstride, NULL, 0,         \
+             height, 0, 0, 0, 0, 0, mx, my);                                                    \
+}                                                                                               \
+void ff_hevc_put_hevc_bi_ ## name ## W ## _ ## D ## _avx2(uint8_t *_dst, ptrdiff_t _dststride,  \
+                                                          uint8_t *_src, ptrdiff_t _srcstride,   \
+                                                          int16_t *src2, ptrdiff_t src2stride,   \
+                                                          int height, intptr_t mx, intptr_t my,  \
+                                                          int width)                             \
+{                                                                                               \
+    mc_block(MC_OP_BI, type, ntaps, D, W, _dst, _dststride, _src, _srcstride, src2, src2stride, \
+             height, 0, 0, 0, 0, 0, mx, my);                                                    \
+}                                                                                               \
+void ff_hevc_put_hevc_uni_w_ ## name ## W ## _ ## D ## _avx2(uint8_t *_dst, ptrdiff_t _dststride, \
+                                                             uint8_t *_src, ptrdiff_t _srcstride, \
+                                                             int height, int denom, int wx, int ox, \
+                                                             intptr_t mx, intptr_t my, int width) \
+{                                                                                               \
+    mc_block(MC_OP_UNI_W, type, ntaps, D, W, _dst, _dststride, _src, _srcstride, NULL, 0,       \
+             height, denom, wx, 0, ox, 0, mx, my);                                              \
+}                                                                                               \
+void ff_hevc_put_hevc_bi_w_ ## name ## W ## _ ## D ## _avx2(uint8_t *_dst, ptrdiff_t _dststride, \
+                                                            uint8_t *_src, ptrdiff_t _srcstride, \
+                                                            int16_t *src2, ptrdiff_t src2stride, \
+                                                            int height, int denom, int wx0, int wx1, \
+                                                            int ox0, int ox1, intptr_t mx,      \
+                                                            intptr_t my, int width)             \
+{                                                                                               \
+    mc_block(MC_OP_BI_W, type, ntaps, D, W, _dst, _dststride, _src, _srcstride, src2, src2stride, \
+             height, denom, wx0, wx1, ox0, ox1, mx, my);                                        \
+}
+
+#define MC_WIDTHS(name, type, ntaps, D)  \
+    MC_FUNCS(name, type, ntaps, 16, D)   \
+    MC_FUNCS(name, type, ntaps, 24, D)   \
+    MC_FUNCS(name, type, ntaps, 32, D)   \
+    MC_FUNCS(name, type, ntaps, 48, D)   \
+    MC_FUNCS(name, type, ntaps, 64, D)
+
+#define MC_ALL(D)                              \
+    MC_WIDTHS(pel_pixels, MC_PIXELS, 8, D)     \
+    MC_WIDTHS(epel_h,     MC_H,      4, D)     \
+    MC_WIDTHS(epel_v,     MC_V,      4, D)     \
+    MC_WIDTHS(epel_hv,    MC_HV,     4, D)     \
+    MC_WIDTHS(qpel_h,     MC_H,      8, D)     \
+    MC_WIDTHS(qpel_v,     MC_V,      8, D)     \
+    MC_WIDTHS(qpel_hv,    MC_HV,     8, D)
+
+MC_ALL(8)
+MC_ALL(10)
+MC_ALL(12)
+
+#endif // HAVE_AVX2_MC
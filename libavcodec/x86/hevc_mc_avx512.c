@@ -0,0 +1,310 @@
+/*
+ * Provide AVX-512 MC functions for HEVC decoding
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/avassert.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX512
+#include <immintrin.h>
+
+/*
+ * Same scheme as hevc_mc_avx2.c with 32 samples per register, for the
+ * two calls of a bi-predicted block: the 16-bit put of the first list and
+ * the bi average of the second.  Only the 32 and 64 wide classes are
+ * provided, narrower blocks do not fill a zmm register.
+ */
+
+enum {
+    MC_PIXELS,
+    MC_H,
+    MC_V,
+    MC_HV,
+};
+
+DECLARE_ALIGNED(64, static const int8_t, mc_h_shuf_avx512)[4][64] = {
+#define SHUF(o) o, o + 1, o + 1, o + 2, o + 2, o + 3, o + 3, o + 4, \
+                o + 4, o + 5, o + 5, o + 6, o + 6, o + 7, o + 7, o + 8
+    { SHUF(0), SHUF(0), SHUF(0), SHUF(0) },
+    { SHUF(2), SHUF(2), SHUF(2), SHUF(2) },
+    { SHUF(4), SHUF(4), SHUF(4), SHUF(4) },
+    { SHUF(6), SHUF(6), SHUF(6), SHUF(6) },
+#undef SHUF
+};
+
+static av_always_inline __m512i load_pixels(const uint8_t *src, int bit_depth)
+{
+    if (bit_depth == 8)
+        return _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *) src));
+    return _mm512_loadu_si512(src);
+}
+
+static av_always_inline void store_pixels(uint8_t *dst, __m512i v, int bit_depth)
+{
+    v = _mm512_max_epi16(v, _mm512_setzero_si512());
+    if (bit_depth == 8) {
+        _mm256_storeu_si256((__m256i *) dst, _mm512_cvtusepi16_epi8(v));
+    } else {
+        v = _mm512_min_epi16(v, _mm512_set1_epi16((1 << bit_depth) - 1));
+        _mm512_storeu_si512(dst, v);
+    }
+}
+
+static av_always_inline void load_filter(__m512i *c, intptr_t m, int ntaps, int bytes)
+{
+    const int8_t *filter = ntaps == 8 ? ff_hevc_qpel_filters[m - 1] : ff_hevc_epel_filters[m - 1];
+#define TAP_PAIR(i) (bytes ? _mm512_set1_epi16((filter[i] & 0xFF) | (filter[i + 1] << 8)) : \
+                             _mm512_set1_epi32((filter[i] & 0xFFFF) | (filter[i + 1] << 16)))
+    c[0] = TAP_PAIR(0);
+    c[1] = TAP_PAIR(2);
+    if (ntaps == 8) {
+        c[2] = TAP_PAIR(4);
+        c[3] = TAP_PAIR(6);
+    }
+#undef TAP_PAIR
+}
+
+static av_always_inline __m512i filter_taps(const __m512i *v, const __m512i *c,
+                                            int ntaps, int shift)
+{
+#define MADD_PAIR(unpack, i) _mm512_madd_epi16(unpack(v[i], v[i + 1]), c[i >> 1])
+    __m512i lo = _mm512_add_epi32(MADD_PAIR(_mm512_unpacklo_epi16, 0), MADD_PAIR(_mm512_unpacklo_epi16, 2));
+    __m512i hi = _mm512_add_epi32(MADD_PAIR(_mm512_unpackhi_epi16, 0), MADD_PAIR(_mm512_unpackhi_epi16, 2));
+
+    if (ntaps == 8) {
+        lo = _mm512_add_epi32(lo, _mm512_add_epi32(MADD_PAIR(_mm512_unpacklo_epi16, 4),
+                                                   MADD_PAIR(_mm512_unpacklo_epi16, 6)));
+        hi = _mm512_add_epi32(hi, _mm512_add_epi32(MADD_PAIR(_mm512_unpackhi_epi16, 4),
+                                                   MADD_PAIR(_mm512_unpackhi_epi16, 6)));
+    }
+#undef MADD_PAIR
+    if (shift) {
+        lo = _mm512_srai_epi32(lo, shift);
+        hi = _mm512_srai_epi32(hi, shift);
+    }
+    return _mm512_packs_epi32(lo, hi);
+}
+
+/* 8-bit horizontal taps: lane l of the register holds the source of
+ * outputs 8 * l to 8 * l + 7. */
+static av_always_inline __m512i filter_h_8(const uint8_t *src, const __m512i *c, int ntaps)
+{
+    __m512i r, sum;
+
+    src -= ntaps / 2 - 1;
+    r = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *) src)),
+                           _mm256_loadu_si256((const __m256i *) (src + 8)), 1);
+    r = _mm512_shuffle_i64x2(r, r, _MM_SHUFFLE(3, 1, 2, 0));
+#define MADDUBS_PAIR(i) _mm512_maddubs_epi16(_mm512_shuffle_epi8(r, *(const __m512i *) mc_h_shuf_avx512[i]), c[i])
+    sum = _mm512_add_epi16(MADDUBS_PAIR(0), MADDUBS_PAIR(1));
+    if (ntaps == 8)
+        sum = _mm512_add_epi16(sum, _mm512_add_epi16(MADDUBS_PAIR(2), MADDUBS_PAIR(3)));
+#undef MADDUBS_PAIR
+    return sum;
+}
+
+static av_always_inline __m512i load_row_v_8(const uint8_t *src)
+{
+    const __m512i idx = _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+    return _mm512_permutexvar_epi64(idx, _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *) src)));
+}
+
+static av_always_inline __m512i filter_v_8(const __m512i *v, const __m512i *c, int ntaps)
+{
+#define MADDUBS_PAIR(i) _mm512_maddubs_epi16(_mm512_unpacklo_epi8(v[i], v[i + 1]), c[i >> 1])
+    __m512i sum = _mm512_add_epi16(MADDUBS_PAIR(0), MADDUBS_PAIR(2));
+
+    if (ntaps == 8)
+        sum = _mm512_add_epi16(sum, _mm512_add_epi16(MADDUBS_PAIR(4), MADDUBS_PAIR(6)));
+#undef MADDUBS_PAIR
+    return sum;
+}
+
+static av_always_inline __m512i filter_h(const uint8_t *src, const __m512i *c,
+                                         int ntaps, int bit_depth)
+{
+    const int16_t *s = (const int16_t *) src - (ntaps / 2 - 1);
+    __m512i v[8];
+
+    if (bit_depth == 8)
+        return filter_h_8(src, c, ntaps);
+
+    v[0] = _mm512_loadu_si512(s);
+    v[1] = _mm512_loadu_si512(s + 1);
+    v[2] = _mm512_loadu_si512(s + 2);
+    v[3] = _mm512_loadu_si512(s + 3);
+    if (ntaps == 8) {
+        v[4] = _mm512_loadu_si512(s + 4);
+        v[5] = _mm512_loadu_si512(s + 5);
+        v[6] = _mm512_loadu_si512(s + 6);
+        v[7] = _mm512_loadu_si512(s + 7);
+    }
+    return filter_taps(v, c, ntaps, bit_depth - 8);
+}
+
+/* put (src2 == NULL) writes the 14-bit intermediate, bi averages it with src2 */
+static av_always_inline void mc_store(uint8_t *dst, const int16_t *src2, __m512i v, int bit_depth)
+{
+    const int shift = 14 + 1 - bit_depth;
+
+    if (!src2) {
+        _mm512_storeu_si512(dst, v);
+        return;
+    }
+    /* saturation only kicks in where the result clips anyway */
+    v = _mm512_adds_epi16(v, _mm512_loadu_si512(src2));
+    v = _mm512_adds_epi16(v, _mm512_set1_epi16(1 << (shift - 1)));
+    store_pixels(dst, _mm512_srai_epi16(v, shift), bit_depth);
+}
+
+static av_always_inline void mc_column(int type, int ntaps, int bit_depth,
+                                       uint8_t *dst, ptrdiff_t dststride,
+                                       const uint8_t *src, ptrdiff_t srcstride,
+                                       const int16_t *src2, ptrdiff_t src2stride,
+                                       int height, const __m512i *c)
+{
+    const int bytes = type == MC_V && bit_depth == 8;
+    const int shift = type == MC_HV ? 6 : bit_depth - 8;
+    __m512i v[8];
+    int y;
+
+    if (type == MC_PIXELS || type == MC_H) {
+        for (y = 0; y < height; y++) {
+            if (type == MC_PIXELS)
+                mc_store(dst, src2, _mm512_slli_epi16(load_pixels(src, bit_depth), 14 - bit_depth), bit_depth);
+            else
+                mc_store(dst, src2, filter_h(src, c, ntaps, bit_depth), bit_depth);
+            src  += srcstride;
+            dst  += dststride;
+            if (src2)
+                src2 += src2stride;
+        }
+        return;
+    }
+
+#define LOAD_ROW(src) (bytes ? load_row_v_8(src) : _mm512_loadu_si512(src))
+    src -= (ntaps / 2 - 1) * srcstride;
+    v[0] = LOAD_ROW(src);
+    v[1] = LOAD_ROW(src +     srcstride);
+    v[2] = LOAD_ROW(src + 2 * srcstride);
+    if (ntaps == 8) {
+        v[3] = LOAD_ROW(src + 3 * srcstride);
+        v[4] = LOAD_ROW(src + 4 * srcstride);
+        v[5] = LOAD_ROW(src + 5 * srcstride);
+        v[6] = LOAD_ROW(src + 6 * srcstride);
+    }
+    src += (ntaps - 1) * srcstride;
+    for (y = 0; y < height; y++) {
+        v[ntaps - 1] = LOAD_ROW(src);
+        mc_store(dst, src2, bytes ? filter_v_8(v, c, ntaps) : filter_taps(v, c, ntaps, shift), bit_depth);
+        v[0] = v[1];
+        v[1] = v[2];
+        v[2] = v[3];
+        if (ntaps == 8) {
+            v[3] = v[4];
+            v[4] = v[5];
+            v[5] = v[6];
+            v[6] = v[7];
+        }
+        src  += srcstride;
+        dst  += dststride;
+        if (src2)
+            src2 += src2stride;
+    }
+#undef LOAD_ROW
+}
+
+static av_always_inline void mc_block(int type, int ntaps, int bit_depth, int width,
+                                      uint8_t *dst, ptrdiff_t dststride,
+                                      const uint8_t *src, ptrdiff_t srcstride,
+                                      const int16_t *src2, ptrdiff_t src2stride,
+                                      int height, intptr_t mx, intptr_t my)
+{
+    const int pel  = bit_depth > 8 ? 2 : 1;
+    const int dpel = src2 ? pel : 2;
+    DECLARE_ALIGNED(64, int16_t, tmp_array)[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
+    __m512i c[4];
+    int x;
+
+    if (type == MC_HV) {
+        const uint8_t *s = src - (ntaps / 2 - 1) * srcstride;
+        int16_t *tmp     = tmp_array;
+        int y;
+
+        load_filter(c, mx, ntaps, bit_depth == 8);
+        for (y = 0; y < height + ntaps - 1; y++) {
+            for (x = 0; x < width; x += 32)
+                _mm512_store_si512(tmp + x, filter_h(s + x * pel, c, ntaps, bit_depth));
+            s   += srcstride;
+            tmp += MAX_PB_SIZE;
+        }
+        src       = (const uint8_t *) (tmp_array + (ntaps / 2 - 1) * MAX_PB_SIZE);
+        srcstride = MAX_PB_SIZE * sizeof(int16_t);
+        load_filter(c, my, ntaps, 0);
+    } else if (type == MC_H) {
+        load_filter(c, mx, ntaps, bit_depth == 8);
+    } else if (type == MC_V) {
+        load_filter(c, my, ntaps, bit_depth == 8);
+    }
+
+    for (x = 0; x < width; x += 32)
+        mc_column(type, ntaps, bit_depth, dst + x * dpel, dststride,
+                  src + x * (type == MC_HV ? 2 : pel), srcstride,
+                  src2 ? src2 + x : NULL, src2stride, height, c);
+}
+
+#define MC_FUNCS(name, type, ntaps, W, D)                                                         \
+void ff_hevc_put_hevc_ ## name ## W ## _ ## D ## _avx512(int16_t *dst, ptrdiff_t dststride,        \
+                                                         uint8_t *_src, ptrdiff_t _srcstride,      \
+                                                         int height, intptr_t mx, intptr_t my,     \
+                                                         int width)                                \
+{                                                                                                 \
+    mc_block(type, ntaps, D, W, (uint8_t *) dst, dststride * sizeof(int16_t),                     \
+             _src, _srcstride, NULL, 0, height, mx, my);                                          \
+}                                                                                                 \
+void ff_hevc_put_hevc_bi_ ## name ## W ## _ ## D ## _avx512(uint8_t *_dst, ptrdiff_t _dststride,  \
+                                                            uint8_t *_src, ptrdiff_t _srcstride,   \
+                                                            int16_t *src2, ptrdiff_t src2stride,   \
+                                                            int height, intptr_t mx, intptr_t my,  \
+                                                            int width)                             \
+{                                                                                                 \
+    mc_block(type, ntaps, D, W, _dst, _dststride, _src, _srcstride, src2, src2stride,             \
+             height, mx, my);                                                                     \
+}
+
+#define MC_WIDTHS(name, type, ntaps, D)  \
+    MC_FUNCS(name, type, ntaps, 32, D)   \
+    MC_FUNCS(name, type, ntaps, 64, D)
+
+#define MC_ALL(D)                              \
+    MC_WIDTHS(pel_pixels, MC_PIXELS, 8, D)     \
+    MC_WIDTHS(epel_h,     MC_H,      4, D)     \
+    MC_WIDTHS(epel_v,     MC_V,      4, D)     \
+    MC_WIDTHS(epel_hv,    MC_HV,     4, D)     \
+    MC_WIDTHS(qpel_h,     MC_H,      8, D)     \
+    MC_WIDTHS(qpel_v,     MC_V,      8, D)     \
+    MC_WIDTHS(qpel_hv,    MC_HV,     8, D)
+
+MC_ALL(8)
+MC_ALL(10)
+MC_ALL(12)
+
+#endif // HAVE_AVX512
@@ -0,0 +1,326 @@
+/*
+ * Provide AVX2 sao functions for HEVC decoding
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/avassert.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX2
+#include <immintrin.h>
+
+/*
+ * One 256-bit register holds 32 samples at 8 bit and 16 at 10/12 bit.  The
+ * SAO offset is looked up with vpshufb from a table of at most five entries
+ * (bytes at 8 bit, words otherwise), so band and edge classes cost the same.
+ * Row tails narrower than a register are done with 16, 8 and 4 byte blocks,
+ * which keeps every store inside the CTB: picture widths are a multiple of
+ * the minimum CB size, so chroma rows are always a multiple of 4 samples.
+ */
+
+static av_always_inline __m256i load_block(const uint8_t *p, int n)
+{
+    if (n == 32)
+        return _mm256_loadu_si256((const __m256i *) p);
+    if (n == 16)
+        return _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) p));
+    if (n == 8)
+        return _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *) p));
+    return _mm256_castsi128_si256(_mm_cvtsi32_si128(*(const int32_t *) p));
+}
+
+static av_always_inline void store_block(uint8_t *p, __m256i v, int n)
+{
+    if (n == 32)
+        _mm256_storeu_si256((__m256i *) p, v);
+    else if (n == 16)
+        _mm_storeu_si128((__m128i *) p, _mm256_castsi256_si128(v));
+    else if (n == 8)
+        _mm_storel_epi64((__m128i *) p, _mm256_castsi256_si128(v));
+    else
+        *(int32_t *) p = _mm_cvtsi128_si32(_mm256_castsi256_si128(v));
+}
+
+/* 5-entry offset table, broadcast to both lanes */
+static av_always_inline __m256i offset_table(const int16_t *val, int high)
+{
+    if (high)
+        return _mm256_setr_epi16(val[0], val[1], val[2], val[3], val[4], 0, 0, 0,
+                                 val[0], val[1], val[2], val[3], val[4], 0, 0, 0);
+    return _mm256_setr_epi8(val[0], val[1], val[2], val[3], val[4], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                            val[0], val[1], val[2], val[3], val[4], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+/* look up the offsets for word indices 0..4 */
+static av_always_inline __m256i lookup_16(__m256i table, __m256i idx)
+{
+    idx = _mm256_slli_epi16(idx, 1);
+    idx = _mm256_or_si256(idx, _mm256_slli_epi16(idx, 8));
+    return _mm256_shuffle_epi8(table, _mm256_add_epi16(idx, _mm256_set1_epi16(0x0100)));
+}
+
+static av_always_inline __m256i add_clip(__m256i px, __m256i off, int bit_depth)
+{
+    if (bit_depth == 8) {
+        /* saturating add of a signed byte to an unsigned one */
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i pos  = _mm256_max_epi8(off, zero);
+        const __m256i neg  = _mm256_max_epi8(_mm256_sub_epi8(zero, off), zero);
+        return _mm256_subs_epu8(_mm256_adds_epu8(px, pos), neg);
+    }
+    px = _mm256_add_epi16(px, off);
+    px = _mm256_max_epi16(px, _mm256_setzero_si256());
+    return _mm256_min_epi16(px, _mm256_set1_epi16((1 << bit_depth) - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// band offset
+////////////////////////////////////////////////////////////////////////////////
+static av_always_inline void band_block(uint8_t *dst, uint8_t *save, int n,
+                                        __m256i table, __m256i left_class,
+                                        int bit_depth)
+{
+    const __m256i px = load_block(dst, n);
+    __m256i k;
+
+    store_block(save, px, n);
+    if (bit_depth == 8) {
+        k = _mm256_and_si256(_mm256_srli_epi16(px, 3), _mm256_set1_epi8(31));
+        k = _mm256_and_si256(_mm256_sub_epi8(k, left_class), _mm256_set1_epi8(31));
+        k = _mm256_shuffle_epi8(table, _mm256_min_epu8(k, _mm256_set1_epi8(4)));
+    } else {
+        k = _mm256_srli_epi16(px, bit_depth - 5);
+        k = _mm256_and_si256(_mm256_sub_epi16(k, left_class), _mm256_set1_epi16(31));
+        k = lookup_16(table, _mm256_min_epu16(k, _mm256_set1_epi16(4)));
+    }
+    store_block(dst, add_clip(px, k, bit_depth), n);
+}
+
+static av_always_inline void sao_band_filter(uint8_t *dst, uint8_t *save,
+                                             ptrdiff_t stride_dst, ptrdiff_t stride_save,
+                                             SAOParams *sao, int width, int height,
+                                             int c_idx, int bit_depth)
+{
+    const int16_t *val = sao->offset_val[c_idx];
+    const int16_t band[5] = { val[1], val[2], val[3], val[4], 0 };
+    const int bytes       = width << (bit_depth > 8);
+    const __m256i table   = offset_table(band, bit_depth > 8);
+    const __m256i lc      = bit_depth > 8 ? _mm256_set1_epi16(sao->band_position[c_idx])
+                                          : _mm256_set1_epi8(sao->band_position[c_idx]);
+    int x, y;
+
+    for (y = 0; y < height; y++) {
+        for (x = 0; x + 32 <= bytes; x += 32)
+            band_block(dst + x, save + x, 32, table, lc, bit_depth);
+        if (x + 16 <= bytes) {
+            band_block(dst + x, save + x, 16, table, lc, bit_depth);
+            x += 16;
+        }
+        if (x + 8 <= bytes) {
+            band_block(dst + x, save + x, 8, table, lc, bit_depth);
+            x += 8;
+        }
+        if (x < bytes)
+            band_block(dst + x, save + x, 4, table, lc, bit_depth);
+        dst  += stride_dst;
+        save += stride_save;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// edge offset
+////////////////////////////////////////////////////////////////////////////////
+static av_always_inline void edge_block(uint8_t *dst, const uint8_t *src,
+                                        ptrdiff_t off0, ptrdiff_t off1, int n,
+                                        __m256i table, int bit_depth)
+{
+    const __m256i a  = load_block(src, n);
+    const __m256i b0 = load_block(src + off0, n);
+    const __m256i b1 = load_block(src + off1, n);
+    __m256i s, m;
+
+    if (bit_depth == 8) {
+        /* sign(a - b) = (a <= b) - (b <= a) */
+        m = _mm256_min_epu8(a, b0);
+        s = _mm256_sub_epi8(_mm256_cmpeq_epi8(a, m), _mm256_cmpeq_epi8(b0, m));
+        m = _mm256_min_epu8(a, b1);
+        s = _mm256_add_epi8(s, _mm256_sub_epi8(_mm256_cmpeq_epi8(a, m), _mm256_cmpeq_epi8(b1, m)));
+        s = _mm256_shuffle_epi8(table, _mm256_add_epi8(s, _mm256_set1_epi8(2)));
+    } else {
+        s = _mm256_sub_epi16(_mm256_cmpgt_epi16(b0, a), _mm256_cmpgt_epi16(a, b0));
+        s = _mm256_add_epi16(s, _mm256_sub_epi16(_mm256_cmpgt_epi16(b1, a), _mm256_cmpgt_epi16(a, b1)));
+        s = lookup_16(table, _mm256_add_epi16(s, _mm256_set1_epi16(2)));
+    }
+    store_block(dst, add_clip(a, s, bit_depth), n);
+}
+
+static av_always_inline void sao_edge_filter(uint8_t *_dst, uint8_t *_src,
+                                             ptrdiff_t stride_dst, ptrdiff_t stride_src,
+                                             SAOParams *sao, int *borders,
+                                             int _width, int _height, int c_idx,
+                                             int bit_depth)
+{
+    static const uint8_t edge_idx[] = { 1, 2, 0, 3, 4 };
+    static const int8_t pos[4][2][2] = {
+        { { -1,  0 }, {  1, 0 } }, // horizontal
+        { {  0, -1 }, {  0, 1 } }, // vertical
+        { { -1, -1 }, {  1, 1 } }, // 45 degree
+        { {  1, -1 }, { -1, 1 } }, // 135 degree
+    };
+    const int16_t *sao_offset_val = sao->offset_val[c_idx];
+    const int sao_eo_class        = sao->eo_class[c_idx];
+    const int pixel_shift         = bit_depth > 8;
+    const int16_t val[5]          = { sao_offset_val[edge_idx[0]], sao_offset_val[edge_idx[1]],
+                                      sao_offset_val[edge_idx[2]], sao_offset_val[edge_idx[3]],
+                                      sao_offset_val[edge_idx[4]] };
+    const __m256i table           = offset_table(val, pixel_shift);
+    const ptrdiff_t off0 = pos[sao_eo_class][0][1] * stride_src + (pos[sao_eo_class][0][0] << pixel_shift);
+    const ptrdiff_t off1 = pos[sao_eo_class][1][1] * stride_src + (pos[sao_eo_class][1][0] << pixel_shift);
+    const int bytes      = _width << pixel_shift;
+    int init_y = 0, height = _height;
+    int x, y;
+
+    /* sao_offset_val[0] is always 0: samples on a picture border are kept */
+    if (sao_eo_class != SAO_EO_HORIZ) {
+        if (borders[1]) {
+            memcpy(_dst, _src, bytes);
+            init_y = 1;
+        }
+        if (borders[3]) {
+            memcpy(_dst + (_height - 1) * stride_dst, _src + (_height - 1) * stride_src, bytes);
+            height--;
+        }
+    }
+
+    for (y = init_y; y < height; y++) {
+        uint8_t *dst       = _dst + y * stride_dst;
+        const uint8_t *src = _src + y * stride_src;
+
+        for (x = 0; x + 32 <= bytes; x += 32)
+            edge_block(dst + x, src + x, off0, off1, 32, table, bit_depth);
+        if (x + 16 <= bytes) {
+            edge_block(dst + x, src + x, off0, off1, 16, table, bit_depth);
+            x += 16;
+        }
+        if (x + 8 <= bytes) {
+            edge_block(dst + x, src + x, off0, off1, 8, table, bit_depth);
+            x += 8;
+        }
+        if (x < bytes)
+            edge_block(dst + x, src + x, off0, off1, 4, table, bit_depth);
+    }
+
+    if (sao_eo_class != SAO_EO_VERT) {
+        const int last = (_width - 1) << pixel_shift;
+        for (y = 0; y < height; y++) {
+            if (borders[0])
+                memcpy(_dst + y * stride_dst, _src + y * stride_src, 1 << pixel_shift);
+            if (borders[2])
+                memcpy(_dst + y * stride_dst + last, _src + y * stride_src + last, 1 << pixel_shift);
+        }
+    }
+}
+
+#define COPY_PIXEL(dx, dy)                                                     \
+    memcpy(dst + (dy) * stride_dst + ((dx) << pixel_shift),                    \
+           src + (dy) * stride_src + ((dx) << pixel_shift), 1 << pixel_shift)
+
+/* put back the samples next to slice and tile edges that must not be filtered */
+static av_always_inline void sao_edge_restore(uint8_t *dst, uint8_t *src,
+                                              ptrdiff_t stride_dst, ptrdiff_t stride_src,
+                                              SAOParams *sao, int *borders,
+                                              int _width, int _height, int c_idx,
+                                              uint8_t *vert_edge, uint8_t *horiz_edge,
+                                              uint8_t *diag_edge, int bit_depth)
+{
+    const int sao_eo_class = sao->eo_class[c_idx];
+    const int pixel_shift  = bit_depth > 8;
+    int init_x = 0, init_y = 0, width = _width, height = _height;
+    int save_upper_left  = !diag_edge[0] && sao_eo_class == SAO_EO_135D && !borders[0] && !borders[1];
+    int save_upper_right = !diag_edge[1] && sao_eo_class == SAO_EO_45D  && !borders[1] && !borders[2];
+    int save_lower_right = !diag_edge[2] && sao_eo_class == SAO_EO_135D && !borders[2] && !borders[3];
+    int save_lower_left  = !diag_edge[3] && sao_eo_class == SAO_EO_45D  && !borders[0] && !borders[3];
+    int x, y;
+
+    if (sao_eo_class != SAO_EO_VERT) {
+        if (borders[0])
+            init_x = 1;
+        if (borders[2])
+            width--;
+    }
+    if (sao_eo_class != SAO_EO_HORIZ) {
+        if (borders[3])
+            height--;
+    }
+
+    if (vert_edge[0] && sao_eo_class != SAO_EO_VERT)
+        for (y = init_y + save_upper_left; y < height - save_lower_left; y++)
+            COPY_PIXEL(0, y);
+    if (vert_edge[1] && sao_eo_class != SAO_EO_VERT)
+        for (y = init_y + save_upper_right; y < height - save_lower_right; y++)
+            COPY_PIXEL(width - 1, y);
+    if (horiz_edge[0] && sao_eo_class != SAO_EO_HORIZ)
+        for (x = init_x + save_upper_left; x < width - save_upper_right; x++)
+            COPY_PIXEL(x, 0);
+    if (horiz_edge[1] && sao_eo_class != SAO_EO_HORIZ)
+        for (x = init_x + save_lower_left; x < width - save_lower_right; x++)
+            COPY_PIXEL(x, height - 1);
+    if (diag_edge[0] && sao_eo_class == SAO_EO_135D)
+        COPY_PIXEL(0, 0);
+    if (diag_edge[1] && sao_eo_class == SAO_EO_45D)
+        COPY_PIXEL(width - 1, 0);
+    if (diag_edge[2] && sao_eo_class == SAO_EO_135D)
+        COPY_PIXEL(width - 1, height - 1);
+    if (diag_edge[3] && sao_eo_class == SAO_EO_45D)
+        COPY_PIXEL(0, height - 1);
+}
+
+#define SAO_FUNCS(D)                                                                    \
+void ff_hevc_sao_band_filter_0_ ## D ## _avx2(uint8_t *_dst, uint8_t *_src,            \
+        ptrdiff_t _stride_dst, ptrdiff_t _stride_src, struct SAOParams *sao,           \
+        int *borders, int width, int height, int c_idx)                                \
+{                                                                                       \
+    sao_band_filter(_dst, _src, _stride_dst, _stride_src, sao,                          \
+                    width, height, c_idx, D);                                           \
+}                                                                                       \
+void ff_hevc_sao_edge_filter_0_ ## D ## _avx2(uint8_t *_dst, uint8_t *_src,            \
+        ptrdiff_t _stride_dst, ptrdiff_t _stride_src, struct SAOParams *sao,           \
+        int *borders, int _width, int _height, int c_idx,                              \
+        uint8_t *vert_edge, uint8_t *horiz_edge, uint8_t *diag_edge)                   \
+{                                                                                       \
+    sao_edge_filter(_dst, _src, _stride_dst, _stride_src, sao, borders,                 \
+                    _width, _height, c_idx, D);                                         \
+}                                                                                       \
+void ff_hevc_sao_edge_filter_1_ ## D ## _avx2(uint8_t *_dst, uint8_t *_src,            \
+        ptrdiff_t _stride_dst, ptrdiff_t _stride_src, struct SAOParams *sao,           \
+        int *borders, int _width, int _height, int c_idx,                              \
+        uint8_t *vert_edge, uint8_t *horiz_edge, uint8_t *diag_edge)                   \
+{                                                                                       \
+    sao_edge_filter(_dst, _src, _stride_dst, _stride_src, sao, borders,                 \
+                    _width, _height, c_idx, D);                                         \
+    sao_edge_restore(_dst, _src, _stride_dst, _stride_src, sao, borders,                \
+                     _width, _height, c_idx, vert_edge, horiz_edge, diag_edge, D);      \
+}
+
+SAO_FUNCS(8)
+SAO_FUNCS(10)
+SAO_FUNCS(12)
+
+#endif // HAVE_AVX2
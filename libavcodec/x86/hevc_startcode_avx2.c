@@ -0,0 +1,72 @@
+/*
+ * Provide AVX2 start code scanning for HEVC
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/common.h"
+#include "libavutil/intmath.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_AVX2
+#include <immintrin.h>
+
+/* Same scheme as the SSE2 scanner, on 128 bytes per zero pair test. */
+
+static av_always_inline __m256i zero_pairs(const uint8_t *p)
+{
+    return _mm256_or_si256(_mm256_loadu_si256((const __m256i *) p),
+                           _mm256_loadu_si256((const __m256i *) (p + 1)));
+}
+
+static av_always_inline unsigned marker_mask(const uint8_t *p)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i three = _mm256_set1_epi8(3);
+    __m256i b0 = _mm256_loadu_si256((const __m256i *) p);
+    __m256i b1 = _mm256_loadu_si256((const __m256i *) (p + 1));
+    __m256i b2 = _mm256_loadu_si256((const __m256i *) (p + 2));
+
+    return _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(_mm256_or_si256(b0, b1), zero),
+                                                 _mm256_cmpeq_epi8(_mm256_subs_epu8(b2, three), zero)));
+}
+
+int ff_hevc_find_nal_marker_avx2(const uint8_t *buf, int size)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned mask;
+    int i, j;
+
+    for (i = 0; i + 130 <= size; i += 128) {
+        __m256i m = _mm256_min_epu8(_mm256_min_epu8(zero_pairs(buf + i),      zero_pairs(buf + i + 32)),
+                                    _mm256_min_epu8(zero_pairs(buf + i + 64), zero_pairs(buf + i + 96)));
+        if (!_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, zero)))
+            continue;
+        for (j = 0; j < 128; j += 32)
+            if ((mask = marker_mask(buf + i + j)))
+                return i + j + ff_ctz(mask);
+    }
+    for (; i + 34 <= size; i += 32)
+        if ((mask = marker_mask(buf + i)))
+            return i + ff_ctz(mask);
+    for (; i + 2 < size; i++)
+        if (!buf[i] && !buf[i + 1] && buf[i + 2] <= 3)
+            return i;
+    return size;
+}
+#endif // HAVE_AVX2
@@ -0,0 +1,79 @@
+/*
+ * Provide SSE2 start code scanning for HEVC
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/common.h"
+#include "libavutil/intmath.h"
+#include "libavcodec/x86/hevcdsp.h"
+
+#if HAVE_SSE2
+#include <emmintrin.h>
+
+/*
+ * 64 bytes are tested at once for two zero bytes in a row, which escaped
+ * slice data almost never holds; a test for a single zero byte, one in 256
+ * of random data, would send about every fifth block to the full test.  Only
+ * then are the three byte patterns of each 16-byte block checked, with the
+ * loads at +1 and +2 reading past the block: the loop stops 2 bytes before
+ * the end and the tail is done byte by byte.
+ */
+
+/* zero at the positions of two zero bytes */
+static av_always_inline __m128i zero_pairs(const uint8_t *p)
+{
+    return _mm_or_si128(_mm_loadu_si128((const __m128i *) p),
+                        _mm_loadu_si128((const __m128i *) (p + 1)));
+}
+
+static av_always_inline int marker_mask(const uint8_t *p)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i three = _mm_set1_epi8(3);
+    __m128i b0 = _mm_loadu_si128((const __m128i *) p);
+    __m128i b1 = _mm_loadu_si128((const __m128i *) (p + 1));
+    __m128i b2 = _mm_loadu_si128((const __m128i *) (p + 2));
+
+    return _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(b0, b1), zero),
+                                           _mm_cmpeq_epi8(_mm_subs_epu8(b2, three), zero)));
+}
+
+int ff_hevc_find_nal_marker_sse2(const uint8_t *buf, int size)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i, j, mask;
+
+    for (i = 0; i + 66 <= size; i += 64) {
+        __m128i m = _mm_min_epu8(_mm_min_epu8(zero_pairs(buf + i),      zero_pairs(buf + i + 16)),
+                                 _mm_min_epu8(zero_pairs(buf + i + 32), zero_pairs(buf + i + 48)));
+        if (!_mm_movemask_epi8(_mm_cmpeq_epi8(m, zero)))
+            continue;
+        for (j = 0; j < 64; j += 16)
+            if ((mask = marker_mask(buf + i + j)))
+                return i + j + ff_ctz(mask);
+    }
+    for (; i + 18 <= size; i += 16)
+        if ((mask = marker_mask(buf + i)))
+            return i + ff_ctz(mask);
+    for (; i + 2 < size; i++)
+        if (!buf[i] && !buf[i + 1] && buf[i + 2] <= 3)
+            return i;
+    return size;
+}
+#endif // HAVE_SSE2
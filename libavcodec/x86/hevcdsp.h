@@ -190,6 +190,55 @@ QPEL_PROTOTYPES(qpel_hv,  8, sse4);
 QPEL_PROTOTYPES(qpel_hv, 10, sse4);
 QPEL_PROTOTYPES(qpel_hv, 12, sse4);
 
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 MC, width classes 16 to 64 only (narrower blocks fit one SSE register)
+///////////////////////////////////////////////////////////////////////////////
+#define MC_AVX2_PROTOTYPES(fname, bitd) \
+        PEL_PROTOTYPE2(fname##16, bitd, avx2); \
+        PEL_PROTOTYPE2(fname##24, bitd, avx2); \
+        PEL_PROTOTYPE2(fname##32, bitd, avx2); \
+        PEL_PROTOTYPE2(fname##48, bitd, avx2); \
+        PEL_PROTOTYPE2(fname##64, bitd, avx2)
+
+#define MC_AVX2_ALL_PROTOTYPES(bitd) \
+        MC_AVX2_PROTOTYPES(pel_pixels, bitd); \
+        MC_AVX2_PROTOTYPES(epel_h,     bitd); \
+        MC_AVX2_PROTOTYPES(epel_v,     bitd); \
+        MC_AVX2_PROTOTYPES(epel_hv,    bitd); \
+        MC_AVX2_PROTOTYPES(qpel_h,     bitd); \
+        MC_AVX2_PROTOTYPES(qpel_v,     bitd); \
+        MC_AVX2_PROTOTYPES(qpel_hv,    bitd)
+
+MC_AVX2_ALL_PROTOTYPES(8);
+MC_AVX2_ALL_PROTOTYPES(10);
+MC_AVX2_ALL_PROTOTYPES(12);
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX-512 MC (put and bi of the 32 and 64 width classes), IDCT and deblocking
+///////////////////////////////////////////////////////////////////////////////
+#define MC_AVX512_PROTOTYPES(fname, bitd) \
+void ff_hevc_put_hevc_ ## fname ## 32_ ## bitd ## _avx512(int16_t *dst, ptrdiff_t dststride, uint8_t *_src, ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my, int width); \
+void ff_hevc_put_hevc_ ## fname ## 64_ ## bitd ## _avx512(int16_t *dst, ptrdiff_t dststride, uint8_t *_src, ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my, int width); \
+void ff_hevc_put_hevc_bi_ ## fname ## 32_ ## bitd ## _avx512(uint8_t *_dst, ptrdiff_t _dststride, uint8_t *_src, ptrdiff_t _srcstride, int16_t *src2, ptrdiff_t src2stride, int height, intptr_t mx, intptr_t my, int width); \
+void ff_hevc_put_hevc_bi_ ## fname ## 64_ ## bitd ## _avx512(uint8_t *_dst, ptrdiff_t _dststride, uint8_t *_src, ptrdiff_t _srcstride, int16_t *src2, ptrdiff_t src2stride, int height, intptr_t mx, intptr_t my, int width)
+
+#define AVX512_PROTOTYPES(bitd) \
+        MC_AVX512_PROTOTYPES(pel_pixels, bitd); \
+        MC_AVX512_PROTOTYPES(epel_h,     bitd); \
+        MC_AVX512_PROTOTYPES(epel_v,     bitd); \
+        MC_AVX512_PROTOTYPES(epel_hv,    bitd); \
+        MC_AVX512_PROTOTYPES(qpel_h,     bitd); \
+        MC_AVX512_PROTOTYPES(qpel_v,     bitd); \
+        MC_AVX512_PROTOTYPES(qpel_hv,    bitd); \
+void ff_hevc_transform_32x32_ ## bitd ## _avx512(int16_t *coeffs, int col_limit); \
+void ff_hevc_transform_32x32_add_ ## bitd ## _avx512(uint8_t *dst, int16_t *coeffs, ptrdiff_t stride); \
+void ff_hevc_h_loop_filter_luma_ ## bitd ## _avx512(uint8_t *pix, ptrdiff_t stride, int beta, int *tc, uint8_t *no_p, uint8_t *no_q); \
+void ff_hevc_v_loop_filter_luma_ ## bitd ## _avx512(uint8_t *pix, ptrdiff_t stride, int beta, int *tc, uint8_t *no_p, uint8_t *no_q)
+
+AVX512_PROTOTYPES(8);
+AVX512_PROTOTYPES(10);
+AVX512_PROTOTYPES(12);
+
 
 WEIGHTING_PROTOTYPES(8, sse4);
 WEIGHTING_PROTOTYPES(10, sse4);
@@ -256,6 +305,20 @@ void ff_hevc_sao_band_filter_0_10_sse(uint8_t *_dst, uint8_t *_src, ptrdiff_t _s
 void ff_hevc_sao_band_filter_0_12_sse(uint8_t *_dst, uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
                                       struct SAOParams *sao, int *borders, int width, int height, int c_idx);
 
+#define SAO_AVX2_PROTOTYPES(bitd) \
+void ff_hevc_sao_band_filter_0_ ## bitd ## _avx2(uint8_t *_dst, uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
+                                                 struct SAOParams *sao, int *borders, int width, int height, int c_idx); \
+void ff_hevc_sao_edge_filter_0_ ## bitd ## _avx2(uint8_t *_dst, uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
+                                                 struct SAOParams *sao, int *borders, int _width, int _height, int c_idx, \
+                                                 uint8_t *vert_edge, uint8_t *horiz_edge, uint8_t *diag_edge); \
+void ff_hevc_sao_edge_filter_1_ ## bitd ## _avx2(uint8_t *_dst, uint8_t *_src, ptrdiff_t _stride_dst, ptrdiff_t _stride_src, \
+                                                 struct SAOParams *sao, int *borders, int _width, int _height, int c_idx, \
+                                                 uint8_t *vert_edge, uint8_t *horiz_edge, uint8_t *diag_edge)
+
+SAO_AVX2_PROTOTYPES(8);
+SAO_AVX2_PROTOTYPES(10);
+SAO_AVX2_PROTOTYPES(12);
+
 //#ifdef SVC_EXTENSION
 
     void ff_upsample_filter_block_luma_h_all_sse(int16_t *dst, ptrdiff_t dststride, uint8_t *_src, ptrdiff_t _srcstride,
@@ -309,6 +372,25 @@ void ff_hevc_sao_band_filter_0_12_sse(uint8_t *_dst, uint8_t *_src, ptrdiff_t _s
    void ff_upsample_filter_block_cr_v_8_8_sse(uint8_t *dst, ptrdiff_t dststride, int16_t *_src, ptrdiff_t _srcstride,
            int y_BL, int x_EL, int y_EL, int block_w, int block_h, int widthEL, int heightEL,
            const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info);
+
+#define UPSAMPLE_HV_PROTOTYPE(comp, name, bitd) \
+void ff_upsample_filter_block_ ## comp ## _hv_ ## name ## _ ## bitd ## _avx2(uint8_t *dst, ptrdiff_t dststride, \
+        uint8_t *src, ptrdiff_t srcstride, int x_EL, int y_EL, int x_BL, int y_BL, \
+        int block_w, int block_h, int bl_height, int widthEL, int heightEL, \
+        const struct HEVCWindow *Enhscal, struct UpsamplInf *up_info)
+#define UPSAMPLE_AVX2_PROTOTYPES(bitd) \
+    UPSAMPLE_HV_PROTOTYPE(luma, all,  bitd); \
+    UPSAMPLE_HV_PROTOTYPE(luma, x2,   bitd); \
+    UPSAMPLE_HV_PROTOTYPE(luma, x1_5, bitd); \
+    UPSAMPLE_HV_PROTOTYPE(cr,   all,  bitd); \
+    UPSAMPLE_HV_PROTOTYPE(cr,   x2,   bitd); \
+    UPSAMPLE_HV_PROTOTYPE(cr,   x1_5, bitd)
+
+UPSAMPLE_AVX2_PROTOTYPES(8);
+UPSAMPLE_AVX2_PROTOTYPES(10);
 //#endif
 
+int ff_hevc_find_nal_marker_sse2(const uint8_t *buf, int size);
+int ff_hevc_find_nal_marker_avx2(const uint8_t *buf, int size);
+
 #endif // AVCODEC_X86_HEVCDSP_H
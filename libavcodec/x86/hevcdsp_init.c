@@ -420,6 +420,63 @@ mc_bi_w_funcs(qpel_hv, 10, sse4);
         PEL_LINK(pointer, 8, my , mx , fname##48,  bitd, opt ); \
         PEL_LINK(pointer, 9, my , mx , fname##64,  bitd, opt )
 
+#if HAVE_AVX2_MC
+/* built with their own flags, see USE_AVX2_MC */
+#define MC_AVX2_LINKS(pointer, my, mx, fname, bitd)               \
+        PEL_LINK2(pointer, 5, my , mx , fname##16,  bitd, avx2); \
+        PEL_LINK2(pointer, 6, my , mx , fname##24,  bitd, avx2); \
+        PEL_LINK2(pointer, 7, my , mx , fname##32,  bitd, avx2); \
+        PEL_LINK2(pointer, 8, my , mx , fname##48,  bitd, avx2); \
+        PEL_LINK2(pointer, 9, my , mx , fname##64,  bitd, avx2)
+#define MC_AVX2_ALL_LINKS(c, bitd)                                      \
+        MC_AVX2_LINKS(c->put_hevc_epel, 0, 0, pel_pixels, bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_epel, 0, 1, epel_h,     bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_epel, 1, 0, epel_v,     bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_epel, 1, 1, epel_hv,    bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_qpel, 0, 0, pel_pixels, bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_qpel, 0, 1, qpel_h,     bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_qpel, 1, 0, qpel_v,     bitd);        \
+        MC_AVX2_LINKS(c->put_hevc_qpel, 1, 1, qpel_hv,    bitd)
+#endif
+
+#if HAVE_AVX2
+#define AVX2_LINKS(c, bitd)                                       \
+        c->sao_band_filter    = ff_hevc_sao_band_filter_0_ ## bitd ## _avx2; \
+        c->sao_edge_filter[0] = ff_hevc_sao_edge_filter_0_ ## bitd ## _avx2; \
+        c->sao_edge_filter[1] = ff_hevc_sao_edge_filter_1_ ## bitd ## _avx2
+#ifdef SVC_EXTENSION
+#define UPSAMPLE_AVX2_LINKS(c, bitd)                                                    \
+        c->upsample_filter_block_luma_hv[DEFAULT] = ff_upsample_filter_block_luma_hv_all_  ## bitd ## _avx2; \
+        c->upsample_filter_block_luma_hv[X2]      = ff_upsample_filter_block_luma_hv_x2_   ## bitd ## _avx2; \
+        c->upsample_filter_block_luma_hv[X1_5]    = ff_upsample_filter_block_luma_hv_x1_5_ ## bitd ## _avx2; \
+        c->upsample_filter_block_cr_hv[DEFAULT]   = ff_upsample_filter_block_cr_hv_all_    ## bitd ## _avx2; \
+        c->upsample_filter_block_cr_hv[X2]        = ff_upsample_filter_block_cr_hv_x2_     ## bitd ## _avx2; \
+        c->upsample_filter_block_cr_hv[X1_5]      = ff_upsample_filter_block_cr_hv_x1_5_   ## bitd ## _avx2
+#else
+#define UPSAMPLE_AVX2_LINKS(c, bitd)
+#endif
+#endif
+#if HAVE_AVX512
+#define MC_AVX512_LINKS(pointer, my, mx, fname, bitd)                                  \
+        pointer[7][my][mx]    = ff_hevc_put_hevc_ ## fname ## 32_ ## bitd ## _avx512;    \
+        pointer[9][my][mx]    = ff_hevc_put_hevc_ ## fname ## 64_ ## bitd ## _avx512;    \
+        pointer ## _bi[7][my][mx] = ff_hevc_put_hevc_bi_ ## fname ## 32_ ## bitd ## _avx512; \
+        pointer ## _bi[9][my][mx] = ff_hevc_put_hevc_bi_ ## fname ## 64_ ## bitd ## _avx512
+#define AVX512_LINKS(c, bitd)                                                \
+        MC_AVX512_LINKS(c->put_hevc_epel, 0, 0, pel_pixels, bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_epel, 0, 1, epel_h,     bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_epel, 1, 0, epel_v,     bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_epel, 1, 1, epel_hv,    bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_qpel, 0, 0, pel_pixels, bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_qpel, 0, 1, qpel_h,     bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_qpel, 1, 0, qpel_v,     bitd);          \
+        MC_AVX512_LINKS(c->put_hevc_qpel, 1, 1, qpel_hv,    bitd);          \
+        c->idct[3]                 = ff_hevc_transform_32x32_ ## bitd ## _avx512;     \
+        c->transform_add[3]        = ff_hevc_transform_32x32_add_ ## bitd ## _avx512; \
+        c->hevc_h_loop_filter_luma = ff_hevc_h_loop_filter_luma_ ## bitd ## _avx512;  \
+        c->hevc_v_loop_filter_luma = ff_hevc_v_loop_filter_luma_ ## bitd ## _avx512
+#endif
+
 
 void ff_hevcdsp_init_x86(HEVCDSPContext *c, const int bit_depth)
 {
@@ -517,7 +574,21 @@ void ff_hevcdsp_init_x86(HEVCDSPContext *c, const int bit_depth)
                 }
                 if (EXTERNAL_AVX2(mm_flags)) {
                     //                    c->transform_dc_add[3]    =  ff_hevc_idct32_dc_add_8_avx2;
+#if HAVE_AVX2
+                    AVX2_LINKS(c, 8);
+                    UPSAMPLE_AVX2_LINKS(c, 8);
+#endif
+                }
+#if HAVE_AVX2_MC
+                if (mm_flags & AV_CPU_FLAG_AVX2) {
+                    MC_AVX2_ALL_LINKS(c, 8);
+                }
+#endif
+#if HAVE_AVX512
+                if (EXTERNAL_AVX512(mm_flags)) {
+                    AVX512_LINKS(c, 8);
                 }
+#endif
             }
         }
     } else if (bit_depth == 10) {
@@ -593,6 +664,20 @@ void ff_hevcdsp_init_x86(HEVCDSPContext *c, const int bit_depth)
                     c->transform_dc_add[2]    =  ff_hevc_idct16_dc_add_10_avx2;
                     c->transform_dc_add[3]    =  ff_hevc_idct32_dc_add_10_avx2;
 #endif
+#if HAVE_AVX2
+                    AVX2_LINKS(c, 10);
+                    UPSAMPLE_AVX2_LINKS(c, 10);
+#endif
+                }
+#endif
+#if HAVE_AVX2_MC
+                if (mm_flags & AV_CPU_FLAG_AVX2) {
+                    MC_AVX2_ALL_LINKS(c, 10);
+                }
+#endif
+#if HAVE_AVX512
+                if (EXTERNAL_AVX512(mm_flags)) {
+                    AVX512_LINKS(c, 10);
                 }
 #endif
             }
@@ -670,6 +755,19 @@ void ff_hevcdsp_init_x86(HEVCDSPContext *c, const int bit_depth)
                     //            c->transform_dc_add[2]    =  ff_hevc_idct16_dc_add_10_avx2;
                     //            c->transform_dc_add[3]    =  ff_hevc_idct32_dc_add_10_avx2;
 #endif
+#if HAVE_AVX2
+                    AVX2_LINKS(c, 12);
+#endif
+                }
+#endif
+#if HAVE_AVX2_MC
+                if (mm_flags & AV_CPU_FLAG_AVX2) {
+                    MC_AVX2_ALL_LINKS(c, 12);
+                }
+#endif
+#if HAVE_AVX512
+                if (EXTERNAL_AVX512(mm_flags)) {
+                    AVX512_LINKS(c, 12);
                 }
 #endif
             }
@@ -31,4 +31,8 @@ void pred_angular_1_12_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_l
 void pred_angular_2_12_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left, ptrdiff_t stride, int c_idx, int mode);
 void pred_angular_3_12_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left, ptrdiff_t stride, int c_idx, int mode);
 
+void pred_dc_8_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left, ptrdiff_t stride, int log2_size, int c_idx);
+void pred_dc_10_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left, ptrdiff_t stride, int log2_size, int c_idx);
+void pred_dc_12_sse(uint8_t *_src, const uint8_t *_top, const uint8_t *_left, ptrdiff_t stride, int log2_size, int c_idx);
+
 #endif // AVCODEC_X86_HEVCPRED_H
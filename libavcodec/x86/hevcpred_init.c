@@ -39,6 +39,8 @@ void ff_hevcpred_init_x86(HEVCPredContext *c, const int bit_depth)
                      c->pred_angular[1]= pred_angular_1_8_sse;
                      c->pred_angular[2]= pred_angular_2_8_sse;
                      c->pred_angular[3]= pred_angular_3_8_sse;
+
+                     c->pred_dc        = pred_dc_8_sse;
                 }
 #endif // HAVE_SSE42
                 if (EXTERNAL_AVX(mm_flags)) {
@@ -66,11 +68,33 @@ void ff_hevcpred_init_x86(HEVCPredContext *c, const int bit_depth)
                     c->pred_angular[1]= pred_angular_1_10_sse;
                     c->pred_angular[2]= pred_angular_2_10_sse;
                     c->pred_angular[3]= pred_angular_3_10_sse;
+
+                    c->pred_dc        = pred_dc_10_sse;
                 }
 #endif // HAVE_SSE42
                 if (EXTERNAL_AVX(mm_flags)) {
                 }
             }
         }
+    } else if (bit_depth == 12) {
+        if (EXTERNAL_MMX(mm_flags)) {
+            if (EXTERNAL_MMXEXT(mm_flags)) {
+#if HAVE_SSE42
+                if (EXTERNAL_SSE4(mm_flags)) {
+                    c->pred_planar[0]= pred_planar_0_12_sse;
+                    c->pred_planar[1]= pred_planar_1_12_sse;
+                    c->pred_planar[2]= pred_planar_2_12_sse;
+                    c->pred_planar[3]= pred_planar_3_12_sse;
+
+                    c->pred_angular[0]= pred_angular_0_12_sse;
+                    c->pred_angular[1]= pred_angular_1_12_sse;
+                    c->pred_angular[2]= pred_angular_2_12_sse;
+                    c->pred_angular[3]= pred_angular_3_12_sse;
+
+                    c->pred_dc        = pred_dc_12_sse;
+                }
+#endif // HAVE_SSE42
+            }
+        }
     }
 }
@@ -54,6 +54,7 @@
 #define AV_CPU_FLAG_FMA3        0x10000 ///< Haswell FMA3 functions
 #define AV_CPU_FLAG_BMI1        0x20000 ///< Bit Manipulation Instruction Set 1
 #define AV_CPU_FLAG_BMI2        0x40000 ///< Bit Manipulation Instruction Set 2
+#define AV_CPU_FLAG_AVX512     0x100000 ///< AVX-512 F, CD, BW, DQ and VL: requires OS support for the zmm and opmask state
 
 #define AV_CPU_FLAG_ALTIVEC      0x0001 ///< standard
 
@@ -95,6 +95,7 @@ int ff_get_cpu_flags_x86(void)
 
     int eax, ebx, ecx, edx;
     int max_std_level, max_ext_level, std_caps = 0, ext_caps = 0;
+    int osxsave = 0, avx = 0;
     int family = 0, model = 0;
     union { int i[3]; char c[12]; } vendor;
 
@@ -107,6 +108,8 @@ int ff_get_cpu_flags_x86(void)
         cpuid(1, eax, ebx, ecx, std_caps);
         family = ((eax >> 8) & 0xf) + ((eax >> 20) & 0xff);
         model  = ((eax >> 4) & 0xf) + ((eax >> 12) & 0xf0);
+        osxsave = !!(ecx & 0x08000000);
+        avx     = (ecx & 0x18000000) == 0x18000000;
         if (std_caps & (1 << 15))
             rval |= AV_CPU_FLAG_CMOV;
         if (std_caps & (1 << 23))
@@ -142,10 +145,28 @@ int ff_get_cpu_flags_x86(void)
     }
     if (max_std_level >= 7) {
         cpuid(7, eax, ebx, ecx, edx);
-#if HAVE_AVX2
-        if ((rval & AV_CPU_FLAG_AVX) && (ebx & 0x00000020))
-            rval |= AV_CPU_FLAG_AVX2;
-#endif /* HAVE_AVX2 */
+#if HAVE_AVX2 || HAVE_AVX2_MC
+        /* AVX with the ymm state enabled by the OS, checked apart from
+         * HAVE_AVX for the AVX2 motion compensation, which has its own
+         * flags */
+        if (avx && (ebx & 0x00000020)) {
+            int xcr0_lo, xcr0_hi;
+            xgetbv(0, xcr0_lo, xcr0_hi);
+            if ((xcr0_lo & 0x6) == 0x6)
+                rval |= AV_CPU_FLAG_AVX2;
+        }
+#endif /* HAVE_AVX2 || HAVE_AVX2_MC */
+#if HAVE_AVX512
+        /* F, DQ, CD, BW and VL, with the opmask and full zmm state enabled
+         * by the OS. Checked on its own since the AVX-512 kernels are built
+         * with their own flags whatever HAVE_AVX says. */
+        if (osxsave && (ebx & 0xd0030000) == 0xd0030000) {
+            int xcr0_lo, xcr0_hi;
+            xgetbv(0, xcr0_lo, xcr0_hi);
+            if ((xcr0_lo & 0xe6) == 0xe6)
+                rval |= AV_CPU_FLAG_AVX512;
+        }
+#endif /* HAVE_AVX512 */
         /* BMI1/2 don't need OS support */
         if (ebx & 0x00000008) {
             rval |= AV_CPU_FLAG_BMI1;
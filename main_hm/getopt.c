@@ -50,7 +50,10 @@ static char *program;
 void print_usage() {
     printf(usage, program);
     printf("     -a : disable AU\n");
+    printf("     -b : print per-thread idle time when closing\n");
     printf("     -c : no check md5\n");
+    printf("     -C <cpu flags> e.g. -avx512 to disable the AVX-512 kernels\n");
+    printf("     -H <mode> 2MB pages for the pictures (1: transparent, 2: hugetlbfs)\n");
     printf("     -f <thread type> (1: frame, 2: slice, 4: frameslice)\n");
     printf("     -i <input file>\n");
     printf("     -n : no display\n");
@@ -132,7 +135,7 @@ int getopt(int nargc, char * const *nargv, const char *ostr) {
 void init_main(int argc, char *argv[]) {
     // every command line option must be followed by ':' if it takes an
     // argument, and '::' if this argument is optional
-    const char *ostr = "achi:no:p:f:s:t:wl:r:";
+    const char *ostr = "abcC:hH:i:no:p:f:s:t:wl:r:";
 
     int c;
     check_md5_flags   = ENABLE;
@@ -146,6 +149,9 @@ void init_main(int argc, char *argv[]) {
     quality_layer_id  = 0; // Base layer
     num_frames        = 0;
     frame_rate        = 0;
+    thread_stats      = DISABLE;
+    cpu_flags         = NULL;
+    huge_pages        = 0;
 
     program           = argv[0];
     
@@ -153,9 +159,18 @@ void init_main(int argc, char *argv[]) {
     
     while (c != -1) {
         switch (c) {
+        case 'b':
+            thread_stats = ENABLE;
+            break;
         case 'c':
             check_md5_flags = DISABLE;
             break;
+        case 'C':
+            cpu_flags = strdup(optarg);
+            break;
+        case 'H':
+            huge_pages = atoi(optarg);
+            break;
         case 'f':
             thread_type = atoi(optarg);
             if (thread_type!=1 && thread_type!=2 && thread_type!=4) {
@@ -53,6 +53,9 @@ int quality_layer_id;
 int no_cropping;
 int num_frames;
 int frame_rate;
+int thread_stats;
+char *cpu_flags;
+int huge_pages;
 
 // initialize APR and parse command-line options
 void init_main(int argc, char *argv[]);
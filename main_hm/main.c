@@ -69,40 +69,56 @@ typedef struct OpenHevcWrapperContext {
     AVCodecParserContext *parser;
 } OpenHevcWrapperContext;
 
-int find_start_code (unsigned char *Buf, int zeros_in_startcode)
-{
-    int i;
-    for (i = 0; i < zeros_in_startcode; i++)
-        if(Buf[i] != 0)
-            return 0;
-    return Buf[i];
-}
+#define NAL_CHUNK 4096
 
+/* Reads the NAL unit after the current start code into Buf, and leaves the
+ * file at the next start code. */
 int get_next_nal(FILE* inpf, unsigned char* Buf)
 {
-    int pos = 0;
-    int StartCodeFound = 0;
-    int info2 = 0;
-    int info3 = 0;
-    while(!feof(inpf)&&(/*Buf[pos++]=*/fgetc(inpf))==0);
+    int pos = 0, scan = 0;
 
-    while (pos < 3) Buf[pos++] = fgetc (inpf);
-    while (!StartCodeFound)
-    {
-        if (feof (inpf))
-        {
-            //            return -1;
-            return pos-1;
+    while (!feof(inpf) && fgetc(inpf) == 0)
+        ;
+    for (;;) {
+        int len = fread(Buf + pos, 1, NAL_CHUNK, inpf);
+        int end = pos + len;
+
+        while (scan < end) {
+            scan += av_hevc_find_nal_marker(Buf + scan, end - scan);
+            if (scan + 2 < end && Buf[scan + 2] == 1) {
+                int nal_end = scan > 0 && !Buf[scan - 1] ? scan - 1 : scan;
+                fseek(inpf, nal_end - end, SEEK_CUR);
+                return nal_end;
+            }
+            scan++;
         }
-        Buf[pos++] = fgetc (inpf);
-        info3 = find_start_code(&Buf[pos-4], 3);
-        if(info3 != 1)
-            info2 = find_start_code(&Buf[pos-3], 2);
-        StartCodeFound = (info2 == 1 || info3 == 1);
+        if (!len)
+            return end;
+        /* the last two bytes can begin a start code */
+        scan = FFMAX(end - 2, 0);
+        pos  = end;
     }
-    fseek (inpf, - 4 + info2, SEEK_CUR);
-    return pos - 4 + info2;
 }
+/* writes the displayed area of one plane, straight from the decoder buffer */
+static void write_plane(FILE *fout, const uint8_t *src, int pitch, int width, int height)
+{
+    int y;
+    for (y = 0; y < height; y++)
+        fwrite(src + y * pitch, sizeof(uint8_t), width, fout);
+}
+
+static void write_frame(FILE *fout, const OpenHevc_FrameRef *frame)
+{
+    const OpenHevc_FrameInfo *info = &frame->frameInfo;
+    int pel     = info->nBitDepth > 8;
+    int hshift  = info->chromat_format != YUV444;
+    int vshift  = info->chromat_format == YUV420;
+
+    write_plane(fout, frame->pvY, info->nYPitch, info->nWidth << pel, info->nHeight);
+    write_plane(fout, frame->pvU, info->nUPitch, (info->nWidth >> hshift) << pel, info->nHeight >> vshift);
+    write_plane(fout, frame->pvV, info->nVPitch, (info->nWidth >> hshift) << pel, info->nHeight >> vshift);
+}
+
 typedef struct Info {
     int NbFrame;
     int Poc;
@@ -138,7 +154,7 @@ static void video_decode_example(const char *filename)
     char output_file2[256];
 
     OpenHevc_Frame     openHevcFrame;
-    OpenHevc_Frame_cpy openHevcFrameCpy;
+    OpenHevc_FrameRef  openHevcFrameRef;
     OpenHevc_Handle    openHevcHandle;
 
     if (filename == NULL) {
@@ -147,12 +163,23 @@ static void video_decode_example(const char *filename)
     }
 
     openHevcHandle = libOpenHevcInit(nb_pthreads, thread_type/*, pFormatCtx*/);
-    libOpenHevcSetCheckMD5(openHevcHandle, check_md5_flags);
-
     if (!openHevcHandle) {
         fprintf(stderr, "could not open OpenHevc\n");
         exit(1);
     }
+    libOpenHevcSetCheckMD5(openHevcHandle, check_md5_flags);
+    libOpenHevcSetThreadStats(openHevcHandle, thread_stats);
+    if (cpu_flags && libOpenHevcSetCpuFlags(openHevcHandle, cpu_flags) < 0) {
+        fprintf(stderr, "invalid cpu flags \"%s\"\n", cpu_flags);
+        exit(1);
+    }
+    free(cpu_flags);
+    cpu_flags = NULL;
+    if (libOpenHevcSetHugePages(openHevcHandle, huge_pages) < 0) {
+        fprintf(stderr, "huge pages mode %d not supported\n", huge_pages);
+        exit(1);
+    }
+
     av_register_all();
     pFormatCtx = avformat_alloc_context();
 
@@ -176,9 +203,6 @@ static void video_decode_example(const char *filename)
 
     libOpenHevcSetDebugMode(openHevcHandle, 0);
     libOpenHevcStartDecoder(openHevcHandle);
-    openHevcFrameCpy.pvY = NULL;
-    openHevcFrameCpy.pvU = NULL;
-    openHevcFrameCpy.pvV = NULL;
 #if USE_SDL
     Init_Time();
     if (frame_rate > 0) {
@@ -241,18 +265,6 @@ static void video_decode_example(const char *filename)
                         Init_SDL((openHevcFrame.frameInfo.nYPitch - openHevcFrame.frameInfo.nWidth)/2, openHevcFrame.frameInfo.nWidth, openHevcFrame.frameInfo.nHeight);
                     }
 #endif
-                    if (fout) {
-                        int format = openHevcFrameCpy.frameInfo.chromat_format == YUV420 ? 1 : 0;
-                        libOpenHevcGetPictureInfo(openHevcHandle, &openHevcFrameCpy.frameInfo);
-                        if(openHevcFrameCpy.pvY) {
-                            free(openHevcFrameCpy.pvY);
-                            free(openHevcFrameCpy.pvU);
-                            free(openHevcFrameCpy.pvV);
-                        }
-                        openHevcFrameCpy.pvY = calloc (openHevcFrameCpy.frameInfo.nYPitch * openHevcFrameCpy.frameInfo.nHeight, sizeof(unsigned char));
-                        openHevcFrameCpy.pvU = calloc (openHevcFrameCpy.frameInfo.nUPitch * openHevcFrameCpy.frameInfo.nHeight >> format, sizeof(unsigned char));
-                        openHevcFrameCpy.pvV = calloc (openHevcFrameCpy.frameInfo.nVPitch * openHevcFrameCpy.frameInfo.nHeight >> format, sizeof(unsigned char));
-                    }
                 }
 #if USE_SDL
                 if (frame_rate > 0) {
@@ -265,12 +277,9 @@ static void video_decode_example(const char *filename)
                             openHevcFrame.pvY, openHevcFrame.pvU, openHevcFrame.pvV);
                 }
 #endif
-                if (fout) {
-                    int format = openHevcFrameCpy.frameInfo.chromat_format == YUV420 ? 1 : 0;
-                    libOpenHevcGetOutputCpy(openHevcHandle, 1, &openHevcFrameCpy);
-                    fwrite( openHevcFrameCpy.pvY , sizeof(uint8_t) , openHevcFrameCpy.frameInfo.nYPitch * openHevcFrameCpy.frameInfo.nHeight, fout);
-                    fwrite( openHevcFrameCpy.pvU , sizeof(uint8_t) , openHevcFrameCpy.frameInfo.nUPitch * openHevcFrameCpy.frameInfo.nHeight >> format, fout);
-                    fwrite( openHevcFrameCpy.pvV , sizeof(uint8_t) , openHevcFrameCpy.frameInfo.nVPitch * openHevcFrameCpy.frameInfo.nHeight >> format, fout);
+                if (fout && libOpenHevcGetOutputRef(openHevcHandle, 1, &openHevcFrameRef) > 0) {
+                    write_frame(fout, &openHevcFrameRef);
+                    libOpenHevcReleaseFrame(&openHevcFrameRef);
                 }
                 nbFrame++;
                 if (nbFrame == num_frames)
@@ -289,14 +298,8 @@ static void video_decode_example(const char *filename)
 #endif
     CloseSDLDisplay();
 #endif
-    if (fout) {
+    if (fout)
         fclose(fout);
-        if(openHevcFrameCpy.pvY) {
-            free(openHevcFrameCpy.pvY);
-            free(openHevcFrameCpy.pvU);
-            free(openHevcFrameCpy.pvV);
-        }
-    }
     avformat_close_input(&pFormatCtx);
     libOpenHevcClose(openHevcHandle);
 #if USE_SDL
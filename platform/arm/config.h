@@ -45,6 +45,8 @@
 #define HAVE_AMD3DNOWEXT 0
 #define HAVE_AVX 0
 #define HAVE_AVX2 0
+#define HAVE_AVX512 0
+#define HAVE_AVX2_MC 0
 #define HAVE_FMA4 0
 #define HAVE_I686 1
 #define HAVE_MMX 0
@@ -72,6 +74,7 @@
 #define HAVE_AMD3DNOWEXT_EXTERNAL 0
 #define HAVE_AVX_EXTERNAL 0
 #define HAVE_AVX2_EXTERNAL 0
+#define HAVE_AVX512_EXTERNAL 0
 #define HAVE_FMA4_EXTERNAL 0
 #define HAVE_I686_EXTERNAL 0
 #define HAVE_MMX_EXTERNAL 0
@@ -99,6 +102,7 @@
 #define HAVE_AMD3DNOWEXT_INLINE 0
 #define HAVE_AVX_INLINE 0
 #define HAVE_AVX2_INLINE 0
+#define HAVE_AVX512_INLINE 0
 #define HAVE_FMA4_INLINE 0
 #define HAVE_I686_INLINE 0
 #define HAVE_MMX_INLINE 0
@@ -0,0 +1,263 @@
+/*
+ * Bit exactness tests and benchmarks of the SIMD functions
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * After the style of FFmpeg's checkasm: every test initializes its DSP
+ * context once per cpu level, from C up to the widest instruction set of
+ * the host, skipping the levels the host lacks (a build for an older
+ * architecture does not detect AVX, but its AVX2 and AVX-512 kernels are
+ * still picked at run time), and each function pointer that changed since
+ * the lower levels
+ * is called on random input next to the C version. Any difference in the
+ * output fails the run. With --bench the functions are timed as well, the
+ * C ones at the C level, in cycles per call. Functions left NULL, such as
+ * the assembly ones of a build without yasm, are skipped.
+ *
+ * checkasm [--bench[=runs]] [--test=name] [seed]
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavutil/cpu.h"
+#include "libavutil/random_seed.h"
+
+static const struct {
+    const char *name;
+    void (*func)(void);
+} tests[] = {
+    { "hevc_deblock", checkasm_check_hevc_deblock },
+    { "hevc_idct", checkasm_check_hevc_idct },
+    { "hevc_mc",   checkasm_check_hevc_mc },
+    { "hevc_pred", checkasm_check_hevc_pred },
+    { "hevc_sao",  checkasm_check_hevc_sao },
+    { "hevc_startcode", checkasm_check_hevc_startcode },
+};
+
+/* each level includes the flags of the levels above it */
+static const struct {
+    const char *name;
+    const char *suffix;
+    int flags;
+} cpus[] = {
+    { "C",      "c",      0 },
+#if ARCH_X86
+    { "SSE2",   "sse2",   AV_CPU_FLAG_MMX | AV_CPU_FLAG_MMXEXT | AV_CPU_FLAG_SSE | AV_CPU_FLAG_SSE2 },
+    { "SSSE3",  "ssse3",  AV_CPU_FLAG_SSE3 | AV_CPU_FLAG_SSSE3 },
+    { "SSE4",   "sse4",   AV_CPU_FLAG_SSE4 | AV_CPU_FLAG_SSE42 },
+    { "AVX",    "avx",    AV_CPU_FLAG_AVX },
+    { "AVX2",   "avx2",   AV_CPU_FLAG_AVX2 },
+    { "AVX512", "avx512", AV_CPU_FLAG_AVX512 },
+#endif
+};
+
+#define MAX_LEVELS (sizeof(cpus) / sizeof(cpus[0]))
+#define HASH_SIZE  4096
+
+typedef struct CheckasmFunc {
+    struct CheckasmFunc *next;
+    void *versions[MAX_LEVELS];     ///< the C version first
+    int nb_versions;
+    char name[1];
+} CheckasmFunc;
+
+AVLFG checkasm_lfg;
+
+static struct {
+    CheckasmFunc *funcs[HASH_SIZE];
+    CheckasmFunc *current;
+    int level;
+    int bench_runs;
+    uint64_t bench_best;        ///< fastest batch of the current function
+    int bench_best_runs;
+    int nb_checked;             ///< since the last report
+    int nb_failed;
+    int nb_failed_total;
+    int nb_checked_total;
+} state;
+
+static unsigned hash_name(const char *name)
+{
+    unsigned h = 5381;
+
+    while (*name)
+        h = h * 33 ^ (uint8_t) *name++;
+    return h % HASH_SIZE;
+}
+
+static CheckasmFunc *get_func(const char *name)
+{
+    unsigned h = hash_name(name);
+    CheckasmFunc *f;
+
+    for (f = state.funcs[h]; f; f = f->next)
+        if (!strcmp(f->name, name))
+            return f;
+    f = calloc(1, sizeof(*f) + strlen(name));
+    if (!f) {
+        fprintf(stderr, "checkasm: out of memory\n");
+        exit(1);
+    }
+    strcpy(f->name, name);
+    f->next = state.funcs[h];
+    state.funcs[h] = f;
+    return f;
+}
+
+/* print the timing of the function that was checked last */
+static void end_func(void)
+{
+    if (state.current && state.bench_best_runs)
+        printf("%s_%s: %.1f\n", state.current->name, cpus[state.level].suffix,
+               (double) state.bench_best / state.bench_best_runs);
+    state.current         = NULL;
+    state.bench_best_runs = 0;
+}
+
+void *checkasm_check_func(void *func, const char *name, ...)
+{
+    char buf[256];
+    CheckasmFunc *f;
+    va_list ap;
+    int i;
+
+    end_func();
+    if (!func)
+        return NULL;
+
+    va_start(ap, name);
+    vsnprintf(buf, sizeof(buf), name, ap);
+    va_end(ap);
+    f = get_func(buf);
+
+    /* a function the lower levels kept, or one that was never set in C */
+    for (i = 0; i < f->nb_versions; i++)
+        if (f->versions[i] == func)
+            return NULL;
+    if (!f->nb_versions && state.level)
+        return NULL;
+    f->versions[f->nb_versions++] = func;
+
+    /* C against itself is only worth running for its timing */
+    if (!state.level && !state.bench_runs)
+        return NULL;
+    state.current = f;
+    if (state.level) {
+        state.nb_checked++;
+        state.nb_checked_total++;
+    }
+    return f->versions[0];
+}
+
+int checkasm_fail_func(const char *msg, ...)
+{
+    va_list ap;
+
+    if (!state.current)
+        return 0;
+    fprintf(stderr, "   %s_%s (", state.current->name, cpus[state.level].suffix);
+    va_start(ap, msg);
+    vfprintf(stderr, msg, ap);
+    va_end(ap);
+    fprintf(stderr, ")\n");
+    state.nb_failed++;
+    state.nb_failed_total++;
+    /* report a function once, at its first difference */
+    state.current = NULL;
+    return 1;
+}
+
+void checkasm_report(const char *name, ...)
+{
+    char buf[256];
+    va_list ap;
+
+    end_func();
+    if (!state.nb_checked)
+        return;
+    va_start(ap, name);
+    vsnprintf(buf, sizeof(buf), name, ap);
+    va_end(ap);
+    fprintf(stderr, " %-6s %-32s %4d %s\n", cpus[state.level].name, buf,
+            state.nb_checked, state.nb_failed ? "FAILED" : "OK");
+    state.nb_checked = 0;
+    state.nb_failed  = 0;
+}
+
+int checkasm_bench_runs(void)
+{
+    return state.current ? state.bench_runs : 0;
+}
+
+void checkasm_bench_result(uint64_t cycles, int runs)
+{
+    if (!state.bench_best_runs || cycles * state.bench_best_runs < state.bench_best * runs) {
+        state.bench_best      = cycles;
+        state.bench_best_runs = runs;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *test = NULL;
+    unsigned seed = av_get_random_seed();
+    int host_flags = av_get_cpu_flags();
+    int flags = 0, i, j;
+
+    for (i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "--bench", 7)) {
+            state.bench_runs = argv[i][7] == '=' ? atoi(argv[i] + 8) : 64;
+        } else if (!strncmp(argv[i], "--test=", 7)) {
+            test = argv[i] + 7;
+        } else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+            seed = strtoul(argv[i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--bench[=runs]] [--test=name] [seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    fprintf(stderr, "checkasm: seed %u\n", seed);
+    for (state.level = 0; state.level < MAX_LEVELS; state.level++) {
+        if ((host_flags & cpus[state.level].flags) != cpus[state.level].flags)
+            continue;
+        flags |= cpus[state.level].flags;
+        av_force_cpu_flags(flags);
+        for (j = 0; j < sizeof(tests) / sizeof(tests[0]); j++) {
+            if (test && strcmp(test, tests[j].name))
+                continue;
+            /* the same input at every level */
+            av_lfg_init(&checkasm_lfg, seed);
+            tests[j].func();
+        }
+    }
+    end_func();
+
+    if (state.nb_failed_total) {
+        fprintf(stderr, "checkasm: %d of %d functions FAILED\n",
+                state.nb_failed_total, state.nb_checked_total);
+        return 1;
+    }
+    fprintf(stderr, "checkasm: all %d functions passed\n", state.nb_checked_total);
+    return 0;
+}
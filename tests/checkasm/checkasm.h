@@ -0,0 +1,84 @@
+/*
+ * Bit exactness tests and benchmarks of the SIMD functions
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef TESTS_CHECKASM_CHECKASM_H
+#define TESTS_CHECKASM_CHECKASM_H
+
+#include <stdint.h>
+
+#include "config.h"
+#include "libavutil/lfg.h"
+#include "libavutil/timer.h"
+
+/* one per DSP module, see checkasm.c */
+void checkasm_check_hevc_deblock(void);
+void checkasm_check_hevc_idct(void);
+void checkasm_check_hevc_mc(void);
+void checkasm_check_hevc_pred(void);
+void checkasm_check_hevc_sao(void);
+void checkasm_check_hevc_startcode(void);
+
+extern AVLFG checkasm_lfg;
+#define rnd() av_lfg_get(&checkasm_lfg)
+
+/**
+ * Start testing function func under name, a printf format.
+ * @return the C version of the function if func was not tested yet at a
+ *         lower cpu level, NULL otherwise; the test is then skipped
+ */
+void *checkasm_check_func(void *func, const char *name, ...) av_printf_format(2, 3);
+
+/* mark the current function as failed, returns 0 when it already was */
+int checkasm_fail_func(const char *msg, ...) av_printf_format(1, 2);
+
+/* print the result of the functions checked since the last report */
+void checkasm_report(const char *name, ...) av_printf_format(1, 2);
+
+/* calls per batch in bench_new(), 0 without --bench */
+int checkasm_bench_runs(void);
+void checkasm_bench_result(uint64_t cycles, int runs);
+
+#define check_func(func, ...) (func_ref = checkasm_check_func((func_new = func), __VA_ARGS__))
+#define declare_func(ret, ...) ret (*func_ref)(__VA_ARGS__); ret (*func_new)(__VA_ARGS__)
+#define fail() checkasm_fail_func("%s:%d", __FILE__, __LINE__)
+#define report checkasm_report
+
+#define call_ref(...) func_ref(__VA_ARGS__)
+#define call_new(...) func_new(__VA_ARGS__)
+
+/* time func_new with the given arguments; the fastest of
+ * CHECKASM_BENCH_BATCHES batches gives the cycles per call */
+#define CHECKASM_BENCH_BATCHES 16
+#if defined(AV_READ_TIME)
+#define bench_new(...)                                                  \
+    do {                                                                \
+        int bench_runs = checkasm_bench_runs(), bench_batch, bench_i;  \
+        for (bench_batch = 0; bench_runs && bench_batch < CHECKASM_BENCH_BATCHES; bench_batch++) { \
+            uint64_t bench_t0 = AV_READ_TIME();                         \
+            for (bench_i = 0; bench_i < bench_runs; bench_i++)          \
+                func_new(__VA_ARGS__);                                  \
+            checkasm_bench_result(AV_READ_TIME() - bench_t0, bench_runs); \
+        }                                                               \
+    } while (0)
+#else
+#define bench_new(...) while (0)
+#endif
+
+#endif /* TESTS_CHECKASM_CHECKASM_H */
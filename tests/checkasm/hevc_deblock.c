@@ -0,0 +1,191 @@
+/*
+ * HEVC deblocking filters against the C versions
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/hevcdsp.h"
+#include "libavutil/mem.h"
+
+/* a 16x16 block around the edge, which is at sample 8 of either direction;
+ * a call filters 8 lines, two segments of 4 with their own tc */
+#define BLOCK_SIZE 16
+#define EDGE       8
+#define STRIDE     (BLOCK_SIZE * 2 * 2)
+#define BUF_SIZE   (BLOCK_SIZE * STRIDE)
+
+typedef struct DeblockTest {
+    DECLARE_ALIGNED(32, uint8_t, pix0)[BUF_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, pix1)[BUF_SIZE];
+    int bit_depth;
+    /* parameters of one call */
+    int beta, tc[2];
+    uint8_t no_p[2], no_q[2];
+} DeblockTest;
+
+/*
+ * Each side of each segment gets a level, a slope across the edge and some
+ * noise, so that the decisions of the filters take every branch: flat sides
+ * for the strong luma filter, small steps for the normal one, steps larger
+ * than 10 tc that are left alone.
+ */
+static void randomize(DeblockTest *t, int vertical)
+{
+    int mask = (1 << t->bit_depth) - 1;
+    int scale = t->bit_depth - 8;
+    int level[2][2], slope[2][2], noise[2][2];
+    int i, j, side, seg;
+
+    for (side = 0; side < 2; side++)
+        for (seg = 0; seg < 2; seg++) {
+            static const int noise_shift[4] = { -1, 3, 1, 0 };
+            int shift = noise_shift[rnd() & 3];
+            int range = 16 * (t->tc[seg] + 1);
+            level[side][seg] = (rnd() & mask) / 2 + (side ? (int) (rnd() % (2 * range)) - range : 0);
+            slope[side][seg] = (int) (rnd() % 5 - 2) << scale;
+            noise[side][seg] = shift < 0 ? 0 : (t->beta + 4 * t->tc[seg]) >> shift;
+        }
+
+    /* j across the edge, i along it */
+    for (i = 0; i < BLOCK_SIZE; i++)
+        for (j = 0; j < BLOCK_SIZE; j++) {
+            int v;
+
+            side = j >= EDGE;
+            seg  = i >= EDGE;
+            v    = level[side][seg] + slope[side][seg] * (j - EDGE);
+            if (noise[side][seg])
+                v += (int) (rnd() % (2 * noise[side][seg] + 1)) - noise[side][seg];
+            v = av_clip(v, 0, mask);
+            if (t->bit_depth > 8)
+                ((uint16_t *) (t->pix0 + (vertical ? i : j) * STRIDE))[vertical ? j : i] = v;
+            else
+                t->pix0[(vertical ? i : j) * STRIDE + (vertical ? j : i)] = v;
+        }
+    memcpy(t->pix1, t->pix0, BUF_SIZE);
+}
+
+/* beta and tc as deblocking_filter_CTB() derives them from the tables */
+static void randomize_params(DeblockTest *t, int luma)
+{
+    int scale = t->bit_depth - 8, i;
+
+    t->beta = (rnd() % 65) << scale;
+    for (i = 0; i < 2; i++) {
+        t->tc[i]   = rnd() & 7 ? (rnd() % 25) << scale : 0;
+        t->no_p[i] = !(rnd() & 7);
+        t->no_q[i] = !(rnd() & 7);
+    }
+    if (!luma)
+        t->beta = 0;
+}
+
+static uint8_t *edge(const DeblockTest *t, uint8_t *buf, int vertical)
+{
+    int pel = t->bit_depth > 8;
+
+    return vertical ? buf + (EDGE - 4) * STRIDE + (EDGE << pel)
+                    : buf + EDGE * STRIDE + ((EDGE - 4) << pel);
+}
+
+static int check_buf(DeblockTest *t, const char *name)
+{
+    int pel = t->bit_depth > 8;
+    int x, y;
+
+    for (y = 0; y < BLOCK_SIZE; y++)
+        for (x = 0; x < BLOCK_SIZE; x++) {
+            int a = pel ? ((uint16_t *) (t->pix0 + y * STRIDE))[x] : t->pix0[y * STRIDE + x];
+            int b = pel ? ((uint16_t *) (t->pix1 + y * STRIDE))[x] : t->pix1[y * STRIDE + x];
+            if (a != b)
+                return checkasm_fail_func("%s beta %d tc %d,%d no_p %d%d no_q %d%d: %d instead of %d at %d,%d",
+                                          name, t->beta, t->tc[0], t->tc[1],
+                                          t->no_p[0], t->no_p[1], t->no_q[0], t->no_q[1],
+                                          b, a, x, y);
+        }
+    return 0;
+}
+
+static void check_luma(DeblockTest *t, HEVCDSPContext *h)
+{
+    static const char *const names[2] = { "h_loop_filter_luma", "v_loop_filter_luma" };
+    int vertical, n;
+    declare_func(void, uint8_t *pix, ptrdiff_t stride, int beta, int *tc,
+                 uint8_t *no_p, uint8_t *no_q);
+
+    for (vertical = 0; vertical < 2; vertical++) {
+        void *func = vertical ? h->hevc_v_loop_filter_luma : h->hevc_h_loop_filter_luma;
+
+        if (!check_func(func, "%s_%d", names[vertical], t->bit_depth))
+            continue;
+        for (n = 0; n < 1024; n++) {
+            randomize_params(t, 1);
+            randomize(t, vertical);
+            call_ref(edge(t, t->pix0, vertical), STRIDE, t->beta, t->tc, t->no_p, t->no_q);
+            call_new(edge(t, t->pix1, vertical), STRIDE, t->beta, t->tc, t->no_p, t->no_q);
+            if (check_buf(t, names[vertical]))
+                break;
+        }
+        memset(t->no_p, 0, sizeof(t->no_p));
+        memset(t->no_q, 0, sizeof(t->no_q));
+        bench_new(edge(t, t->pix1, vertical), STRIDE, t->beta, t->tc, t->no_p, t->no_q);
+    }
+    report("loop_filter_luma_%d", t->bit_depth);
+}
+
+static void check_chroma(DeblockTest *t, HEVCDSPContext *h)
+{
+    static const char *const names[2] = { "h_loop_filter_chroma", "v_loop_filter_chroma" };
+    int vertical, n;
+    declare_func(void, uint8_t *pix, ptrdiff_t stride, int *tc,
+                 uint8_t *no_p, uint8_t *no_q);
+
+    for (vertical = 0; vertical < 2; vertical++) {
+        void *func = vertical ? h->hevc_v_loop_filter_chroma : h->hevc_h_loop_filter_chroma;
+
+        if (!check_func(func, "%s_%d", names[vertical], t->bit_depth))
+            continue;
+        for (n = 0; n < 1024; n++) {
+            randomize_params(t, 0);
+            randomize(t, vertical);
+            call_ref(edge(t, t->pix0, vertical), STRIDE, t->tc, t->no_p, t->no_q);
+            call_new(edge(t, t->pix1, vertical), STRIDE, t->tc, t->no_p, t->no_q);
+            if (check_buf(t, names[vertical]))
+                break;
+        }
+        memset(t->no_p, 0, sizeof(t->no_p));
+        memset(t->no_q, 0, sizeof(t->no_q));
+        bench_new(edge(t, t->pix1, vertical), STRIDE, t->tc, t->no_p, t->no_q);
+    }
+    report("loop_filter_chroma_%d", t->bit_depth);
+}
+
+void checkasm_check_hevc_deblock(void)
+{
+    static DeblockTest t;
+    HEVCDSPContext h;
+
+    for (t.bit_depth = 8; t.bit_depth <= 12; t.bit_depth += 2) {
+        ff_hevc_dsp_init(&h, t.bit_depth);
+        check_luma(&t, &h);
+        check_chroma(&t, &h);
+    }
+}
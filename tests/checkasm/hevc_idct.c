@@ -0,0 +1,160 @@
+/*
+ * HEVC inverse transforms and residual add against the C versions
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/hevcdsp.h"
+#include "libavutil/mem.h"
+
+#define COEFFS_SIZE (MAX_TB_SIZE * MAX_TB_SIZE)
+/* a block of each size sits at x = size, like in a picture row */
+#define DST_STRIDE  (4 * MAX_TB_SIZE * 2)
+#define DST_SIZE    (MAX_TB_SIZE * DST_STRIDE)
+
+typedef struct IDCTTest {
+    DECLARE_ALIGNED(32, int16_t, coeffs0)[COEFFS_SIZE];
+    DECLARE_ALIGNED(32, int16_t, coeffs1)[COEFFS_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, dst0)[DST_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, dst1)[DST_SIZE];
+    int bit_depth;
+    int log2_size;
+    int col_limit;
+} IDCTTest;
+
+/*
+ * Coefficients up to a random last position, with col_limit derived from
+ * it as hls_residual_coding() does. Every other block uses the full 16 bit
+ * range of the dequantized coefficients, the others the range of the
+ * residuals of a picture.
+ */
+static void randomize_coeffs(IDCTTest *t, int n)
+{
+    int size   = 1 << t->log2_size;
+    int last_x = rnd() % size;
+    int last_y = rnd() % size;
+    int max_xy = FFMAX(last_x, last_y);
+    int range  = n & 1 ? 0xffff : (1 << (t->bit_depth + 2)) - 1;
+    int x, y;
+
+    memset(t->coeffs0, 0, sizeof(t->coeffs0));
+    for (y = 0; y <= last_y; y++)
+        for (x = 0; x <= last_x; x++)
+            if (rnd() & 1)
+                t->coeffs0[y * size + x] = (int) (rnd() & range) - (range + 1) / 2;
+    memcpy(t->coeffs1, t->coeffs0, sizeof(t->coeffs0));
+
+    t->col_limit = last_x + last_y + 4;
+    if (max_xy < 4)
+        t->col_limit = FFMIN(4, t->col_limit);
+    else if (max_xy < 8)
+        t->col_limit = FFMIN(8, t->col_limit);
+    else if (max_xy < 12)
+        t->col_limit = FFMIN(24, t->col_limit);
+}
+
+/* residuals of one more bit than the samples, to hit both clips */
+static void randomize_residual(IDCTTest *t)
+{
+    int mask = (1 << t->bit_depth) - 1, i;
+
+    for (i = 0; i < COEFFS_SIZE; i++)
+        t->coeffs0[i] = (int) (rnd() & (2 * mask + 1)) - mask;
+    memcpy(t->coeffs1, t->coeffs0, sizeof(t->coeffs0));
+    for (i = 0; i < DST_SIZE >> (t->bit_depth > 8); i++) {
+        if (t->bit_depth > 8)
+            ((uint16_t *) t->dst0)[i] = rnd() & mask;
+        else
+            t->dst0[i] = rnd();
+    }
+    memcpy(t->dst1, t->dst0, DST_SIZE);
+}
+
+static uint8_t *block(const IDCTTest *t, uint8_t *dst)
+{
+    return dst + ((1 << t->log2_size) << (t->bit_depth > 8));
+}
+
+static void check_idct(IDCTTest *t, HEVCDSPContext *h)
+{
+    int n;
+    declare_func(void, int16_t *coeffs, int col_limit);
+
+    for (t->log2_size = 2; t->log2_size <= 5; t->log2_size++) {
+        int size = 1 << t->log2_size;
+
+        if (!check_func(h->idct[t->log2_size - 2], "idct_%dx%d_%d",
+                        size, size, t->bit_depth))
+            continue;
+        for (n = 0; n < 256; n++) {
+            randomize_coeffs(t, n);
+            call_ref(t->coeffs0, t->col_limit);
+            call_new(t->coeffs1, t->col_limit);
+            if (memcmp(t->coeffs0, t->coeffs1, size * size * sizeof(int16_t))) {
+                int i;
+                for (i = 0; t->coeffs0[i] == t->coeffs1[i]; i++)
+                    ;
+                checkasm_fail_func("col_limit %d: %d instead of %d at %d,%d", t->col_limit,
+                                   t->coeffs1[i], t->coeffs0[i], i % size, i / size);
+                break;
+            }
+        }
+        bench_new(t->coeffs1, size);
+    }
+    report("idct_%d", t->bit_depth);
+}
+
+static void check_transform_add(IDCTTest *t, HEVCDSPContext *h)
+{
+    int n;
+    declare_func(void, uint8_t *dst, int16_t *coeffs, ptrdiff_t stride);
+
+    for (t->log2_size = 2; t->log2_size <= 5; t->log2_size++) {
+        int size = 1 << t->log2_size;
+
+        if (!check_func(h->transform_add[t->log2_size - 2], "transform_add_%dx%d_%d",
+                        size, size, t->bit_depth))
+            continue;
+        for (n = 0; n < 16; n++) {
+            randomize_residual(t);
+            call_ref(block(t, t->dst0), t->coeffs0, DST_STRIDE);
+            call_new(block(t, t->dst1), t->coeffs1, DST_STRIDE);
+            if (memcmp(t->dst0, t->dst1, DST_SIZE)) {
+                checkasm_fail_func("%dx%d", size, size);
+                break;
+            }
+        }
+        bench_new(block(t, t->dst1), t->coeffs1, DST_STRIDE);
+    }
+    report("transform_add_%d", t->bit_depth);
+}
+
+void checkasm_check_hevc_idct(void)
+{
+    static IDCTTest t;
+    HEVCDSPContext h;
+
+    for (t.bit_depth = 8; t.bit_depth <= 12; t.bit_depth += 2) {
+        ff_hevc_dsp_init(&h, t.bit_depth);
+        check_idct(&t, &h);
+        check_transform_add(&t, &h);
+    }
+}
@@ -0,0 +1,335 @@
+/*
+ * HEVC motion compensation against the C version
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/hevcdsp.h"
+#include "libavutil/cpu.h"
+#include "libavutil/mem.h"
+
+/* 16-bit samples with room for the filter taps on every side */
+#define SRC_STRIDE ((MAX_PB_SIZE + 16) * 2)
+#define SRC_OFFSET (4 * SRC_STRIDE + 4 * 2)
+#define SRC_SIZE   ((MAX_PB_SIZE + 8) * SRC_STRIDE)
+/* the prediction rows of hevc.c, up to 16-bit samples */
+#define DST_STRIDE (MAX_PB_SIZE * 2)
+#define DST_SIZE   (MAX_PB_SIZE * DST_STRIDE)
+
+static const int widths[10] = { 2, 4, 6, 8, 12, 16, 24, 32, 48, 64 };
+static const char *const filters[2][2][2] = {
+    { { "pel_pixels", "qpel_h" }, { "qpel_v", "qpel_hv" } },
+    { { "pel_pixels", "epel_h" }, { "epel_v", "epel_hv" } },
+};
+static const char *const types[2] = { "qpel", "epel" };
+
+typedef void (*put_func)(int16_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                         int height, intptr_t mx, intptr_t my, int width);
+
+typedef struct MCTest {
+    DECLARE_ALIGNED(16, uint8_t, src)[SRC_SIZE];
+    DECLARE_ALIGNED(16, int16_t, src2)[MAX_PB_SIZE * MAX_PB_SIZE];
+    DECLARE_ALIGNED(16, uint8_t, dst0)[DST_SIZE];
+    DECLARE_ALIGNED(16, uint8_t, dst1)[DST_SIZE];
+    int bit_depth;
+    int epel;
+    /* parameters of one call */
+    int width, height, mx, my;
+} MCTest;
+
+static void randomize_src(MCTest *t)
+{
+    int mask = (1 << t->bit_depth) - 1, i;
+
+    if (t->bit_depth > 8) {
+        uint16_t *src = (uint16_t *) t->src;
+        for (i = 0; i < SRC_SIZE / 2; i++)
+            src[i] = rnd() & mask;
+    } else {
+        for (i = 0; i < SRC_SIZE; i++)
+            t->src[i] = rnd();
+    }
+}
+
+static void randomize_dst(MCTest *t)
+{
+    int i;
+
+    for (i = 0; i < DST_SIZE; i++)
+        t->dst0[i] = rnd();
+    memcpy(t->dst1, t->dst0, DST_SIZE);
+}
+
+/* random block size and fractions for a function of the [my][mx] entry */
+static void randomize_params(MCTest *t, int idx, int my, int mx)
+{
+    int frac_mask = t->epel ? 7 : 3;
+
+    t->width  = widths[idx];
+    t->height = 2 * (1 + rnd() % (MAX_PB_SIZE / 2));
+    t->mx     = mx ? 1 + rnd() % frac_mask : 0;
+    t->my     = my ? 1 + rnd() % frac_mask : 0;
+}
+
+/* src2 of the bi functions is the output of the C put function on other samples */
+static void make_src2(MCTest *t, put_func put)
+{
+    int mask = t->epel ? 7 : 3;
+
+    randomize_src(t);
+    put(t->src2, MAX_PB_SIZE, t->src + SRC_OFFSET, SRC_STRIDE, t->height,
+        rnd() & mask, rnd() & mask, t->width);
+}
+
+/**
+ * Compare the output of both versions, the block for put, where the rest
+ * of the rows is scratch space, and the whole picture area otherwise.
+ * @return 1 after reporting the first difference
+ */
+static int check_dst(MCTest *t, int put)
+{
+    int pel    = put || t->bit_depth > 8;
+    int stride = put ? MAX_PB_SIZE : DST_STRIDE >> pel;
+    int width  = put ? t->width    : stride;
+    int height = put ? t->height   : MAX_PB_SIZE;
+    int x, y;
+
+    for (y = 0; y < height; y++)
+        for (x = 0; x < width; x++) {
+            int i = y * stride + x;
+            int a = pel ? ((int16_t *) t->dst0)[i] : t->dst0[i];
+            int b = pel ? ((int16_t *) t->dst1)[i] : t->dst1[i];
+            if (a != b)
+                return checkasm_fail_func("%dx%d mx %d my %d: %d instead of %d at %d,%d",
+                                          t->width, t->height, t->mx, t->my, b, a, x, y);
+        }
+    return 0;
+}
+
+static void check_put(MCTest *t, put_func tab[10][2][2])
+{
+    int idx, my, mx, n;
+    declare_func(void, int16_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int height, intptr_t mx, intptr_t my, int width);
+
+    for (idx = 0; idx < 10; idx++)
+        for (my = 0; my < 2; my++)
+            for (mx = 0; mx < 2; mx++) {
+                if (!check_func(tab[idx][my][mx], "put_hevc_%s%d_%d", filters[t->epel][my][mx],
+                                widths[idx], t->bit_depth))
+                    continue;
+                for (n = 0; n < 16; n++) {
+                    randomize_params(t, idx, my, mx);
+                    randomize_src(t);
+                    randomize_dst(t);
+                    call_ref((int16_t *) t->dst0, MAX_PB_SIZE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->height, t->mx, t->my, t->width);
+                    call_new((int16_t *) t->dst1, MAX_PB_SIZE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->height, t->mx, t->my, t->width);
+                    if (check_dst(t, 1))
+                        break;
+                }
+                bench_new((int16_t *) t->dst1, MAX_PB_SIZE, t->src + SRC_OFFSET, SRC_STRIDE,
+                          widths[idx], mx, my, widths[idx]);
+            }
+    report("put_%s_%d", types[t->epel], t->bit_depth);
+}
+
+static void check_uni(MCTest *t, void (*tab[10][2][2])(uint8_t *dst, ptrdiff_t dststride,
+                                                        uint8_t *src, ptrdiff_t srcstride,
+                                                        int height, intptr_t mx, intptr_t my,
+                                                        int width))
+{
+    int idx, my, mx, n;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int height, intptr_t mx, intptr_t my, int width);
+
+    for (idx = 0; idx < 10; idx++)
+        for (my = 0; my < 2; my++)
+            for (mx = 0; mx < 2; mx++) {
+                if (!check_func(tab[idx][my][mx], "put_hevc_uni_%s%d_%d", filters[t->epel][my][mx],
+                                widths[idx], t->bit_depth))
+                    continue;
+                for (n = 0; n < 16; n++) {
+                    randomize_params(t, idx, my, mx);
+                    randomize_src(t);
+                    randomize_dst(t);
+                    call_ref(t->dst0, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->height, t->mx, t->my, t->width);
+                    call_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->height, t->mx, t->my, t->width);
+                    if (check_dst(t, 0))
+                        break;
+                }
+                bench_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                          widths[idx], mx, my, widths[idx]);
+            }
+    report("put_uni_%s_%d", types[t->epel], t->bit_depth);
+}
+
+static void check_uni_w(MCTest *t, void (*tab[10][2][2])(uint8_t *dst, ptrdiff_t dststride,
+                                                          uint8_t *src, ptrdiff_t srcstride,
+                                                          int height, int denom, int wx, int ox,
+                                                          intptr_t mx, intptr_t my, int width))
+{
+    int idx, my, mx, n;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int height, int denom, int wx, int ox, intptr_t mx, intptr_t my, int width);
+
+    for (idx = 0; idx < 10; idx++)
+        for (my = 0; my < 2; my++)
+            for (mx = 0; mx < 2; mx++) {
+                if (!check_func(tab[idx][my][mx], "put_hevc_uni_w_%s%d_%d", filters[t->epel][my][mx],
+                                widths[idx], t->bit_depth))
+                    continue;
+                for (n = 0; n < 16; n++) {
+                    /* the ranges of pred_weight_table() */
+                    int denom = rnd() & 7;
+                    int wx    = (1 << denom) + (int8_t) rnd();
+                    int ox    = (int8_t) rnd();
+
+                    randomize_params(t, idx, my, mx);
+                    randomize_src(t);
+                    randomize_dst(t);
+                    call_ref(t->dst0, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->height, denom, wx, ox, t->mx, t->my, t->width);
+                    call_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->height, denom, wx, ox, t->mx, t->my, t->width);
+                    if (check_dst(t, 0))
+                        break;
+                }
+                bench_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                          widths[idx], 6, 70, 5, mx, my, widths[idx]);
+            }
+    report("put_uni_w_%s_%d", types[t->epel], t->bit_depth);
+}
+
+static void check_bi(MCTest *t, put_func put[10][2][2],
+                     void (*tab[10][2][2])(uint8_t *dst, ptrdiff_t dststride,
+                                           uint8_t *src, ptrdiff_t srcstride,
+                                           int16_t *src2, ptrdiff_t src2stride,
+                                           int height, intptr_t mx, intptr_t my, int width))
+{
+    int idx, my, mx, n;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int16_t *src2, ptrdiff_t src2stride, int height, intptr_t mx, intptr_t my,
+                 int width);
+
+    for (idx = 0; idx < 10; idx++)
+        for (my = 0; my < 2; my++)
+            for (mx = 0; mx < 2; mx++) {
+                if (!check_func(tab[idx][my][mx], "put_hevc_bi_%s%d_%d", filters[t->epel][my][mx],
+                                widths[idx], t->bit_depth))
+                    continue;
+                for (n = 0; n < 16; n++) {
+                    randomize_params(t, idx, my, mx);
+                    make_src2(t, put[idx][1][1]);
+                    randomize_src(t);
+                    randomize_dst(t);
+                    call_ref(t->dst0, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->src2, MAX_PB_SIZE, t->height, t->mx, t->my, t->width);
+                    call_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->src2, MAX_PB_SIZE, t->height, t->mx, t->my, t->width);
+                    if (check_dst(t, 0))
+                        break;
+                }
+                bench_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                          t->src2, MAX_PB_SIZE, widths[idx], mx, my, widths[idx]);
+            }
+    report("put_bi_%s_%d", types[t->epel], t->bit_depth);
+}
+
+/* the epel functions take their weights as wx0, ox0, wx1, ox1 */
+static void check_bi_w(MCTest *t, put_func put[10][2][2],
+                       void (*tab[10][2][2])(uint8_t *dst, ptrdiff_t dststride,
+                                             uint8_t *src, ptrdiff_t srcstride,
+                                             int16_t *src2, ptrdiff_t src2stride,
+                                             int height, int denom, int w0, int w1,
+                                             int w2, int w3, intptr_t mx, intptr_t my,
+                                             int width))
+{
+    int idx, my, mx, n;
+    declare_func(void, uint8_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride,
+                 int16_t *src2, ptrdiff_t src2stride, int height, int denom, int w0, int w1,
+                 int w2, int w3, intptr_t mx, intptr_t my, int width);
+
+    for (idx = 0; idx < 10; idx++)
+        for (my = 0; my < 2; my++)
+            for (mx = 0; mx < 2; mx++) {
+                if (!check_func(tab[idx][my][mx], "put_hevc_bi_w_%s%d_%d", filters[t->epel][my][mx],
+                                widths[idx], t->bit_depth))
+                    continue;
+                for (n = 0; n < 16; n++) {
+                    int denom = rnd() & 7;
+                    int wx0   = (1 << denom) + (int8_t) rnd();
+                    int wx1   = (1 << denom) + (int8_t) rnd();
+                    int ox0   = (int8_t) rnd();
+                    int ox1   = (int8_t) rnd();
+                    int w1    = t->epel ? ox0 : wx1;
+                    int w2    = t->epel ? wx1 : ox0;
+
+                    randomize_params(t, idx, my, mx);
+                    make_src2(t, put[idx][1][1]);
+                    randomize_src(t);
+                    randomize_dst(t);
+                    call_ref(t->dst0, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->src2, MAX_PB_SIZE, t->height, denom, wx0, w1, w2, ox1,
+                             t->mx, t->my, t->width);
+                    call_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                             t->src2, MAX_PB_SIZE, t->height, denom, wx0, w1, w2, ox1,
+                             t->mx, t->my, t->width);
+                    if (check_dst(t, 0))
+                        break;
+                }
+                bench_new(t->dst1, DST_STRIDE, t->src + SRC_OFFSET, SRC_STRIDE,
+                          t->src2, MAX_PB_SIZE, widths[idx], 6, 70, 60, 5, 5,
+                          mx, my, widths[idx]);
+            }
+    report("put_bi_w_%s_%d", types[t->epel], t->bit_depth);
+}
+
+void checkasm_check_hevc_mc(void)
+{
+    static MCTest t;
+    HEVCDSPContext h, c;
+    int flags = av_get_cpu_flags();
+    int bit_depth;
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        ff_hevc_dsp_init(&h, bit_depth);
+        t.bit_depth = bit_depth;
+
+        /* src2 comes from the C functions at every cpu level */
+        av_force_cpu_flags(0);
+        ff_hevc_dsp_init(&c, bit_depth);
+        av_force_cpu_flags(flags);
+
+        for (t.epel = 0; t.epel < 2; t.epel++) {
+            check_put(&t, t.epel ? h.put_hevc_epel : h.put_hevc_qpel);
+            check_uni(&t, t.epel ? h.put_hevc_epel_uni : h.put_hevc_qpel_uni);
+            check_uni_w(&t, t.epel ? h.put_hevc_epel_uni_w : h.put_hevc_qpel_uni_w);
+            check_bi(&t, t.epel ? c.put_hevc_epel : c.put_hevc_qpel,
+                     t.epel ? h.put_hevc_epel_bi : h.put_hevc_qpel_bi);
+            check_bi_w(&t, t.epel ? c.put_hevc_epel : c.put_hevc_qpel,
+                       t.epel ? h.put_hevc_epel_bi_w : h.put_hevc_qpel_bi_w);
+        }
+    }
+}
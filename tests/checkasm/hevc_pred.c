@@ -0,0 +1,193 @@
+/*
+ * HEVC intra prediction against the C version
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/hevcpred.h"
+#include "libavutil/mem.h"
+
+/* a block of each size sits at x = size, like in a picture row */
+#define DST_STRIDE (4 * MAX_TB_SIZE * 2)
+#define DST_SIZE   (MAX_TB_SIZE * DST_STRIDE)
+
+typedef struct PredTest {
+    /* the neighbour arrays of intra_pred(), index -1 is the corner */
+    uint16_t top_array[2 * MAX_TB_SIZE + 1];
+    uint16_t left_array[2 * MAX_TB_SIZE + 1];
+    DECLARE_ALIGNED(32, uint8_t, dst0)[DST_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, dst1)[DST_SIZE];
+    int bit_depth;
+    ptrdiff_t stride;       ///< in samples, as intra_pred() passes it
+    int log2_size;
+    int mode, c_idx;
+} PredTest;
+
+static void randomize(PredTest *t)
+{
+    int mask = (1 << t->bit_depth) - 1, i;
+    uint8_t *top  = (uint8_t *) t->top_array;
+    uint8_t *left = (uint8_t *) t->left_array;
+
+    for (i = 0; i < 2 * MAX_TB_SIZE + 1; i++) {
+        if (t->bit_depth > 8) {
+            t->top_array[i]  = rnd() & mask;
+            t->left_array[i] = rnd() & mask;
+        } else {
+            top[i]  = rnd();
+            left[i] = rnd();
+        }
+    }
+    /* intra_pred() gives both arrays the same corner */
+    if (t->bit_depth > 8)
+        t->top_array[0] = t->left_array[0];
+    else
+        top[0] = left[0];
+
+    for (i = 0; i < DST_SIZE; i++)
+        t->dst0[i] = rnd();
+    memcpy(t->dst1, t->dst0, DST_SIZE);
+}
+
+static const uint8_t *top(const PredTest *t)
+{
+    return (const uint8_t *) t->top_array + (t->bit_depth > 8 ? 2 : 1);
+}
+
+static const uint8_t *left(const PredTest *t)
+{
+    return (const uint8_t *) t->left_array + (t->bit_depth > 8 ? 2 : 1);
+}
+
+static uint8_t *block(const PredTest *t, uint8_t *dst)
+{
+    return dst + ((1 << t->log2_size) << (t->bit_depth > 8));
+}
+
+/* @return 1 after reporting the first difference in the whole buffer */
+static int check_dst(PredTest *t)
+{
+    int pel = t->bit_depth > 8;
+    int n   = DST_SIZE >> pel, i;
+
+    for (i = 0; i < n; i++) {
+        int a = pel ? ((uint16_t *) t->dst0)[i] : t->dst0[i];
+        int b = pel ? ((uint16_t *) t->dst1)[i] : t->dst1[i];
+        if (a != b) {
+            int x = i % (DST_STRIDE >> pel) - (1 << t->log2_size);
+            int y = i / (DST_STRIDE >> pel);
+            return checkasm_fail_func("%dx%d mode %d c_idx %d: %d instead of %d at %d,%d",
+                                      1 << t->log2_size, 1 << t->log2_size, t->mode,
+                                      t->c_idx, b, a, x, y);
+        }
+    }
+    return 0;
+}
+
+static void check_planar(PredTest *t, HEVCPredContext *h)
+{
+    int i, n;
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left,
+                 ptrdiff_t stride);
+
+    t->mode  = 0;
+    t->c_idx = 0;
+    for (i = 0; i < 4; i++) {
+        t->log2_size = i + 2;
+        if (!check_func(h->pred_planar[i], "pred_planar_%d_%d", i, t->bit_depth))
+            continue;
+        for (n = 0; n < 32; n++) {
+            randomize(t);
+            call_ref(block(t, t->dst0), top(t), left(t), t->stride);
+            call_new(block(t, t->dst1), top(t), left(t), t->stride);
+            if (check_dst(t))
+                break;
+        }
+        bench_new(block(t, t->dst1), top(t), left(t), t->stride);
+    }
+    report("pred_planar_%d", t->bit_depth);
+}
+
+/* one function for every size, checked and timed once per size */
+static void check_dc(PredTest *t, HEVCPredContext *h)
+{
+    int i, n;
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left,
+                 ptrdiff_t stride, int log2_size, int c_idx);
+
+    t->mode = 1;
+    for (i = 0; i < 4; i++) {
+        t->log2_size = i + 2;
+        if (!check_func(h->pred_dc, "pred_dc_%d_%d", i, t->bit_depth))
+            continue;
+        for (n = 0; n < 32; n++) {
+            /* the edge filter only applies to luma */
+            t->c_idx = n % 3;
+            randomize(t);
+            call_ref(block(t, t->dst0), top(t), left(t), t->stride, t->log2_size, t->c_idx);
+            call_new(block(t, t->dst1), top(t), left(t), t->stride, t->log2_size, t->c_idx);
+            if (check_dst(t))
+                break;
+        }
+        bench_new(block(t, t->dst1), top(t), left(t), t->stride, t->log2_size, 0);
+    }
+    report("pred_dc_%d", t->bit_depth);
+}
+
+static void check_angular(PredTest *t, HEVCPredContext *h)
+{
+    int i, n;
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left,
+                 ptrdiff_t stride, int c_idx, int mode);
+
+    for (i = 0; i < 4; i++) {
+        t->log2_size = i + 2;
+        if (!check_func(h->pred_angular[i], "pred_angular_%d_%d", i, t->bit_depth))
+            continue;
+        /* modes 10 and 26 filter the luma edge */
+        for (n = 0; n < 2 * 33; n++) {
+            t->mode  = 2 + n % 33;
+            t->c_idx = n / 33;
+            randomize(t);
+            call_ref(block(t, t->dst0), top(t), left(t), t->stride, t->c_idx, t->mode);
+            call_new(block(t, t->dst1), top(t), left(t), t->stride, t->c_idx, t->mode);
+            if (check_dst(t))
+                break;
+        }
+        /* a vertical mode that reads both neighbour arrays */
+        bench_new(block(t, t->dst1), top(t), left(t), t->stride, 0, 22);
+    }
+    report("pred_angular_%d", t->bit_depth);
+}
+
+void checkasm_check_hevc_pred(void)
+{
+    static PredTest t;
+    HEVCPredContext h;
+
+    for (t.bit_depth = 8; t.bit_depth <= 12; t.bit_depth += 2) {
+        ff_hevc_pred_init(&h, t.bit_depth);
+        t.stride = DST_STRIDE >> (t.bit_depth > 8);
+        check_planar(&t, &h);
+        check_dc(&t, &h);
+        check_angular(&t, &h);
+    }
+}
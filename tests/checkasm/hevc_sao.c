@@ -0,0 +1,232 @@
+/*
+ * HEVC sample adaptive offset against the C version
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string.h>
+
+#include "checkasm.h"
+#include "libavcodec/hevc.h"
+#include "libavcodec/hevcdsp.h"
+#include "libavutil/mem.h"
+
+#define MAX_CTB_SIZE 64
+
+/* the frame and the sao_frame of sao_filter_CTB(), with different strides
+ * and a row and a few samples around the CTB for the edge classes */
+#define FRAME_STRIDE ((MAX_CTB_SIZE + 32) * 2)
+#define COPY_STRIDE  ((MAX_CTB_SIZE + 64) * 2)
+#define FRAME_SIZE   ((MAX_CTB_SIZE + 2) * FRAME_STRIDE)
+#define COPY_SIZE    ((MAX_CTB_SIZE + 2) * COPY_STRIDE)
+#define CTB_X        16
+
+typedef struct SAOTest {
+    DECLARE_ALIGNED(32, uint8_t, frame0)[FRAME_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, frame1)[FRAME_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, copy0)[COPY_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, copy1)[COPY_SIZE];
+    SAOParams sao;
+    int borders[4];
+    uint8_t vert_edge[2], horiz_edge[2], diag_edge[4];
+    int bit_depth;
+    /* parameters of one call */
+    int width, height, c_idx;
+} SAOTest;
+
+/* every other call uses a narrow range, so that edge classification sees
+ * equal neighbours, the other one a full range to saturate the offsets */
+static void randomize(SAOTest *t, int n)
+{
+    int mask = (1 << t->bit_depth) - 1, i;
+    int base = rnd() & mask;
+    int range = n & 1 ? 3 : mask;
+
+    for (i = 0; i < FRAME_SIZE >> (t->bit_depth > 8); i++) {
+        int v = base + (rnd() & range);
+        v = FFMIN(v, mask);
+        if (t->bit_depth > 8)
+            ((uint16_t *) t->frame0)[i] = v;
+        else
+            t->frame0[i] = v;
+    }
+    for (i = 0; i < COPY_SIZE >> (t->bit_depth > 8); i++) {
+        int v = base + (rnd() & range);
+        v = FFMIN(v, mask);
+        if (t->bit_depth > 8)
+            ((uint16_t *) t->copy0)[i] = v;
+        else
+            t->copy0[i] = v;
+    }
+    memcpy(t->frame1, t->frame0, FRAME_SIZE);
+    memcpy(t->copy1, t->copy0, COPY_SIZE);
+}
+
+/* offsets as hls_sao_param() derives them, edge ones with the signs of the spec */
+static void randomize_sao(SAOTest *t, int band)
+{
+    int log2_scale = FFMAX(t->bit_depth - 10, 0);
+    int max        = (1 << (FFMIN(t->bit_depth, 10) - 5)) - 1;
+    int i;
+
+    t->sao.offset_val[t->c_idx][0] = 0;
+    for (i = 0; i < 4; i++) {
+        int v = rnd() % (max + 1);
+        if (band ? rnd() & 1 : i >= 2)
+            v = -v;
+        t->sao.offset_val[t->c_idx][i + 1] = v << log2_scale;
+    }
+    t->sao.band_position[t->c_idx] = rnd() & 31;
+}
+
+/* up to 64x64; CTBs are cut at the picture edge to a multiple of the
+ * minimum CB size, which is 4 samples in chroma */
+static void randomize_ctb(SAOTest *t)
+{
+    int i;
+
+    t->c_idx  = rnd() % 3;
+    t->width  = 4 * (1 + rnd() % (MAX_CTB_SIZE / 4));
+    t->height = 4 * (1 + rnd() % (MAX_CTB_SIZE / 4));
+    for (i = 0; i < 4; i++)
+        t->borders[i] = !(rnd() & 3);
+    /* sao_filter_CTB() only flags the edges of CTBs with a neighbour */
+    t->vert_edge[0]  = !t->borders[0] && rnd() & 1;
+    t->vert_edge[1]  = !t->borders[2] && rnd() & 1;
+    t->horiz_edge[0] = !t->borders[1] && rnd() & 1;
+    t->horiz_edge[1] = !t->borders[3] && rnd() & 1;
+    t->diag_edge[0]  = !t->borders[0] && !t->borders[1] && rnd() & 1;
+    t->diag_edge[1]  = !t->borders[1] && !t->borders[2] && rnd() & 1;
+    t->diag_edge[2]  = !t->borders[2] && !t->borders[3] && rnd() & 1;
+    t->diag_edge[3]  = !t->borders[0] && !t->borders[3] && rnd() & 1;
+}
+
+static uint8_t *frame(const SAOTest *t, uint8_t *buf)
+{
+    return buf + FRAME_STRIDE + (CTB_X << (t->bit_depth > 8));
+}
+
+static uint8_t *copy(const SAOTest *t, uint8_t *buf)
+{
+    return buf + COPY_STRIDE + (CTB_X << (t->bit_depth > 8));
+}
+
+/* the SSE functions store whole blocks of 8 samples, past the right edge
+ * of the CTB into the frame padding, so only the CTB itself is compared */
+static int check_buf(SAOTest *t, const char *name, uint8_t *buf0, uint8_t *buf1,
+                     ptrdiff_t stride)
+{
+    int pel = t->bit_depth > 8;
+    int x, y;
+
+    for (y = 0; y < t->height; y++)
+        for (x = 0; x < t->width; x++) {
+            int a = pel ? ((uint16_t *) (buf0 + y * stride))[x] : buf0[y * stride + x];
+            int b = pel ? ((uint16_t *) (buf1 + y * stride))[x] : buf1[y * stride + x];
+            if (a != b)
+                return checkasm_fail_func("%dx%d c_idx %d class %d borders %d%d%d%d: %s %d instead of %d at %d,%d",
+                                          t->width, t->height, t->c_idx, t->sao.eo_class[t->c_idx],
+                                          t->borders[0], t->borders[1], t->borders[2], t->borders[3],
+                                          name, b, a, x, y);
+        }
+    return 0;
+}
+
+/* @return 1 after reporting the first difference in either picture */
+static int check_dst(SAOTest *t)
+{
+    return check_buf(t, "frame", frame(t, t->frame0), frame(t, t->frame1), FRAME_STRIDE) ||
+           check_buf(t, "sao_frame", copy(t, t->copy0), copy(t, t->copy1), COPY_STRIDE);
+}
+
+/* filters the frame in place and saves the deblocked samples to sao_frame */
+static void check_band(SAOTest *t, HEVCDSPContext *h)
+{
+    int n;
+    declare_func(void, uint8_t *dst, uint8_t *src, ptrdiff_t stride_dst, ptrdiff_t stride_src,
+                 SAOParams *sao, int *borders, int width, int height, int c_idx);
+
+    if (check_func(h->sao_band_filter, "sao_band_filter_%d", t->bit_depth)) {
+        for (n = 0; n < 64; n++) {
+            randomize_ctb(t);
+            randomize_sao(t, 1);
+            randomize(t, n);
+            call_ref(frame(t, t->frame0), copy(t, t->copy0), FRAME_STRIDE, COPY_STRIDE,
+                     &t->sao, t->borders, t->width, t->height, t->c_idx);
+            call_new(frame(t, t->frame1), copy(t, t->copy1), FRAME_STRIDE, COPY_STRIDE,
+                     &t->sao, t->borders, t->width, t->height, t->c_idx);
+            if (check_dst(t))
+                break;
+        }
+        t->c_idx = 0;
+        t->sao.band_position[0] = 12;
+        bench_new(frame(t, t->frame1), copy(t, t->copy1), FRAME_STRIDE, COPY_STRIDE,
+                  &t->sao, t->borders, MAX_CTB_SIZE, MAX_CTB_SIZE, 0);
+    }
+    report("sao_band_filter_%d", t->bit_depth);
+}
+
+/* reads the staging copy in sao_frame, with its neighbours, and writes the frame */
+static void check_edge(SAOTest *t, HEVCDSPContext *h)
+{
+    static int no_borders[4];
+    int restore, n;
+    declare_func(void, uint8_t *dst, uint8_t *src, ptrdiff_t stride_dst, ptrdiff_t stride_src,
+                 SAOParams *sao, int *borders, int width, int height, int c_idx,
+                 uint8_t *vert_edge, uint8_t *horiz_edge, uint8_t *diag_edge);
+
+    for (restore = 0; restore < 2; restore++) {
+        if (!check_func(h->sao_edge_filter[restore], "sao_edge_filter_%d_%d",
+                        restore, t->bit_depth))
+            continue;
+        for (n = 0; n < 4 * 32; n++) {
+            randomize_ctb(t);
+            randomize_sao(t, 0);
+            t->sao.eo_class[t->c_idx] = n / 32;
+            randomize(t, n);
+            call_ref(frame(t, t->frame0), copy(t, t->copy0), FRAME_STRIDE, COPY_STRIDE,
+                     &t->sao, t->borders, t->width, t->height, t->c_idx,
+                     t->vert_edge, t->horiz_edge, t->diag_edge);
+            call_new(frame(t, t->frame1), copy(t, t->copy1), FRAME_STRIDE, COPY_STRIDE,
+                     &t->sao, t->borders, t->width, t->height, t->c_idx,
+                     t->vert_edge, t->horiz_edge, t->diag_edge);
+            if (check_dst(t))
+                break;
+        }
+        /* an inner luma CTB, 45 degree */
+        t->sao.eo_class[0] = SAO_EO_45D;
+        memset(t->vert_edge, 0, sizeof(t->vert_edge));
+        memset(t->horiz_edge, 0, sizeof(t->horiz_edge));
+        memset(t->diag_edge, 0, sizeof(t->diag_edge));
+        bench_new(frame(t, t->frame1), copy(t, t->copy1), FRAME_STRIDE, COPY_STRIDE,
+                  &t->sao, no_borders, MAX_CTB_SIZE, MAX_CTB_SIZE, 0,
+                  t->vert_edge, t->horiz_edge, t->diag_edge);
+    }
+    report("sao_edge_filter_%d", t->bit_depth);
+}
+
+void checkasm_check_hevc_sao(void)
+{
+    static SAOTest t;
+    HEVCDSPContext h;
+
+    for (t.bit_depth = 8; t.bit_depth <= 12; t.bit_depth += 2) {
+        ff_hevc_dsp_init(&h, t.bit_depth);
+        check_band(&t, &h);
+        check_edge(&t, &h);
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * HEVC start code scanner against the C version
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "checkasm.h"
+#include "libavcodec/hevc.h"
+#include "libavutil/cpu.h"
+#include "libavutil/mem.h"
+
+#define MAX_SIZE   400
+#define MAX_ALIGN  64
+/* a whole slice, timed in one call */
+#define BENCH_SIZE (64 * 1024)
+
+/* one in density bytes is 0, and about one in 64 of the others is 1 to 3 */
+static void randomize(uint8_t *buf, int size, int density)
+{
+    int i;
+
+    for (i = 0; i < size; i++) {
+        unsigned v = rnd();
+        buf[i] = !(v % density) ? 0 : (v >> 16) & 0xff;
+    }
+}
+
+/* slice data as the encoder writes it: zero bytes, but no marker */
+static void randomize_escaped(uint8_t *buf, int size)
+{
+    int i;
+
+    randomize(buf, size, 256);
+    for (i = 2; i < size; i++)
+        if (!buf[i - 2] && !buf[i - 1] && buf[i] <= 3)
+            buf[i] = 4 + rnd() % 252;
+}
+
+void checkasm_check_hevc_startcode(void)
+{
+    static const int densities[4] = { 2, 8, 64, 256 };
+    static DECLARE_ALIGNED(32, uint8_t, buf)[BENCH_SIZE + MAX_ALIGN];
+    int n;
+    declare_func(int, const uint8_t *buf, int size);
+
+    if (check_func(ff_hevc_find_nal_marker_func(av_get_cpu_flags()), "find_nal_marker")) {
+        for (n = 0; n < 4096; n++) {
+            int size  = rnd() % (MAX_SIZE + 1);
+            int align = rnd() % MAX_ALIGN;
+            int ref, new;
+
+            randomize(buf + align, size, densities[n & 3]);
+            ref = call_ref(buf + align, size);
+            new = call_new(buf + align, size);
+            if (ref != new) {
+                checkasm_fail_func("size %d at +%d, 1 zero in %d: %d instead of %d",
+                                   size, align, densities[n & 3], new, ref);
+                break;
+            }
+        }
+        randomize_escaped(buf, BENCH_SIZE);
+        bench_new(buf, BENCH_SIZE);
+    }
+    report("find_nal_marker");
+}
@@ -0,0 +1,53 @@
+# Times the decoding of STREAM with hevc_framemd5 (FRAMEMD5) under each
+# setting of MODES, a |-separated list of hevc_framemd5 arguments such as
+# "-H 0|-H 1|-H 2". The settings take turns for ROUNDS rounds (default 5),
+# so that a slow phase of the machine does not favour one of them; each
+# round decodes the stream RUNS times (default 3) and keeps the fastest.
+# Prints the time of every round, the best one and the peak memory.
+#
+# cmake -DFRAMEMD5=... -DSTREAM=... -DMODES=... [-DROUNDS=n] [-DRUNS=n] -P decode_bench.cmake
+
+if(NOT ROUNDS)
+    set(ROUNDS 5)
+endif()
+if(NOT RUNS)
+    set(RUNS 3)
+endif()
+
+string(REPLACE "|" ";" MODES "${MODES}")
+set(nb_modes 0)
+foreach(mode ${MODES})
+    set(times_${nb_modes} "")
+    set(best_${nb_modes} 0)
+    set(rss_${nb_modes} 0)
+    math(EXPR nb_modes "${nb_modes} + 1")
+endforeach()
+
+foreach(round RANGE 1 ${ROUNDS})
+    set(i 0)
+    foreach(mode ${MODES})
+        separate_arguments(args UNIX_COMMAND "${mode}")
+        execute_process(COMMAND ${FRAMEMD5} ${args} -r ${RUNS} ${STREAM}
+                        RESULT_VARIABLE ret ERROR_VARIABLE log OUTPUT_QUIET)
+        if(ret OR NOT log MATCHES "time= ([0-9]+)\\.([0-9]+) s")
+            message(FATAL_ERROR "decode of ${STREAM} with ${mode} failed:\n${log}")
+        endif()
+        # hevc_framemd5 prints 3 decimals: the time in ms without the dot
+        math(EXPR ms "${CMAKE_MATCH_1} * 1000 + 1${CMAKE_MATCH_2} - 1000")
+        set(times_${i} "${times_${i}} ${CMAKE_MATCH_1}.${CMAKE_MATCH_2}")
+        if(NOT best_${i} OR ms LESS best_${i})
+            set(best_${i} ${ms})
+        endif()
+        if(log MATCHES "maxrss= ([0-9]+) kB" AND CMAKE_MATCH_1 GREATER rss_${i})
+            set(rss_${i} ${CMAKE_MATCH_1})
+        endif()
+        math(EXPR i "${i} + 1")
+    endforeach()
+endforeach()
+
+message("${STREAM}, best of ${RUNS} runs per round, times in s")
+set(i 0)
+foreach(mode ${MODES})
+    message("  ${mode}:${times_${i}}  best ${best_${i}} ms  maxrss ${rss_${i}} kB")
+    math(EXPR i "${i} + 1")
+endforeach()
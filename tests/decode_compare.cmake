@@ -0,0 +1,33 @@
+# Decodes STREAM with hevc_framemd5 (FRAMEMD5) single threaded, then with
+# each thread setting of MODES, and fails unless all the runs write the same
+# picture MD5s. MODES is a |-separated list of hevc_framemd5 arguments, e.g.
+# "-p 4 -f 2|-p 2 -f 1". Every run also checks the picture hash SEI, if the
+# stream has one.
+#
+# cmake -DFRAMEMD5=... -DSTREAM=... -DMODES=... -P decode_compare.cmake
+
+get_filename_component(name ${STREAM} NAME_WE)
+set(ref ${name}.ref.md5)
+
+execute_process(COMMAND ${FRAMEMD5} -c -p 1 -o ${ref} ${STREAM}
+                RESULT_VARIABLE ret)
+if(ret)
+    message(FATAL_ERROR "single threaded decode of ${STREAM} failed")
+endif()
+file(READ ${ref} expected)
+
+string(REPLACE "|" ";" MODES "${MODES}")
+foreach(mode ${MODES})
+    separate_arguments(args UNIX_COMMAND "${mode}")
+    string(REGEX REPLACE "[ -]+" "_" suffix "${mode}")
+    set(out ${name}${suffix}.md5)
+    execute_process(COMMAND ${FRAMEMD5} -c ${args} -o ${out} ${STREAM}
+                    RESULT_VARIABLE ret)
+    if(ret)
+        message(FATAL_ERROR "decode of ${STREAM} with ${mode} failed")
+    endif()
+    file(READ ${out} actual)
+    if(NOT actual STREQUAL expected)
+        message(FATAL_ERROR "${STREAM}: ${mode} differs from the single threaded decode, see ${out}")
+    endif()
+endforeach()
@@ -0,0 +1,284 @@
+/*
+ * Per picture MD5 of a decoded stream
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Decodes a stream through the openHevc wrapper, writes the MD5 of every
+ * output picture and reports the decoding time. Two runs of the same
+ * stream must give the same MD5 lines whatever the threading mode, thread
+ * count, CPU flags or picture allocator; decode_compare.cmake relies on
+ * that. With -c, a mismatch against the picture hash SEI fails the run.
+ *
+ * The time only covers libOpenHevcDecode() and the output calls, not the
+ * demuxing or the MD5s. With -r the stream is decoded again and the
+ * fastest run is reported. The peak resident memory of the process is
+ * reported too, where the system provides it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#if HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif
+
+#include "openHevcWrapper.h"
+#include "libavformat/avformat.h"
+#include "libavutil/atomic.h"
+#include "libavutil/md5.h"
+#include "libavutil/time.h"
+
+static volatile int checksum_errors;
+
+static void log_callback(void *avcl, int level, const char *fmt, va_list vl)
+{
+    if (level <= AV_LOG_ERROR && strstr(fmt, "Incorrect MD5"))
+        avpriv_atomic_int_add_and_fetch(&checksum_errors, 1);
+    av_log_default_callback(avcl, level, fmt, vl);
+}
+
+/* in bytes, 0 if unknown */
+static int64_t getmaxrss(void)
+{
+#if HAVE_GETRUSAGE && HAVE_STRUCT_RUSAGE_RU_MAXRSS
+    struct rusage rusage;
+    getrusage(RUSAGE_SELF, &rusage);
+    return (int64_t)rusage.ru_maxrss * 1024;
+#else
+    return 0;
+#endif
+}
+
+static void md5_plane(struct AVMD5 *md5, const uint8_t *src, int pitch, int width, int height)
+{
+    int y;
+
+    for (y = 0; y < height; y++)
+        av_md5_update(md5, src + y * pitch, width);
+}
+
+static void write_md5(FILE *out, struct AVMD5 *md5, int n, const OpenHevc_FrameRef *frame)
+{
+    const OpenHevc_FrameInfo *info = &frame->frameInfo;
+    int pel    = info->nBitDepth > 8;
+    int hshift = info->chromat_format != YUV444;
+    int vshift = info->chromat_format == YUV420;
+    uint8_t sum[16];
+    int i;
+
+    av_md5_init(md5);
+    md5_plane(md5, frame->pvY, info->nYPitch, info->nWidth << pel, info->nHeight);
+    md5_plane(md5, frame->pvU, info->nUPitch, (info->nWidth >> hshift) << pel, info->nHeight >> vshift);
+    md5_plane(md5, frame->pvV, info->nVPitch, (info->nWidth >> hshift) << pel, info->nHeight >> vshift);
+    av_md5_final(md5, sum);
+
+    fprintf(out, "%5d %dx%d ", n, info->nWidth, info->nHeight);
+    for (i = 0; i < 16; i++)
+        fprintf(out, "%02x", sum[i]);
+    fprintf(out, "\n");
+}
+
+typedef struct Options {
+    const char *input;
+    const char *output;
+    const char *cpu_flags;
+    int threads;
+    int thread_type;
+    int huge_pages;
+    int bounded_dpb;
+    int shared_pools;
+    int check_sei;
+    int thread_stats;
+    int max_frames;
+} Options;
+
+/* @return the number of output pictures, or a negative value on error */
+static int decode(const Options *o, FILE *out, int64_t *time)
+{
+    AVFormatContext *fmt = NULL;
+    OpenHevc_Handle handle;
+    OpenHevc_FrameRef ref;
+    struct AVMD5 *md5;
+    AVPacket pkt;
+    int stream, nb_frames = 0, eof = 0;
+    int64_t t0;
+
+    handle = libOpenHevcInit(o->threads, o->thread_type);
+    md5    = av_md5_alloc();
+    if (!handle || !md5)
+        return -1;
+    libOpenHevcSetCheckMD5(handle, o->check_sei);
+    libOpenHevcSetThreadStats(handle, o->thread_stats);
+    if (o->cpu_flags && libOpenHevcSetCpuFlags(handle, o->cpu_flags) < 0) {
+        fprintf(stderr, "invalid cpu flags \"%s\"\n", o->cpu_flags);
+        return -1;
+    }
+    if (libOpenHevcSetHugePages(handle, o->huge_pages) < 0) {
+        fprintf(stderr, "huge pages mode %d not supported\n", o->huge_pages);
+        return -1;
+    }
+    if (o->bounded_dpb && libOpenHevcSetBoundedDPB(handle, 1) < 0)
+        return -1;
+    if (o->shared_pools && libOpenHevcSetSharedPools(handle) < 0)
+        return -1;
+
+    if (avformat_open_input(&fmt, o->input, NULL, NULL) < 0 ||
+        (stream = av_find_best_stream(fmt, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0)) < 0) {
+        fprintf(stderr, "could not read %s\n", o->input);
+        return -1;
+    }
+    if (fmt->streams[stream]->codec->extradata_size > 0)
+        libOpenHevcCopyExtraData(handle, fmt->streams[stream]->codec->extradata,
+                                 fmt->streams[stream]->codec->extradata_size +
+                                 FF_INPUT_BUFFER_PADDING_SIZE);
+    libOpenHevcStartDecoder(handle);
+    libOpenHevcSetTemporalLayer_id(handle, 7);
+    libOpenHevcSetActiveDecoders(handle, 0);
+    libOpenHevcSetViewLayers(handle, 0);
+
+    *time = 0;
+    while (!o->max_frames || nb_frames < o->max_frames) {
+        int got_picture;
+
+        av_init_packet(&pkt);
+        pkt.data = NULL;
+        pkt.size = 0;
+        if (!eof && av_read_frame(fmt, &pkt) < 0)
+            eof = 1;
+        if (!eof && pkt.stream_index != stream) {
+            av_free_packet(&pkt);
+            continue;
+        }
+
+        t0 = av_gettime();
+        got_picture = libOpenHevcDecode(handle, pkt.data, eof ? 0 : pkt.size, pkt.pts);
+        if (got_picture > 0)
+            got_picture = libOpenHevcGetOutputRef(handle, 1, &ref);
+        *time += av_gettime() - t0;
+        av_free_packet(&pkt);
+
+        if (got_picture > 0) {
+            if (out)
+                write_md5(out, md5, nb_frames, &ref);
+            libOpenHevcReleaseFrame(&ref);
+            nb_frames++;
+        } else if (eof) {
+            break;
+        }
+    }
+
+    /* each decoder context holds a reference until it is closed */
+    if (o->shared_pools)
+        fprintf(stderr, "motion table pool users= %d\n",
+                av_hevc_shared_pool_users(MKTAG('M','V','F',' ')));
+
+    t0 = av_gettime();
+    libOpenHevcClose(handle);
+    *time += av_gettime() - t0;
+    avformat_close_input(&fmt);
+    av_free(md5);
+    return nb_frames;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [options] input\n"
+            "  -o <file>  write the picture MD5s to file, - for stdout\n"
+            "  -p <n>     number of threads\n"
+            "  -f <type>  thread type (1: frame, 2: slice, 4: frameslice)\n"
+            "  -C <flags> cpu flags, e.g. -avx2\n"
+            "  -H <mode>  2MB pages for the pictures (1: transparent, 2: hugetlbfs)\n"
+            "  -D         bounded DPB\n"
+            "  -S         shared pools, print the users of the motion table one\n"
+            "  -c         check the picture hash SEI\n"
+            "  -b         print the thread statistics\n"
+            "  -s <n>     stop after n pictures\n"
+            "  -r <n>     decode n times, report the fastest run\n", name);
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    Options o = { NULL, NULL, NULL, 1, 1 };
+    FILE *out = NULL;
+    int64_t best = INT64_MAX, time;
+    int i, runs = 1, nb_frames = 0;
+
+    for (i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+
+        if (arg[0] != '-' || !arg[1] || arg[2]) {
+            if (o.input)
+                usage(argv[0]);
+            o.input = arg;
+            continue;
+        }
+        switch (arg[1]) {
+        case 'D': o.bounded_dpb  = 1; continue;
+        case 'S': o.shared_pools = 1; continue;
+        case 'c': o.check_sei    = 1; continue;
+        case 'b': o.thread_stats = 1; continue;
+        }
+        if (++i == argc)
+            usage(argv[0]);
+        switch (arg[1]) {
+        case 'o': o.output      = argv[i];       break;
+        case 'p': o.threads     = atoi(argv[i]); break;
+        case 'f': o.thread_type = atoi(argv[i]); break;
+        case 'C': o.cpu_flags   = argv[i];       break;
+        case 'H': o.huge_pages  = atoi(argv[i]); break;
+        case 's': o.max_frames  = atoi(argv[i]); break;
+        case 'r': runs          = atoi(argv[i]); break;
+        default:  usage(argv[0]);
+        }
+    }
+    if (!o.input || runs < 1)
+        usage(argv[0]);
+
+    av_register_all();
+    av_log_set_callback(log_callback);
+
+    for (i = 0; i < runs; i++) {
+        if (o.output && !i) {
+            out = strcmp(o.output, "-") ? fopen(o.output, "w") : stdout;
+            if (!out) {
+                fprintf(stderr, "could not open %s\n", o.output);
+                return 1;
+            }
+        }
+        nb_frames = decode(&o, i ? NULL : out, &time);
+        if (nb_frames < 0)
+            return 1;
+        best = FFMIN(best, time);
+    }
+    if (out && out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "frames= %d time= %.3f s fps= %.2f maxrss= %"PRId64" kB\n",
+            nb_frames, best / 1000000.0, best ? nb_frames * 1000000.0 / best : 0.0,
+            getmaxrss() / 1024);
+    if (checksum_errors) {
+        fprintf(stderr, "%d picture hash SEI mismatches\n", checksum_errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,262 @@
+/*
+ * Synthetic HEVC test streams
+ *
+ * This file is part of openHEVC.
+ *
+ * openHEVC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * openHEVC is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with openHEVC; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Encodes generated 8-bit 4:2:0 video with libx265, for benchmarking and
+ * comparing decoder configurations at any resolution without shipping
+ * sample files. The picture is a textured background panning under a few
+ * textured blocks moving in different directions, so both intra and inter
+ * prediction find work. The output only depends on the arguments.
+ *
+ * synth_stream -W 3840 -H 2160 -n 30 -o 4k.hevc slices=4 hash=1
+ *
+ * Every name=value argument is passed to x265_param_parse().
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <x265.h>
+
+#define TEX_BITS 9
+#define TEX_SIZE (1 << TEX_BITS)
+#define TEX_MASK (TEX_SIZE - 1)
+#define NB_BLOCKS 8
+
+typedef struct Block {
+    int x, y;           ///< position at picture 0, in luma samples
+    int dx, dy;         ///< motion per picture
+    int w, h;
+    int tex_x, tex_y;   ///< texture offset of the content
+} Block;
+
+static uint32_t lcg_state;
+
+static unsigned lcg(void)
+{
+    lcg_state = lcg_state * 1664525 + 1013904223;
+    return lcg_state >> 8;
+}
+
+/* value noise, box filtered twice so that it compresses like a picture */
+static void make_texture(uint8_t *tex, int amplitude)
+{
+    int *tmp = malloc(TEX_SIZE * TEX_SIZE * sizeof(*tmp));
+    int x, y, pass;
+
+    for (y = 0; y < TEX_SIZE; y++)
+        for (x = 0; x < TEX_SIZE; x++)
+            tmp[y * TEX_SIZE + x] = lcg() & 255;
+    for (pass = 0; pass < 2; pass++) {
+        for (y = 0; y < TEX_SIZE; y++)
+            for (x = 0; x < TEX_SIZE; x++)
+                tmp[y * TEX_SIZE + x] = (tmp[y * TEX_SIZE + x] * 2 +
+                                         tmp[y * TEX_SIZE + ((x + 1) & TEX_MASK)] +
+                                         tmp[((y + 1) & TEX_MASK) * TEX_SIZE + x]) >> 2;
+    }
+    for (y = 0; y < TEX_SIZE; y++)
+        for (x = 0; x < TEX_SIZE; x++) {
+            /* stripes give the edge and angular modes something to find */
+            int v = 128 + ((tmp[y * TEX_SIZE + x] - 128) * amplitude >> 4) +
+                    (((x + 2 * y) >> 4 & 1) ? 12 : -12);
+            tex[y * TEX_SIZE + x] = v < 16 ? 16 : v > 235 ? 235 : v;
+        }
+    free(tmp);
+}
+
+static void fill_plane(uint8_t *dst, int stride, int w, int h, int shift,
+                       const uint8_t *tex, const Block *blocks, int t)
+{
+    int x, y, i;
+
+    for (y = 0; y < h; y++)
+        for (x = 0; x < w; x++)
+            dst[y * stride + x] = tex[((y + (t >> shift)) & TEX_MASK) * TEX_SIZE +
+                                      ((x + (3 * t >> shift)) & TEX_MASK)];
+
+    for (i = 0; i < NB_BLOCKS; i++) {
+        const Block *b = &blocks[i];
+        int bw = b->w >> shift, bh = b->h >> shift;
+        int x0 = ((b->x + b->dx * t) >> shift) % (w + bw);
+        int y0 = ((b->y + b->dy * t) >> shift) % (h + bh);
+
+        if (x0 < 0)
+            x0 += w + bw;
+        if (y0 < 0)
+            y0 += h + bh;
+        x0 -= bw;
+        y0 -= bh;
+        for (y = y0 < 0 ? 0 : y0; y < y0 + bh && y < h; y++)
+            for (x = x0 < 0 ? 0 : x0; x < x0 + bw && x < w; x++)
+                dst[y * stride + x] = tex[((y - y0 + b->tex_y) & TEX_MASK) * TEX_SIZE +
+                                          ((x - x0 + b->tex_x) & TEX_MASK)] ^ 0x40;
+    }
+}
+
+static int write_nals(FILE *out, const x265_nal *nal, uint32_t nb_nal)
+{
+    uint32_t i;
+
+    for (i = 0; i < nb_nal; i++)
+        if (fwrite(nal[i].payload, 1, nal[i].sizeBytes, out) != nal[i].sizeBytes)
+            return -1;
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s -W width -H height -n pictures -o output "
+                    "[-P preset] [-S seed] [x265 option=value ...]\n", name);
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    const char *output = NULL, *preset = "ultrafast";
+    int width = 0, height = 0, nb_pictures = 0, seed = 1;
+    uint8_t *tex[3], *planes[3];
+    Block blocks[NB_BLOCKS];
+    x265_param *param;
+    x265_encoder *enc;
+    x265_picture *pic;
+    x265_nal *nal;
+    uint32_t nb_nal;
+    char res[32];
+    FILE *out;
+    int i, t, ret;
+
+    param = x265_param_alloc();
+    if (!param)
+        return 1;
+
+    for (i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+
+        if (arg[0] == '-' && arg[1] && !arg[2] && i + 1 < argc) {
+            const char *val = argv[++i];
+            switch (arg[1]) {
+            case 'W': width       = atoi(val); break;
+            case 'H': height      = atoi(val); break;
+            case 'n': nb_pictures = atoi(val); break;
+            case 'o': output      = val;       break;
+            case 'P': preset      = val;       break;
+            case 'S': seed        = atoi(val); break;
+            default:  usage(argv[0]);
+            }
+        } else if (!strchr(arg, '=')) {
+            usage(argv[0]);
+        }
+    }
+    if (width <= 0 || height <= 0 || (width | height) & 7 || nb_pictures <= 0 || !output)
+        usage(argv[0]);
+
+    if (x265_param_default_preset(param, preset, NULL) < 0) {
+        fprintf(stderr, "unknown preset %s\n", preset);
+        return 1;
+    }
+    snprintf(res, sizeof(res), "%dx%d", width, height);
+    x265_param_parse(param, "input-res", res);
+    x265_param_parse(param, "input-csp", "i420");
+    x265_param_parse(param, "fps", "25");
+    x265_param_parse(param, "info", "0");
+    /* name=value arguments override the settings above */
+    for (i = 1; i < argc; i++) {
+        char name[64], *eq;
+
+        if (argv[i][0] == '-') {
+            i++;
+            continue;
+        }
+        eq = strchr(argv[i], '=');
+        snprintf(name, sizeof(name), "%.*s", (int) (eq - argv[i]), argv[i]);
+        if (x265_param_parse(param, name, eq + 1)) {
+            fprintf(stderr, "invalid x265 option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    enc = x265_encoder_open(param);
+    pic = x265_picture_alloc();
+    out = fopen(output, "wb");
+    if (!enc || !pic || !out) {
+        fprintf(stderr, "could not set up the encoder or open %s\n", output);
+        return 1;
+    }
+
+    lcg_state = seed;
+    for (i = 0; i < 3; i++)
+        tex[i] = malloc(TEX_SIZE * TEX_SIZE);
+    make_texture(tex[0], 24);
+    make_texture(tex[1], 6);
+    make_texture(tex[2], 6);
+    for (i = 0; i < NB_BLOCKS; i++) {
+        blocks[i].w     = (width  >> 3) + (lcg() % (width  >> 3));
+        blocks[i].h     = (height >> 3) + (lcg() % (height >> 3));
+        blocks[i].x     = lcg() % width;
+        blocks[i].y     = lcg() % height;
+        blocks[i].dx    = (int) (lcg() % 17) - 8;
+        blocks[i].dy    = (int) (lcg() % 9)  - 4;
+        blocks[i].tex_x = lcg() & TEX_MASK;
+        blocks[i].tex_y = lcg() & TEX_MASK;
+    }
+
+    planes[0] = malloc(width * height);
+    planes[1] = malloc(width * height >> 2);
+    planes[2] = malloc(width * height >> 2);
+
+    x265_picture_init(param, pic);
+    for (i = 0; i < 3; i++) {
+        pic->planes[i] = planes[i];
+        pic->stride[i] = i ? width >> 1 : width;
+    }
+
+    ret = x265_encoder_headers(enc, &nal, &nb_nal);
+    if (ret > 0 && write_nals(out, nal, nb_nal) < 0)
+        ret = -1;
+    for (t = 0; t < nb_pictures && ret >= 0; t++) {
+        fill_plane(planes[0], width,      width,      height,      0, tex[0], blocks, t);
+        fill_plane(planes[1], width >> 1, width >> 1, height >> 1, 1, tex[1], blocks, t);
+        fill_plane(planes[2], width >> 1, width >> 1, height >> 1, 1, tex[2], blocks, t);
+        pic->pts = t;
+        ret = x265_encoder_encode(enc, &nal, &nb_nal, pic, NULL);
+        if (ret > 0 && write_nals(out, nal, nb_nal) < 0)
+            ret = -1;
+    }
+    while (ret >= 0 && (ret = x265_encoder_encode(enc, &nal, &nb_nal, NULL, NULL)) > 0)
+        if (write_nals(out, nal, nb_nal) < 0)
+            ret = -1;
+
+    x265_encoder_close(enc);
+    x265_picture_free(pic);
+    x265_param_free(param);
+    x265_cleanup();
+    fclose(out);
+    for (i = 0; i < 3; i++) {
+        free(tex[i]);
+        free(planes[i]);
+    }
+    if (ret < 0) {
+        fprintf(stderr, "encoding failed\n");
+        return 1;
+    }
+    return 0;
+}